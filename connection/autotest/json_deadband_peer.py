@@ -0,0 +1,30 @@
+# JSON peer for test_json_deadband.glm
+#
+# Answers every request from a gridlabd json client on the UDP port given and
+# logs the values of each request received as "method name=value ...".  Sync responses only carry var3 on odd ids so
+# the client sees values that are missing from the incoming data.  The peer
+# exits after it has been idle for 10 seconds.
+
+import re
+import socket
+import sys
+
+sock = socket.socket(socket.AF_INET,socket.SOCK_DGRAM)
+sock.bind(("127.0.0.1",int(sys.argv[1])))
+sock.settimeout(10)
+log = open(sys.argv[2],"w")
+try:
+	while True:
+		msg,addr = sock.recvfrom(65536)
+		body = msg.decode()[32:]
+		method = re.search(r'"method": "(\w+)"',body).group(1)
+		values = re.findall(r'"(var\d+)": "([^"]*)"',body)
+		log.write(" ".join([method]+["%s=%s" % v for v in values])+"\n")
+		log.flush()
+		id = int(re.search(r'"id": (\d+)',body).group(1))
+		data = '"var3": "5"' if id%2==1 else '"none": "0"' # json::parse rejects empty objects
+		reply = '{"result": "%s", "data": {%s}, "id": %d}' % (method,data,id)
+		head = "%-1d %-3d %-7d %-5.5s %-3.1f %-1d %-3d   " % (0,32,len(reply),"JSON",1.0,0,200)
+		sock.sendto((head+reply).encode(),addr)
+except socket.timeout:
+	pass
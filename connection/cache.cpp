@@ -8,6 +8,7 @@ cache::cache(void)
 {
 	size = 0x100;
 	tail = 0;
+	deadband = -1;
 	list = new CACHEID[size];
 	memset(list,0,sizeof(list[0])*size);
 	cacheitem::init();
@@ -28,6 +29,11 @@ int cache::option(char *command)
 			set_size(atoi(arg));
 			return 1;
 		}
+		else if ( strcmp(cmd,"deadband")==0 )
+		{
+			deadband = atof(arg);
+			return 1;
+		}
 	case 1:
 	default:
 		gl_error("cache::option(char *command='%s'): invalid command");
@@ -58,12 +64,18 @@ bool cache::write(VARMAP *var, TRANSLATOR *xltr)
 	CACHEID id = cacheitem::get_id(var);
 	cacheitem *item = cacheitem::get_item(id);
 	if ( item==NULL ) item = new cacheitem(var);
+	double db = get_deadband(var);
 	char buffer[1025];
 	{	gld_rlock lock(var->obj->get_object());
-		var->obj->to_string(buffer,sizeof(buffer));
+		if ( db>=0 && !item->is_changed(db) )
+			return true; // still within deadband of the value last sent
+		if ( var->obj->to_string(buffer,sizeof(buffer))<0 )
+			return false;
+		item->store();
 	}
-	return true;
-	//return item->write(buffer);
+	if ( db>=0 && item->is_marked()==false && strcmp(buffer,item->get_buffer())==0 )
+		return true; // text value unchanged since last sent
+	return item->write(buffer);
 }
 
 bool cache::read(VARMAP *var, TRANSLATOR *xltr)
@@ -80,7 +92,13 @@ bool cache::read(VARMAP *var, TRANSLATOR *xltr)
 		if ( strlen(buffer)>0 )
 		{
 			gld_wlock lock(var->obj->get_object());
-			return var->obj->from_string(buffer)>0; // convert incoming data
+			if ( item->is_applied(buffer) && !item->is_changed(0) )
+				return true; // object still holds the incoming data last applied
+			if ( var->obj->from_string(buffer)<=0 ) // convert incoming data
+				return false;
+			item->set_applied(buffer);
+			item->store();
+			return true;
 		}
 		else
 			return true; // no incoming data to process
@@ -115,6 +133,8 @@ cacheitem *cache::add_item(VARMAP *var)
 
 	// copy the initial value from the object
 	item->copy_from_object();
+	if ( var->dir==DXD_WRITE )
+		item->mark(); // initial value has not been sent yet
 
 	return item;
 }
@@ -179,6 +199,9 @@ Retry:
 
 	// setup new item
 	marked = false;
+	stored = false;
+	last[0] = last[1] = 0;
+	applied = NULL;
 	index[id] = this;
 	var = v;
 	value = new char[1025]; // TODO look into using prop->width instead to save some memory
@@ -259,10 +282,6 @@ bool cacheitem::write(char *buffer)
 	size_t len = strlen(value);
 	if ( len<1025 ) // TODO look into using prop->width instead to save memory
 	{
-		// check cache
-		if ( *value!='\0' && strcmp(buffer,value)!=0 )
-			gl_warning("cacheitem::write(): cache already contains different data for local '%s'/remote '%s'", var->local_name,var->remote_name);
-
 		// copy/xlate buffer to cache
 		if ( xltr==NULL )
 			strcpy(value,buffer);
@@ -285,3 +304,59 @@ bool cacheitem::copy_to_object(void)
 	gld_property prop(get_object(),get_property());
 	return prop.from_string(value)<0 ? false : true;
 }
+
+// get the numeric value of a property, returns false if it can only be compared as text
+static bool get_numeric(gld_property &prop, double x[2], bool &exact)
+{
+	void *addr = prop.get_addr();
+	exact = false;
+	x[1] = 0;
+	switch ( prop.get_type() ) {
+	case PT_double: x[0] = *(double*)addr; return true;
+	case PT_float: x[0] = *(float*)addr; return true;
+	case PT_complex: x[0] = ((complex*)addr)->Re(); x[1] = ((complex*)addr)->Im(); return true;
+	case PT_int16: x[0] = *(int16*)addr; return true;
+	case PT_int32: x[0] = *(int32*)addr; return true;
+	case PT_int64: x[0] = (double)*(int64*)addr; return true;
+	case PT_bool: x[0] = *(bool*)addr; exact = true; return true;
+	case PT_enumeration: x[0] = (double)*(enumeration*)addr; exact = true; return true;
+	case PT_set: x[0] = (double)*(set*)addr; exact = true; return true;
+	case PT_timestamp: x[0] = (double)*(TIMESTAMP*)addr; exact = true; return true;
+	default: return false;
+	}
+}
+
+bool cacheitem::is_changed(double deadband)
+{
+	if ( !stored )
+		return true;
+	gld_property prop(get_object(),get_property());
+	double x[2];
+	bool exact;
+	if ( !get_numeric(prop,x,exact) )
+		return true; // text values are compared when written
+	if ( exact )
+		return x[0]!=last[0];
+	double dx = x[0]-last[0], dy = x[1]-last[1];
+	return sqrt(dx*dx+dy*dy)>deadband;
+}
+
+void cacheitem::store(void)
+{
+	gld_property prop(get_object(),get_property());
+	bool exact;
+	stored = get_numeric(prop,last,exact);
+}
+
+bool cacheitem::is_applied(char *buffer)
+{
+	return applied!=NULL && strcmp(applied,buffer)==0;
+}
+
+void cacheitem::set_applied(char *buffer)
+{
+	if ( applied==NULL )
+		applied = new char[1025];
+	strncpy(applied,buffer,1024);
+	applied[1024] = '\0';
+}
@@ -33,6 +33,9 @@ private:
 	TRANSLATOR *xltr;
 	cacheitem *next;
 	bool marked; // true indicate value needs to be sync'd
+	bool stored; // true indicates last holds the value last sent or received
+	double last[2]; // last value sent or received for numeric properties
+	char *applied; // last incoming text applied to the object (read items only)
 public:
 	cacheitem(VARMAP *var); ///< creates a new cache entry (invalidates pre-existing CACHEIDs)
 	static void init();
@@ -59,6 +62,10 @@ public:
 	bool write(char *value); ///< write the item to the cache if space available
 	bool copy_from_object(void);
 	bool copy_to_object(void);
+	bool is_changed(double deadband); ///< check whether the object value moved more than deadband since it was last stored (caller must lock object)
+	void store(void); ///< keep the object value as the last value sent or received (caller must lock object)
+	bool is_applied(char *buffer); ///< check whether the incoming text is the text last applied to the object (use with is_changed to see whether the object still holds it)
+	void set_applied(char *buffer); ///< remember the incoming text applied to the object
 	inline void set_translator(TRANSLATOR *fn) ///< set the translator to use when copying cache to and from transport buffers
 		{ xltr=fn; };
 	inline void translate_tuple(char *from, size_t flen, char *tag, char *val);
@@ -71,6 +78,7 @@ private:
 	size_t size;
 	size_t tail;
 	CACHEID *list;
+	double deadband; ///< default deadband for outgoing values (negative to always send)
 public:
 	cache(void); // constructs a cache
 	~cache(void);
@@ -79,6 +87,8 @@ public:
 	void set_size(size_t); ///< sets the size of a connection cache
 	inline size_t get_count(void) ///< gets the size of the connection cache
 		{ return tail; }; 
+	inline double get_deadband(VARMAP *var) ///< gets the deadband of an outgoing variable (negative to always send)
+		{ return var->threshold[0]!='\0' ? atof(var->threshold) : deadband; };
 	CACHEID get_id(size_t n) { return list[n];};
 	cacheitem *get_item(size_t n) { return cacheitem::get_item(list[n]); };
 	cacheitem *add_item(VARMAP *var);
@@ -407,10 +407,28 @@ int connection_mode::exchange_data(EXCHANGETRANSLATOR *xlate, cache *list)
 	for ( n=0 ; n<list->get_count() ; n++)
 	{
 		cacheitem *item = list->get_item(n);
-		char * remote_name = item->get_remote();
-		char * item_buffer = item->get_buffer();
-		if ( !xlate(transport,item->get_remote(),item->get_buffer(),item->get_size(),ETO_QUOTES) )
-			return 0;
+		VARMAP *var = item->get_var();
+		if ( var->dir==DXD_WRITE )
+		{
+			// values with a deadband are only sent when they changed
+			if ( !item->is_marked() && list->get_deadband(var)>=0 )
+				continue;
+			if ( !xlate(transport,item->get_remote(),item->get_buffer(),item->get_size(),ETO_QUOTES) )
+				return 0;
+			item->unmark();
+		}
+		else
+		{
+			// remote may only send values that changed
+			int status = xlate(transport,item->get_remote(),item->get_buffer(),item->get_size(),ETO_QUOTES|ETO_OPTIONAL);
+			if ( status==ETR_MISSING )
+				continue;
+			if ( status<=0 )
+			{
+				error("unable to read incoming value of '%s'", item->get_remote());
+				return -1;
+			}
+		}
 	}
 	return 1;
 }
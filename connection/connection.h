@@ -26,6 +26,8 @@ typedef int (EXCHANGETRANSLATOR)(connection_transport*, const char *tag, char *v
 #define ET_GROUPCLOSE 2
 #define ETO_NONE 0
 #define ETO_QUOTES 3
+#define ETO_OPTIONAL 4 // tag may be absent from incoming data
+#define ETR_MISSING 2 // optional tag was absent from incoming data
 
 ///< Message flags for client_initiated and server_response
 typedef enum {
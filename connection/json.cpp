@@ -192,6 +192,8 @@ int json_import(connection_transport *transport,
 	char *value = json::get(translation,tag);
 	if ( value==NULL )
 	{
+		if ( options&ETO_OPTIONAL )
+			return ETR_MISSING;
 		gl_error("json_import(tag='%s',...) tag not found in incoming data",tag);
 		return 0;
 	}
@@ -224,7 +226,7 @@ int json::create(void)
 
 int json::init(OBJECT *parent)
 {
-	native::init(parent,&json_translate);
+	native::init(parent); // messages are translated by json_export/json_import
 
 	if ( get_connection()==NULL )
 	{
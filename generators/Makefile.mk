@@ -7,6 +7,7 @@ generators_generators_la_LDFLAGS =
 generators_generators_la_LDFLAGS += $(AM_LDFLAGS)
 
 generators_generators_la_LIBADD =
+generators_generators_la_LIBADD += -ldl
 
 generators_generators_la_SOURCES =
 generators_generators_la_SOURCES += generators/battery.cpp
@@ -7,6 +7,16 @@
 #include <math.h>
 #include "gridlabd.h"
 
+//Library imports - for the powerflow update threads
+#if defined(WIN32) && !defined(__MINGW32__)
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#define DLSYM(H,S) (void *)GetProcAddress((HINSTANCE)H,S)
+#else /* ANSI */
+#include "dlfcn.h"
+#define DLSYM(H,S) dlsym(H,S)
+#endif
+
 #define _GENERATORS_GLOBALS
 #include "generators.h"
 #undef  _GENERATORS_GLOBALS
@@ -263,6 +273,216 @@ EXPORT unsigned long preupdate(MODULE *module, TIMESTAMP t0, unsigned int64 dt)
 	}
 }
 
+//Deltamode object updates - split across the powerflow update threads (powerflow::NR_stamp_procs) when there are more than one
+//Objects run in batches of the same rank, lowest first like the bottom-up sync pass that put them in delta_objects,
+//so objects of different ranks (children and their parents, controller_dg and its generators) keep the serial order.
+//Objects of a batch add into their parent's current without locking, so the children of each parent run together, in
+//object order, on one thread.
+#define DELTA_MIN_GROUPS 4	//Fewest parents worth handing to another thread
+
+typedef void (*DELTARANGEFCN)(void *data, unsigned int start, unsigned int stop);
+typedef unsigned int (*DELTATHREADSFCN)(void);
+typedef void (*DELTARUNFCN)(unsigned int count, unsigned int min_count, DELTARANGEFCN fcn, void *data);
+
+typedef struct {
+	unsigned int64 delta_time;
+	unsigned long dt;
+	unsigned int iteration_count_val;
+	int first;	//First group of the batch being run
+} DELTA_PASS_DATA;
+
+static bool delta_run_linked = false;
+static DELTATHREADSFCN delta_update_threads = NULL;	//From the powerflow library - NULL if it is not loaded
+static DELTARUNFCN delta_update_run = NULL;
+
+static int delta_order_count = -1;			//Objects delta_order was built for - -1 until set up
+static int *delta_order = NULL;				//Object indices sorted by rank (ascending), then by parent, then by index
+static int *delta_group = NULL;				//Start of each group of the same parent in delta_order - n_delta_groups+1 entries
+static int *delta_batch = NULL;				//First group of each batch of the same rank - n_delta_batches+1 entries
+static int n_delta_groups = 0;
+static int n_delta_batches = 0;
+static SIMULATIONMODE *delta_status = NULL;	//Result of each object's last update
+static volatile int delta_failed = 0;		//Set by the first update that throws
+static char delta_error[1024];				//Message of the first update that threw
+
+static int delta_order_cmp(const void *a, const void *b)
+{
+	int ia = *(const int*)a, ib = *(const int*)b;
+	OBJECT *oa = delta_objects[ia], *ob = delta_objects[ib];
+
+	if (oa->rank != ob->rank)
+		return (oa->rank < ob->rank) ? -1 : 1;
+	if (oa->parent != ob->parent)
+		return (oa->parent < ob->parent) ? -1 : 1;
+	return ia - ib;
+}
+
+//Find the update threads of powerflow - the updates stay serial without them
+static void delta_link_threads(void)
+{
+	MODULE *pf_module = gl_find_module("powerflow");
+
+	delta_run_linked = true;
+
+	if ((pf_module == NULL) || (pf_module->hLib == NULL))
+		return;
+
+	delta_update_threads = (DELTATHREADSFCN)DLSYM(pf_module->hLib,"delta_update_threads");
+	delta_update_run = (DELTARUNFCN)DLSYM(pf_module->hLib,"delta_update_run");
+
+	if ((delta_update_threads == NULL) || (delta_update_run == NULL))
+	{
+		delta_update_threads = NULL;
+		delta_update_run = NULL;
+	}
+}
+
+//Sort the deltamode objects into rank batches of parent groups
+static void delta_schedule_setup(void)
+{
+	int n;
+
+	gl_free(delta_status);
+	gl_free(delta_order);
+	gl_free(delta_group);
+	gl_free(delta_batch);
+
+	delta_status = (SIMULATIONMODE*)gl_malloc((gen_object_count+1)*sizeof(SIMULATIONMODE));
+	delta_order = (int*)gl_malloc((gen_object_count+1)*sizeof(int));
+	delta_group = (int*)gl_malloc((gen_object_count+1)*sizeof(int));
+	delta_batch = (int*)gl_malloc((gen_object_count+1)*sizeof(int));
+
+	if ((delta_status == NULL) || (delta_order == NULL) || (delta_group == NULL) || (delta_batch == NULL))
+	{
+		GL_THROW("generators:interupdate - failed to allocate memory for the deltamode update batches");
+		/*  TROUBLESHOOT
+		While setting up the deltamode object updates, memory for the update order and results could not be allocated.
+		Please try again.  If the error persists, please submit your code and a bug report via the ticketing system.
+		*/
+	}
+
+	for (n=0; n<gen_object_count; n++)
+		delta_order[n] = n;
+
+	qsort(delta_order,gen_object_count,sizeof(int),delta_order_cmp);
+
+	n_delta_groups = 0;
+	n_delta_batches = 0;
+	for (n=0; n<gen_object_count; n++)
+	{
+		OBJECT *obj = delta_objects[delta_order[n]];
+		OBJECT *prev = (n == 0) ? NULL : delta_objects[delta_order[n-1]];
+
+		if ((prev == NULL) || (obj->rank != prev->rank))
+			delta_batch[n_delta_batches++] = n_delta_groups;
+		if ((prev == NULL) || (obj->rank != prev->rank) || (obj->parent == NULL) || (obj->parent != prev->parent))
+			delta_group[n_delta_groups++] = n;
+	}
+	delta_group[n_delta_groups] = gen_object_count;
+	delta_batch[n_delta_batches] = n_delta_groups;
+
+	delta_order_count = gen_object_count;
+}
+
+//Update one deltamode object - exceptions are turned into SM_ERROR, since this may run on one of the update threads
+static SIMULATIONMODE delta_update_object(int index, DELTA_PASS_DATA *pass)
+{
+	OBJECT *obj = delta_objects[index];
+
+	//See if we're in service or not
+	if ((obj->in_svc_double > gl_globaldeltaclock) || (obj->out_svc_double < gl_globaldeltaclock))
+	{
+		return SM_EVENT;	//Not in service - off to event mode
+	}
+
+	try {
+		//Call the actual function
+		return ((SIMULATIONMODE (*)(OBJECT *, unsigned int64, unsigned long, unsigned int))(*delta_functions[index]))(obj,pass->delta_time,pass->dt,pass->iteration_count_val);
+	}
+	catch (const char *msg)
+	{
+		if (__sync_bool_compare_and_swap(&delta_failed,0,1))
+			snprintf(delta_error,sizeof(delta_error),"%s",msg);
+	}
+	catch (...)
+	{
+		if (__sync_bool_compare_and_swap(&delta_failed,0,1))
+			snprintf(delta_error,sizeof(delta_error),"unknown exception");
+	}
+	return SM_ERROR;
+}
+
+static void delta_update_range(void *data, unsigned int start, unsigned int stop)
+{
+	DELTA_PASS_DATA *pass = (DELTA_PASS_DATA*)data;
+	unsigned int g;
+	int n;
+
+	for (g=pass->first+start; g<pass->first+stop; g++)
+	{
+		for (n=delta_group[g]; n<delta_group[g+1]; n++)
+		{
+			delta_status[delta_order[n]] = delta_update_object(delta_order[n],pass);
+		}
+	}
+}
+
+//Run the updates of all the objects into delta_status
+//Stops after the first batch with an error - the objects after it keep SM_EVENT, like the serial loop never reaching them
+//The first exception caught is rethrown here, on the calling thread, once its batch is done
+static void delta_update_all(unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val)
+{
+	DELTA_PASS_DATA pass;
+	int n, b;
+
+	if (delta_run_linked == false)
+		delta_link_threads();
+
+	if (delta_order_count != gen_object_count)
+		delta_schedule_setup();
+
+	for (n=0; n<gen_object_count; n++)
+		delta_status[n] = SM_EVENT;
+
+	pass.delta_time = delta_time;
+	pass.dt = dt;
+	pass.iteration_count_val = iteration_count_val;
+	delta_failed = 0;
+
+	if ((delta_update_run == NULL) || (delta_update_threads() < 2))
+	{
+		//Serial loop, in object order
+		for (n=0; n<gen_object_count; n++)
+		{
+			delta_status[n] = delta_update_object(n,&pass);
+			if (delta_status[n] == SM_ERROR)
+				break;
+		}
+	}
+	else
+	{
+		for (b=0; b<n_delta_batches; b++)
+		{
+			pass.first = delta_batch[b];
+			delta_update_run(delta_batch[b+1]-delta_batch[b],DELTA_MIN_GROUPS,delta_update_range,&pass);
+
+			//No sense running the parents of an object that failed
+			for (n=delta_group[delta_batch[b]]; n<delta_group[delta_batch[b+1]]; n++)
+			{
+				if (delta_status[delta_order[n]] == SM_ERROR)
+					break;
+			}
+			if (n < delta_group[delta_batch[b+1]])
+				break;
+		}
+	}
+
+	if (delta_failed != 0)
+	{
+		GL_THROW("%s",delta_error);
+	}
+}
+
 //interupdate function of deltamode
 //Module-level call for each timestep of deltamode
 //Ideally, all deltamode objects coordinate through their module call, not their individual "update" call
@@ -284,17 +504,12 @@ EXPORT SIMULATIONMODE interupdate(MODULE *module, TIMESTAMP t0, unsigned int64 d
 		}
 		//Default else -- already set
 
-		//Loop through the object list and call the updates
+		//Call the updates - the results are gone through in object order, like the serial loop did
+		delta_update_all(delta_time,dt,iteration_count_val);
+
 		for (curr_object_number=0; curr_object_number<gen_object_count; curr_object_number++)
 		{
-			//See if we're in service or not
-			if ((delta_objects[curr_object_number]->in_svc_double <= gl_globaldeltaclock) && (delta_objects[curr_object_number]->out_svc_double >= gl_globaldeltaclock))
-			{
-				//Call the actual function
-				function_status = ((SIMULATIONMODE (*)(OBJECT *, unsigned int64, unsigned long, unsigned int))(*delta_functions[curr_object_number]))(delta_objects[curr_object_number],delta_time,dt,iteration_count_val);
-			}
-			else //Not in service - off to event mode
-				function_status = SM_EVENT;
+			function_status = delta_status[curr_object_number];
 
 			//Determine what our return is
 			if (function_status == SM_DELTA)
@@ -23,6 +23,8 @@ GLD_SOURCES_PLACE_HOLDER += gldcore/enduse.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/enduse.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/environment.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/environment.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/eventqueue.c
+GLD_SOURCES_PLACE_HOLDER += gldcore/eventqueue.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/exception.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/exception.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/exec.c
@@ -25,15 +25,23 @@
 	@bug Right now, not all allowed aggregations are invariant (meaning that the members of the group
 	do not change over time).  However, the collector object requires invariant aggregations.  Using 
 	an aggregation that isn't invariant will cause the simulation to fail. (ticket #112)
+
+	The members of an aggregation are compiled the first time it is run so that the address
+	and unit conversion of each value is resolved only once.  Groups that are not constant
+	are searched again on every run but their members are only compiled again when the
+	result of the search changes.  Large constant groups are reduced by a multithreaded
+	iterator when more than one thread is used.
  @{
  **/
 
 #include <ctype.h>
 #include <math.h>
+#include <pthread.h>
 #include "platform.h"
 #include "aggregate.h"
 #include "output.h"
 #include "find.h"
+#include "threadpool.h"
 
 SET_MYCONTEXT(DMC_AGGREGATE)
 
@@ -315,6 +323,17 @@ AGGREGATION *aggregate_mkgroup(char *aggregator, /**< aggregator (min,max,avg,st
 			result->flags = flags;
 			result->punit = to_unit;
 			result->scale = scale;
+			result->member = NULL;
+			result->n_members = 0;
+			result->from_b = result->to_b = 0.0;
+			result->ratio = 1.0;
+			if (from_unit!=NULL && to_unit!=NULL && (pinfo->ptype==PT_double || pinfo->ptype==PT_loadshape || pinfo->ptype==PT_random))
+			{	/* same arithmetic as unit_convert_ex() */
+				result->flags |= AF_CONVERT;
+				result->from_b = from_unit->b;
+				result->to_b = to_unit->b;
+				result->ratio = from_unit->a/to_unit->a;
+			}
 		}
 		else
 		{
@@ -340,127 +359,337 @@ double arg(complex *x)
 	return (x->r==0) ? (x->i>0 ? PI/2 : (x->i==0 ? 0 : -PI/2)) : ((x->i>0) ? (x->r>0 ? atan(x->i/x->r) : PI-atan(x->i/x->r)) : (x->r>0 ? -atan(x->i/x->r) : PI+atan(x->i/x->r)));
 }
 
-/** This function performs an aggregate calculation given by the aggregation 
- **/
-double aggregate_value(AGGREGATION *aggr) /**< the aggregation to perform */
+/* partial result of an aggregation */
+typedef struct s_aggrstate {
+	unsigned int pass; /* multithreaded reduction the state belongs to */
+	AGGREGATION *aggr; /* aggregation being reduced */
+	unsigned int count; /* number of values accumulated */
+	double numerator, denominator, secondary;
+} AGGRSTATE;
+
+/* compile the members of the last run so sampling does not repeat the property lookups */
+static int aggregate_compile(AGGREGATION *aggr)
 {
 	OBJECT *obj;
-	double numerator=0, denominator=0, secondary=0, third=0, fourth=0;
-	double scale = (aggr->punit ? aggr->scale : 1.0);
-
-	/* non-constant groups need search program rerun */
-	if ((aggr->group->constflags & CF_CONSTANT) != CF_CONSTANT){
-		aggr->last = find_runpgm(NULL,aggr->group); /** @todo use constant part instead of NULL (ticket #3) */
+	unsigned int n = 0;
+	free(aggr->member);
+	aggr->member = (AGGRMEMBER*)malloc(sizeof(AGGRMEMBER)*(aggr->last->hit_count>0?aggr->last->hit_count:1));
+	aggr->n_members = 0;
+	if (aggr->member==NULL)
+	{
+		errno = ENOMEM;
+		return 0;
 	}
-
-	for(obj = find_first(aggr->last); obj != NULL; obj = find_next(aggr->last, obj)){
-		double value=0;
-		double *pdouble = NULL;
-		complex *pcomplex = NULL;
-
-		/* add time-sensitivity to verify that we are only aggregating objects that are in-service and not out-service. */
-		if(obj->in_svc >= global_clock || obj->out_svc <= global_clock)
-			continue;
-
+	for(obj = find_first(aggr->last); obj != NULL; obj = find_next(aggr->last, obj))
+	{
+		void *addr = NULL;
 		switch (aggr->pinfo->ptype) {
 		case PT_complex:
 		case PT_enduse:
-			pcomplex = object_get_complex(obj,aggr->pinfo);
-			if (pcomplex!=NULL)
-			{
-				switch (aggr->part) {
-				case AP_REAL: value=pcomplex->r; break;
-				case AP_IMAG: value=pcomplex->i; break;
-				case AP_MAG: value=mag(pcomplex); break;
-				case AP_ARG: value=arg(pcomplex); break;
-				case AP_ANG: value=arg(pcomplex)*180/PI;  break;
-				default: pcomplex = NULL; break; /* invalidate the result */
-				}
-			}
+			addr = object_get_complex(obj,aggr->pinfo);
 			break;
 		case PT_double:
 		case PT_loadshape:
 		case PT_random:
-			pdouble = object_get_double(obj,aggr->pinfo);
-			if (pdouble!=NULL){
-				value = *pdouble;
-				if(aggr->pinfo->unit != 0 && aggr->punit != 0){
-					int rv = unit_convert_ex(aggr->pinfo->unit, aggr->punit, &value);
-					if(rv == 0){ // error
-						;
-					}
-				} // else don't worry
-			}
+			addr = object_get_double(obj,aggr->pinfo);
 			break;
 		default:
 			break;
 		}
+		if (addr!=NULL) /* other members never yield a valid value */
+		{
+			aggr->member[n].obj = obj;
+			aggr->member[n].addr = addr;
+			n++;
+		}
+	}
+	aggr->n_members = n;
+	return 1;
+}
+
+/* read the value of a member
+	@return 0 if the member does not contribute to the aggregation
+ */
+static int aggregate_read(AGGREGATION *aggr, AGGRMEMBER *member, double *value)
+{
+	OBJECT *obj = member->obj;
+
+	/* add time-sensitivity to verify that we are only aggregating objects that are in-service and not out-service. */
+	if(obj->in_svc >= global_clock || obj->out_svc <= global_clock)
+		return 0;
+
+	if (aggr->pinfo->ptype==PT_complex || aggr->pinfo->ptype==PT_enduse)
+	{
+		complex *pcomplex = (complex*)member->addr;
+		switch (aggr->part) {
+		case AP_REAL: *value=pcomplex->r; break;
+		case AP_IMAG: *value=pcomplex->i; break;
+		case AP_MAG: *value=mag(pcomplex); break;
+		case AP_ARG: *value=arg(pcomplex); break;
+		case AP_ANG: *value=arg(pcomplex)*180/PI;  break;
+		default: return 0; /* invalidate the result */
+		}
+	}
+	else
+	{
+		*value = *(double*)member->addr;
+		if ((aggr->flags&AF_CONVERT)==AF_CONVERT)
+			*value = (*value - aggr->from_b) * aggr->ratio + aggr->to_b;
+	}
+	if ((aggr->flags&AF_ABS)==AF_ABS) *value=fabs(*value);
+	return 1;
+}
+
+/* accumulate a value in a partial result */
+static void aggregate_add(AGGRSTATE *state, AGGREGATOR op, double value)
+{
+	state->count++;
+	switch (op) {
+	case AGGR_MIN:
+		if (value<state->numerator || state->denominator==0) state->numerator=value;
+		state->denominator = 1;
+		break;
+	case AGGR_MAX:
+		if (value>state->numerator || state->denominator==0) state->numerator=value;
+		state->denominator = 1;
+		break;
+	case AGGR_COUNT:
+		state->numerator++;
+		state->denominator=1;
+		break;
+	case AGGR_MBE:
+		state->denominator++;
+		state->numerator += value;
+		state->secondary += (value-state->secondary)/state->denominator;
+		break;
+	case AGGR_AVG:
+	case AGGR_MEAN:
+		state->numerator+=value;
+		state->denominator++;
+		break;
+	case AGGR_SUM:
+		state->numerator+=value;
+		state->denominator = 1;
+		break;
+	case AGGR_PROD:
+		state->numerator*=value;
+		state->denominator = 1;
+		break;
+	case AGGR_GAMMA:
+		state->denominator+=log(value);
+		if (state->numerator==0 || state->secondary>value)
+			state->secondary = value;
+		state->numerator++;
+		break;
+	case AGGR_STD:
+	case AGGR_VAR:
+		state->denominator++;
+		// note this uses a compensated on-line algorithm (see Knuth 1998)
+		// it's better than the obvious method because it doesn't suffer from numerical instability when mean(x)-x is near zero
+		{	double delta = value-state->secondary;
+			state->secondary += delta/state->denominator;
+			state->numerator += delta*(value-state->secondary);
+		}
+		break;
+	case AGGR_SKEW:
+	case AGGR_KUR:
+	default:
+		break;
+	}
+}
+
+/* merge the partial result b into a */
+static void aggregate_merge(AGGRSTATE *a, AGGRSTATE *b, AGGREGATOR op)
+{
+	if (b->count==0)
+		return;
+	if (a->count==0)
+	{
+		a->count = b->count;
+		a->numerator = b->numerator;
+		a->denominator = b->denominator;
+		a->secondary = b->secondary;
+		return;
+	}
+	switch (op) {
+	case AGGR_MIN:
+		if (b->numerator<a->numerator) a->numerator = b->numerator;
+		break;
+	case AGGR_MAX:
+		if (b->numerator>a->numerator) a->numerator = b->numerator;
+		break;
+	case AGGR_COUNT:
+	case AGGR_SUM:
+		a->numerator += b->numerator;
+		break;
+	case AGGR_PROD:
+		a->numerator *= b->numerator;
+		break;
+	case AGGR_AVG:
+	case AGGR_MEAN:
+		a->numerator += b->numerator;
+		a->denominator += b->denominator;
+		break;
+	case AGGR_MBE:
+		a->numerator += b->numerator;
+		a->secondary = (a->secondary*a->denominator + b->secondary*b->denominator)/(a->denominator+b->denominator);
+		a->denominator += b->denominator;
+		break;
+	case AGGR_GAMMA:
+		a->denominator += b->denominator;
+		if (b->secondary<a->secondary) a->secondary = b->secondary;
+		a->numerator += b->numerator;
+		break;
+	case AGGR_STD:
+	case AGGR_VAR:
+		// pairwise update of the compensated algorithm (see Chan et al. 1979)
+		{	double n = a->denominator+b->denominator;
+			double delta = b->secondary-a->secondary;
+			a->secondary += delta*b->denominator/n;
+			a->numerator += b->numerator + delta*delta*a->denominator*b->denominator/n;
+			a->denominator = n;
+		}
+		break;
+	default:
+		break;
+	}
+	a->count += b->count;
+}
+
+/* multithreaded reduction of large groups, shared by all aggregations */
+#define AGGR_MTI_MINMEMBERS 4096 /* members per thread below which reduction stays serial */
+static MTI *mti_pool = NULL; /* the pool, NULL when single threaded */
+static int mti_tried = 0; /* pool creation has been attempted */
+static unsigned int *mti_chunk = NULL; /* chunk numbers iterated by the pool */
+static unsigned int mti_chunks = 0; /* number of chunks (one per thread) */
+static unsigned int mti_pass = 0; /* number of multithreaded reductions done */
+static pthread_mutex_t mti_lock = PTHREAD_MUTEX_INITIALIZER; /* serializes use of the pool, which is not reentrant */
+static MTIITEM aggregate_get(MTIITEM item)
+{
+	unsigned int *chunk = (unsigned int*)item;
+	if (chunk==NULL)
+		return mti_chunks>0 ? (MTIITEM)mti_chunk : NULL;
+	else if (++chunk<mti_chunk+mti_chunks)
+		return (MTIITEM)chunk;
+	else
+		return NULL;
+}
+static void aggregate_call(MTIDATA output, MTIITEM item, MTIDATA input)
+{
+	AGGRSTATE *result = (AGGRSTATE*)output;
+	AGGREGATION *aggr = ((AGGRSTATE*)input)->aggr;
+	unsigned int chunk = *(unsigned int*)item;
+	unsigned int n = (unsigned int)((unsigned long long)chunk*aggr->n_members/mti_chunks);
+	unsigned int last = (unsigned int)((unsigned long long)(chunk+1)*aggr->n_members/mti_chunks);
+	result->aggr = aggr;
+	for ( ; n<last; n++)
+	{
+		double value;
+		if (aggregate_read(aggr,aggr->member+n,&value))
+			aggregate_add(result,aggr->op,value);
+	}
+}
+static MTIDATA aggregate_set(MTIDATA to, MTIDATA from)
+{
+	if (to==NULL) to = (MTIDATA)malloc(sizeof(AGGRSTATE));
+	if (to==NULL) return NULL;
+	if (from==NULL)
+		memset(to,0,sizeof(AGGRSTATE));
+	else
+		memcpy(to,from,sizeof(AGGRSTATE));
+	return to;
+}
+static int aggregate_compare(MTIDATA a, MTIDATA b)
+{
+	return ((AGGRSTATE*)a)->pass==((AGGRSTATE*)b)->pass ? 0 : -1;
+}
+static void aggregate_gather(MTIDATA a, MTIDATA b)
+{
+	AGGRSTATE *to = (AGGRSTATE*)a, *from = (AGGRSTATE*)b;
+	if (from->aggr==NULL)
+		return;
+	to->aggr = from->aggr;
+	aggregate_merge(to,from,from->aggr->op);
+}
+static int aggregate_reject(MTI *mti, MTIDATA value)
+{
+	return 0;
+}
+static MTIFUNCTIONS aggregate_fns = {aggregate_get,aggregate_call,aggregate_set,aggregate_compare,aggregate_gather,aggregate_reject};
 
-		if (pdouble!=NULL || pcomplex!=NULL) /* valid value */
+/* reduce the members on the shared pool; returns 0 if the caller must reduce them itself */
+static int aggregate_run(AGGREGATION *aggr, AGGRSTATE *state)
+{
+	AGGRSTATE input;
+	int ok;
+	if (aggr->n_members<2*AGGR_MTI_MINMEMBERS)
+		return 0;
+	pthread_mutex_lock(&mti_lock);
+	if (!mti_tried)
+	{
+		mti_tried = 1;
+		mti_chunk = (unsigned int*)malloc(sizeof(unsigned int)*global_threadcount);
+		if (mti_chunk!=NULL)
 		{
-			if ((aggr->flags&AF_ABS)==AF_ABS) value=fabs(value);
-			switch (aggr->op) {
-			case AGGR_MIN:
-				if (value<numerator || denominator==0) numerator=value;
-				denominator = 1;
-				break;
-			case AGGR_MAX:
-				if (value>numerator || denominator==0) numerator=value;
-				denominator = 1;
-				break;
-			case AGGR_COUNT:
-				numerator++;
-				denominator=1;
-				break;
-			case AGGR_MBE:
-				denominator++;
-				numerator += value;
-				secondary += (value-secondary)/denominator;
-				break;
-			case AGGR_AVG:
-			case AGGR_MEAN:
-				numerator+=value;
-				denominator++;
-				break;
-			case AGGR_SUM:
-				numerator+=value;
-				denominator = 1;
-				break;
-			case AGGR_PROD:
-				numerator*=value;
-				denominator = 1;
-				break;
-			case AGGR_GAMMA:
-				denominator+=log(value);
-				if (numerator==0 || secondary>value)
-					secondary = value;
-				numerator++;
-				break;
-			case AGGR_STD:
-			case AGGR_VAR:
-				denominator++;
-				// note this uses a compensated on-line algorithm (see Knuth 1998)
-				// it's better than the obvious method because it doesn't suffer from numerical instability when mean(x)-x is near zero
-				{	double delta = value-secondary;
-					secondary += delta/denominator;
-					numerator += delta*(value-secondary);
-				}
-				break;
-			case AGGR_SKEW:
-			case AGGR_KUR:
-			default:
-				break;
-			}
+			for (mti_chunks=0; mti_chunks<(unsigned int)global_threadcount; mti_chunks++)
+				mti_chunk[mti_chunks] = mti_chunks;
+			mti_pool = mti_init("aggregate",&aggregate_fns,1);
+		}
+	}
+	memset(&input,0,sizeof(input));
+	input.aggr = aggr;
+	input.pass = ++mti_pass;
+	ok = mti_pool!=NULL && mti_run(state,mti_pool,&input);
+	pthread_mutex_unlock(&mti_lock);
+	return ok;
+}
+
+/** This function performs an aggregate calculation given by the aggregation 
+ **/
+double aggregate_value(AGGREGATION *aggr) /**< the aggregation to perform */
+{
+	AGGRSTATE state;
+	unsigned int n;
+
+	/* non-constant groups need search program rerun */
+	if ((aggr->group->constflags & CF_CONSTANT) != CF_CONSTANT){
+		FINDLIST *list = find_runpgm(NULL,aggr->group); /** @todo use constant part instead of NULL (ticket #3) */
+		if (list==NULL)
+			return QNAN;
+		/* the members are only compiled again when the group has changed */
+		if (aggr->member!=NULL && aggr->last!=NULL && aggr->last->result_size==list->result_size
+			&& memcmp(aggr->last->result,list->result,list->result_size)==0)
+			free(list);
+		else
+		{
+			free(aggr->last);
+			aggr->last = list;
+			if (!aggregate_compile(aggr))
+				return QNAN;
 		}
 	}
+	else if (aggr->member==NULL && !aggregate_compile(aggr))
+		return QNAN;
+
+	/* large groups are reduced in parallel */
+	if (!aggregate_run(aggr,&state))
+	{
+		memset(&state,0,sizeof(state));
+		for (n=0; n<aggr->n_members; n++)
+		{
+			double value;
+			if (aggregate_read(aggr,aggr->member+n,&value))
+				aggregate_add(&state,aggr->op,value);
+		}
+	}
+
 	switch (aggr->op) {
-		double v = 0.0, t = 0.0, m = 0.0;
 	case AGGR_GAMMA:
-		return 1 + numerator/(denominator-numerator*log(secondary));
+		return 1 + state.numerator/(state.denominator-state.numerator*log(state.secondary));
 	case AGGR_STD:
-		return sqrt(numerator/(denominator-1));// * scale;
+		return sqrt(state.numerator/(state.denominator-1));// * scale;
 	case AGGR_MBE:
-		return numerator/denominator - secondary;
+		return state.numerator/state.denominator - state.secondary;
 	case AGGR_SKEW:
 		/** @todo implement skewness aggregate (no ticket) */
 		throw_exception("skewness aggregation is not implemented");
@@ -476,7 +705,7 @@ double aggregate_value(AGGREGATION *aggr) /**< the aggregation to perform */
 			Remove or replace the reference to the
 		 */
 	default:
-		return numerator/denominator;// * scale;
+		return state.numerator/state.denominator;// * scale;
 	}
 }
 
@@ -15,6 +15,12 @@ typedef enum {AGGR_NOP, AGGR_MIN, AGGR_MAX, AGGR_AVG, AGGR_STD, AGGR_MBE, AGGR_M
 typedef enum {AP_NONE, AP_REAL, AP_IMAG, AP_MAG, AP_ANG, AP_ARG} AGGRPART; /**< the part of complex values to aggregate */
 
 #define AF_ABS 0x01 /**< absolute value aggregation flag */
+#define AF_CONVERT 0x02 /**< unit conversion flag */
+
+typedef struct s_aggrmember {
+	struct s_object_list *obj; /**< the member object */
+	void *addr; /**< the address of the aggregated value */
+} AGGRMEMBER; /**< a member of a compiled aggregation */
 
 typedef struct s_aggregate {
 	AGGREGATOR op; /**< the aggregation operator (min, max, etc.) */
@@ -26,6 +32,9 @@ typedef struct s_aggregate {
 	unsigned char flags; /**< aggregation flags (e.g., AF_ABS) */
 	struct s_findlist *last; /**< the result of the last run */
 	struct s_aggregate *next; /**< the next aggregation in the core's list of aggregators */
+	AGGRMEMBER *member; /**< the members compiled from the last run */
+	unsigned int n_members; /**< the number of compiled members */
+	double from_b, to_b, ratio; /**< the unit conversion resolved for doubles */
 } AGGREGATION; /**< the aggregation type */
 
 #ifdef __cplusplus
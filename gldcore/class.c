@@ -17,6 +17,7 @@
 #include "enduse.h"
 #include "stream.h"
 #include "random.h"
+#include "lock.h"
 
 SET_MYCONTEXT(DMC_CLASS)
 
@@ -182,33 +183,147 @@ static PROPERTY *find_header_property(CLASS *oclass,
 	return prop;
 }
 
+/* hashed index of the properties of a class, including the inherited properties */
+typedef struct s_property_index {
+	unsigned int generation;	/* generation of the class and its parents when the index was built */
+	CLASS *parent;				/* parent of the class when the index was built */
+	unsigned int mask;			/* number of slots less one (the number of slots is a power of 2) */
+	PROPERTY **slot;			/* open addressing table of properties */
+	struct s_property_index *retired; /* replaced indexes, kept for lookups that may still be using them */
+} PROPERTYINDEX;
+static unsigned int property_index_lock = 0;
+
+static unsigned int property_hash(const char *name)
+{
+	unsigned int hash = 2166136261u;
+	while ( *name!='\0' )
+	{
+		hash ^= (unsigned char)*name++;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/* total of the property generations of a class and its parents, which only changes when one of them gets a property */
+static unsigned int property_chain_generation(CLASS *oclass)
+{
+	unsigned int generation = 0, depth = 0;
+	for ( ; oclass!=NULL && depth++<=class_count ; oclass=oclass->parent )
+		generation += oclass->pgeneration;
+	return generation;
+}
+
+/* build the index of a class, or return NULL if the inheritance chain loops */
+static PROPERTYINDEX *build_property_index(CLASS *oclass)
+{
+	PROPERTYINDEX *index;
+	PROPERTY *prop;
+	CLASS *pclass;
+	unsigned int count = 0, size = 8, depth = 0;
+	for ( pclass=oclass ; pclass!=NULL ; pclass=pclass->parent )
+	{
+		if ( depth++>class_count )
+			return NULL;
+		for ( prop=pclass->pmap ; prop!=NULL && prop->oclass==pclass ; prop=prop->next )
+			count++;
+	}
+	while ( size<2*count )
+		size *= 2;
+	index = (PROPERTYINDEX*)malloc(sizeof(PROPERTYINDEX)+size*sizeof(PROPERTY*));
+	if ( index==NULL )
+		return NULL;
+	index->generation = property_chain_generation(oclass);
+	index->parent = oclass->parent;
+	index->mask = size-1;
+	index->slot = (PROPERTY**)(index+1);
+	index->retired = NULL;
+	memset(index->slot,0,size*sizeof(PROPERTY*));
+
+	/* the first property found by a linear search wins, so the class hides its parents */
+	for ( pclass=oclass ; pclass!=NULL ; pclass=pclass->parent )
+	{
+		for ( prop=pclass->pmap ; prop!=NULL && prop->oclass==pclass ; prop=prop->next )
+		{
+			unsigned int n = property_hash(prop->name)&index->mask;
+			while ( index->slot[n]!=NULL && strcmp(index->slot[n]->name,prop->name)!=0 )
+				n = (n+1)&index->mask;
+			if ( index->slot[n]==NULL )
+				index->slot[n] = prop;
+		}
+	}
+	return index;
+}
+
+/* get the current index of a class, rebuilding it if properties were added to it or its parents since it was built */
+static PROPERTYINDEX *get_property_index(CLASS *oclass)
+{
+	PROPERTYINDEX *index = oclass->pindex;
+	unsigned int generation = property_chain_generation(oclass);
+	if ( index!=NULL && index->generation==generation && index->parent==oclass->parent )
+		return index;
+	wlock(&property_index_lock);
+	index = oclass->pindex;
+	if ( index==NULL || index->generation!=generation || index->parent!=oclass->parent )
+	{
+		index = build_property_index(oclass);
+		if ( index!=NULL )
+		{
+			index->retired = oclass->pindex;
+			oclass->pindex = index;
+		}
+	}
+	wunlock(&property_index_lock);
+	return index;
+}
+
+static void deprecated_property_notice(CLASS *oclass, PROPERTYNAME name, PROPERTY *prop)
+{
+	if (prop->flags&PF_DEPRECATED && !(prop->flags&PF_DEPRECATED_NONOTICE) && !global_suppress_deprecated_messages)
+	{
+		output_warning("class_find_property(CLASS *oclass='%s', PROPERTYNAME name='%s': property is deprecated", oclass->name, name);
+		/* TROUBLESHOOT
+			You have done a search on a property that has been flagged as deprecated and will most likely not be supported soon.
+			Correct the usage of this property to get rid of this message.
+		 */
+		if (global_suppress_repeat_messages)
+			prop->flags |= ~PF_DEPRECATED_NONOTICE;
+	}
+}
+
 /** Find the named property in the class
 
+	Properties are found using a hashed index of the class and its parents, which is
+	built on the first search and rebuilt after properties are added to the class or its parents.
+
 	@return a pointer to the PROPERTY, or \p NULL if the property is not found.
  **/
 PROPERTY *class_find_property(CLASS *oclass,     /**< the object class */
                               PROPERTYNAME name) /**< the property name */
 {
+	PROPERTYINDEX *index;
 	PROPERTY *prop = find_header_property(oclass,name);
 	if ( prop ) return prop;
 
 	if(oclass == NULL)
 		return NULL;
 
+	index = get_property_index(oclass);
+	if ( index!=NULL )
+	{
+		unsigned int n = property_hash(name)&index->mask;
+		while ( (prop=index->slot[n])!=NULL && strcmp(name,prop->name)!=0 )
+			n = (n+1)&index->mask;
+		if ( prop!=NULL && prop->oclass==oclass )
+			deprecated_property_notice(oclass,name,prop);
+		return prop;
+	}
+
+	/* the index cannot be built when the inheritance loops */
 	for (prop=oclass->pmap; prop!=NULL && prop->oclass==oclass; prop=prop->next)
 	{
 		if (strcmp(name,prop->name)==0)
 		{
-			if (prop->flags&PF_DEPRECATED && !(prop->flags&PF_DEPRECATED_NONOTICE) && !global_suppress_deprecated_messages)
-			{
-				output_warning("class_find_property(CLASS *oclass='%s', PROPERTYNAME name='%s': property is deprecated", oclass->name, name);
-				/* TROUBLESHOOT
-					You have done a search on a property that has been flagged as deprecated and will most likely not be supported soon.
-					Correct the usage of this property to get rid of this message.
-				 */
-				if (global_suppress_repeat_messages)
-					prop->flags |= ~PF_DEPRECATED_NONOTICE;
-			}
+			deprecated_property_notice(oclass,name,prop);
 			return prop;
 		}
 	}
@@ -239,6 +354,7 @@ void class_add_property(CLASS *oclass,  /**< the class to which the property is
 		oclass->pmap = prop;
 	else
 		last->next = prop;
+	oclass->pgeneration++; /* indexes of the class and its subclasses are rebuilt on the next search */
 }
 
 /** Add an extended property to a class 
@@ -1209,6 +1325,26 @@ void class_profiles(void)
 
 }
 
+/** Free the property indexes of all classes, including those retired by rebuilds
+ **/
+void class_free_property_indexes(void)
+{
+	CLASS *cl;
+	wlock(&property_index_lock);
+	for (cl=first_class; cl!=NULL; cl=cl->next)
+	{
+		PROPERTYINDEX *index = cl->pindex;
+		cl->pindex = NULL;
+		while ( index!=NULL )
+		{
+			PROPERTYINDEX *retired = index->retired;
+			free(index);
+			index = retired;
+		}
+	}
+	wunlock(&property_index_lock);
+}
+
 /** Register a type delegation for a property
 	@return a pointer DELEGATEDTYPE struct if successful, \p NULL if delegation failed
 
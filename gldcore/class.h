@@ -119,6 +119,8 @@ struct s_class_list {
 	TECHNOLOGYREADINESSLEVEL trl; // technology readiness level (1-9, 0=unknown)
 	bool has_runtime;	///< flag indicating that a runtime dll, so, or dylib is in use
 	char runtime[1024]; ///< name of file containing runtime dll, so, or dylib
+	struct s_property_index *pindex; ///< hashed index of the class and inherited properties (built by class_find_property)
+	unsigned int pgeneration; ///< number of properties added to the class, so indexes built before an addition can be told apart
 	struct s_class_list *next;
 }; /* CLASS */
 
@@ -146,6 +148,7 @@ int class_saveall(FILE *fp);
 int class_saveall_xml(FILE *fp);
 unsigned int class_get_count(void);
 void class_profiles(void);
+void class_free_property_indexes(void);
 int class_get_xsd(CLASS *oclass, char *buffer, size_t len);
 size_t class_get_runtimecount(void);
 CLASS *class_get_first_runtime(void);
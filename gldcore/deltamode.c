@@ -24,6 +24,8 @@ static OBJECT **delta_objectlist = NULL; /* qualified object list */
 static int delta_objectcount = 0; /* qualified object count */
 static MODULE **delta_modulelist = NULL; /* qualified module list */
 static int delta_modulecount = 0; /* qualified module count */
+static DT delta_minstep = 0; /* smallest step requested by the modules */
+static DT delta_maxstep = 0; /* largest step allowed by the modules that do not report their errors */
 
 /* profile data structure */
 static DELTAPROFILE profile;
@@ -248,7 +250,7 @@ DT delta_update(void)
 {
 	char temp_name_buff[64];
 	clock_t t = clock();
-	DT seconds_advance, timestep;
+	DT seconds_advance, timestep, next_timestep;
 	DELTAT temp_time;
 	unsigned int delta_iteration_remaining, delta_iteration_count, delta_forced_iteration;
 	SIMULATIONMODE interupdate_mode, interupdate_mode_result, clockupdate_result;
@@ -279,7 +281,7 @@ DT delta_update(void)
 	delta_forced_iteration = global_deltamode_forced_extra_timesteps;
 
 	/* process updates until mode is switched or 1 hour elapses */
-	for ( global_deltaclock=0; global_deltaclock<global_deltamode_maximumtime; global_deltaclock+=timestep )
+	for ( global_deltaclock=0; global_deltaclock<global_deltamode_maximumtime; global_deltaclock+=timestep, timestep=next_timestep )
 	{
 		/* Check to make sure we haven't reached a stop time */
 		global_delta_curr_clock = dbl_curr_clk_time + (double)global_deltaclock/(double)DT_SECOND;
@@ -406,6 +408,16 @@ DT delta_update(void)
 			return DT_INVALID;
 		}
 
+		/* profile */
+		if ( profile.t_min==0 || timestep<profile.t_min ) profile.t_min = timestep;
+		if ( profile.t_max==0 || timestep>profile.t_max ) profile.t_max = timestep;
+
+		/* choose the next step while the modules still hold this step's states */
+		if ( global_deltamode_adaptive && interupdate_mode!=SM_EVENT )
+			next_timestep = delta_nextstep(timestep);
+		else
+			next_timestep = timestep;
+
 		// We have finished the current timestep. Call delta_clockUpdate.
 		clockupdate_result = delta_clockupdate(timestep, interupdate_mode);
 
@@ -445,9 +457,6 @@ DT delta_update(void)
 		/* Others - Must be an error? */
 	}/* End of delta timestep run */
 
-	/* profile */
-	if ( profile.t_min==0 || timestep<profile.t_min ) profile.t_min = timestep;
-	if ( profile.t_max==0 || timestep>profile.t_max ) profile.t_max = timestep;
 	profile.t_delta += global_deltaclock;
 
 	/* send postupdate messages */
@@ -478,6 +487,7 @@ static DT delta_preupdate(void)
 	clock_t t = clock();
 	DT timestep = global_deltamode_timestep;
 	MODULE **module;
+	delta_maxstep = global_deltamode_timestep_max;
 	for ( module=delta_modulelist; module<delta_modulelist+delta_modulecount; module++ )
 	{
 		DT dt = (*module)->preupdate(*module,global_clock,global_deltaclock);
@@ -491,11 +501,58 @@ static DT delta_preupdate(void)
 		} else if ( dt < timestep ){
 			timestep = dt;
 		}
+
+		/* modules that cannot report their errors are never stepped faster than they asked */
+		if ( (*module)->deltaerror==NULL && dt < delta_maxstep )
+			delta_maxstep = dt;
 	}
+	delta_minstep = timestep;
+	if ( delta_maxstep < delta_minstep )
+		delta_maxstep = delta_minstep;
 	profile.t_preupdate += clock() - t;
 	return timestep;
 }
 
+/** Choose the next adaptive timestep from the state changes reported by the modules
+
+	Each module that exports deltamode_error() reports the largest change of its state
+	over the step just taken, in per unit.  The step is halved when any change exceeds
+	\p deltamode_error_tolerance and doubled when all are below a quarter of it, so quiet
+	stretches are run at coarse steps and transients at the step the modules asked for.
+	Steps stay between the smallest module step and \p deltamode_timestep_max, and are
+	only doubled on a multiple of the doubled step so the fine step grid is kept.  A
+	module returning a negative error, or not exporting deltamode_error(), holds the step
+	at or below the step it returned from preupdate.
+
+	@return the next timestep
+ **/
+static DT delta_nextstep(DT timestep)
+{
+	double error = 0.0;
+	DT maxstep = delta_maxstep;
+	MODULE **module;
+	for ( module=delta_modulelist; module<delta_modulelist+delta_modulecount; module++ )
+	{
+		if ( (*module)->deltaerror!=NULL )
+		{
+			double e = (*module)->deltaerror(*module,timestep);
+			if ( e < 0 )
+				maxstep = delta_minstep;
+			else if ( e > error )
+				error = e;
+		}
+	}
+	if ( error > global_deltamode_error_tolerance )
+		timestep /= 2;
+	else if ( error < global_deltamode_error_tolerance/4 && (global_deltaclock+timestep)%(2*timestep)==0 )
+		timestep *= 2;
+	if ( timestep > maxstep )
+		timestep = maxstep;
+	if ( timestep < delta_minstep )
+		timestep = delta_minstep;
+	return timestep;
+}
+
 static SIMULATIONMODE delta_interupdate(DT timestep,unsigned int iteration_count_val)
 {
 	clock_t t = clock();
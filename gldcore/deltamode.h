@@ -12,6 +12,7 @@ static DT delta_preupdate(void); /* send preupdate messages ; dt==0|DT_INVALID f
 static SIMULATIONMODE delta_interupdate(DT timestep, unsigned int iteration_count_val); /* send interupdate messages  - 0=INIT (used?), 1=EVENT, 2=DELTA, 3=DELTA_ITER, 255=ERROR */
 static SIMULATIONMODE delta_clockupdate(DT timestep, SIMULATIONMODE interupdate_result); /* notification that we are finished with the current deltamode timestep and are moving to the next timestep. */
 static STATUS delta_postupdate(void); /* send postupdate messages - 0 = FAILED, 1=SUCCESS */
+static DT delta_nextstep(DT timestep); /* ask modules for their state changes and choose the next adaptive timestep */
 
 typedef struct {
 	clock_t t_init; /**< time in initiation */
@@ -0,0 +1,127 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file eventqueue.c
+	@addtogroup eventqueue Event queues
+	@ingroup core
+
+	Event queues keep items ordered by the time of their next event so that
+	the items that are due can be found without scanning all of them.  The
+	queue is a binary heap, so pushing and popping an item is O(log n) and
+	the time of the earliest event is read from the head of the heap.
+ @{
+ **/
+#include <stdlib.h>
+#include <errno.h>
+#include "eventqueue.h"
+
+/** Create an empty event queue
+	@return a pointer to the new queue,
+	\p NULL on error, errno
+	- \p ENOMEM memory allocation failed
+ **/
+EVENTQUEUE *eventqueue_create(void)
+{
+	EVENTQUEUE *queue = (EVENTQUEUE*)malloc(sizeof(EVENTQUEUE));
+	if ( queue==NULL )
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+	queue->size = 0;
+	queue->max = 0;
+	queue->item = NULL;
+	return queue;
+}
+
+/** Destroy an event queue (the items themselves are not freed)
+ **/
+void eventqueue_destroy(EVENTQUEUE *queue)
+{
+	free(queue->item);
+	free(queue);
+}
+
+/** Remove all the items from an event queue
+ **/
+void eventqueue_clear(EVENTQUEUE *queue)
+{
+	queue->size = 0;
+}
+
+/** Add an item to an event queue
+	@return 1 on success, 0 on error, errno
+	- \p ENOMEM memory allocation failed
+ **/
+int eventqueue_push(EVENTQUEUE *queue,	/**< the queue */
+					TIMESTAMP t,		/**< the time of the next event of the item */
+					void *data)			/**< the item */
+{
+	unsigned int n;
+	if ( queue->size==queue->max )
+	{
+		unsigned int max = queue->max>0 ? queue->max*2 : 64;
+		EVENTITEM *item = (EVENTITEM*)realloc(queue->item,sizeof(EVENTITEM)*max);
+		if ( item==NULL )
+		{
+			errno = ENOMEM;
+			return 0;
+		}
+		queue->item = item;
+		queue->max = max;
+	}
+
+	/* sift the new item up from the bottom of the heap */
+	for ( n=queue->size++ ; n>0 ; )
+	{
+		unsigned int parent = (n-1)/2;
+		if ( queue->item[parent].t<=t )
+			break;
+		queue->item[n] = queue->item[parent];
+		n = parent;
+	}
+	queue->item[n].t = t;
+	queue->item[n].data = data;
+	return 1;
+}
+
+/** Remove the earliest item from an event queue if its event is due
+	@return the item, or \p NULL if no event is due by time \p t
+ **/
+void *eventqueue_pop(EVENTQUEUE *queue,	/**< the queue */
+					 TIMESTAMP t)		/**< the time by which the event must be due */
+{
+	void *data;
+	EVENTITEM last;
+	unsigned int n;
+	if ( queue->size==0 || queue->item[0].t>t )
+		return NULL;
+	data = queue->item[0].data;
+
+	/* sift the last item down from the top of the heap */
+	last = queue->item[--queue->size];
+	for ( n=0 ; ; )
+	{
+		unsigned int child = 2*n+1;
+		if ( child>=queue->size )
+			break;
+		if ( child+1<queue->size && queue->item[child+1].t<queue->item[child].t )
+			child++;
+		if ( last.t<=queue->item[child].t )
+			break;
+		queue->item[n] = queue->item[child];
+		n = child;
+	}
+	if ( queue->size>0 )
+		queue->item[n] = last;
+	return data;
+}
+
+/** Get the time of the earliest event in an event queue
+	@return the time of the event, or \p TS_NEVER if the queue is empty
+ **/
+TIMESTAMP eventqueue_next(EVENTQUEUE *queue)
+{
+	return queue->size>0 ? queue->item[0].t : TS_NEVER;
+}
+
+/**@}*/
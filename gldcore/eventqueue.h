@@ -0,0 +1,42 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file eventqueue.h
+	@addtogroup eventqueue
+	@ingroup core
+@{
+ **/
+
+#ifndef _EVENTQUEUE_H
+#define _EVENTQUEUE_H
+
+#include "timestamp.h"
+
+typedef struct s_eventitem {
+	TIMESTAMP t;	/**< time of the next event of the item */
+	void *data;		/**< the item */
+} EVENTITEM;
+
+typedef struct s_eventqueue {
+	unsigned int size;	/**< number of items queued */
+	unsigned int max;	/**< number of items allocated */
+	EVENTITEM *item;	/**< binary heap of the items, earliest event first */
+} EVENTQUEUE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EVENTQUEUE *eventqueue_create(void);
+void eventqueue_destroy(EVENTQUEUE *queue);
+void eventqueue_clear(EVENTQUEUE *queue);
+int eventqueue_push(EVENTQUEUE *queue, TIMESTAMP t, void *data);
+void *eventqueue_pop(EVENTQUEUE *queue, TIMESTAMP t);
+TIMESTAMP eventqueue_next(EVENTQUEUE *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/**@}*/
@@ -191,6 +191,23 @@ int64 exec_clock(void)
 	return (t1.time-t0.time)*CLOCKS_PER_SEC + (t1.millitm-t0.millitm)*CLOCKS_PER_SEC/1000;
 }
 
+/** High resolution elapsed wallclock in seconds, for timing calls that are much shorter than a clock tick **/
+double exec_clock_hires(void)
+{
+#ifdef WIN32
+	static LARGE_INTEGER freq = {0};
+	LARGE_INTEGER t;
+	if ( freq.QuadPart==0 )
+		QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&t);
+	return (double)t.QuadPart/(double)freq.QuadPart;
+#else
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC,&t);
+	return (double)t.tv_sec + (double)t.tv_nsec*1e-9;
+#endif
+}
+
 /** The main system initialization sequence
 	@return 1 on success, 0 on failure
  **/
@@ -913,59 +930,258 @@ typedef struct s_simplelinklist {
 } SIMPLELINKLIST;
 
 /**************************************************************************
- ** PRECOMMIT ITERATOR
+ ** PRECOMMIT AND COMMIT ITERATORS
  **************************************************************************/
+
+/* The precommit and commit passes are run over flat arrays of the objects that implement
+   them.  The objects are sorted by descending rank so parents are called before their
+   children, then by class so consecutive calls go to the same callback, then by id.  The
+   objects of a rank form a batch whose objects do not depend on one another, so each batch
+   is split among the threads of one pool shared by all the passes while the batches are
+   run in order.
+ */
+#define PASS_MTI_MINOBJECTS 8 /* objects per thread below which a batch stays single threaded */
+typedef struct s_passbatch {
+	OBJECT **obj; /* first object of the batch in the pass list */
+	unsigned int n_obj; /* number of objects in the batch */
+	int threaded; /* non-zero when the batch is run on the shared pool */
+} PASSBATCH;
+typedef struct s_passlist {
+	OBJECT **obj; /* objects in call order */
+	unsigned int n_obj; /* number of objects */
+	PASSBATCH *batch; /* batches in call order */
+	unsigned int n_batches; /* number of batches */
+} PASSLIST;
+typedef struct s_passdata {
+	unsigned int run; /* number of the run, so runs at the same time still start the iterator */
+	TIMESTAMP t0, t2; /* times given to the calls */
+	TIMESTAMP result; /* earliest time returned by the calls */
+	OBJECT *failed; /* first object whose call failed */
+	PASSBATCH *batch; /* batch being run */
+	void (*call)(struct s_passdata*,OBJECT*,struct s_passdata*); /* call of the pass (output,object,input) */
+} PASSDATA;
+
+static int passlist_cmp(const void *a, const void *b)
+{
+	OBJECT *oa = *(OBJECT**)a, *ob = *(OBJECT**)b;
+	if ( oa->rank!=ob->rank ) return oa->rank>ob->rank ? -1 : 1;
+	if ( oa->oclass->id!=ob->oclass->id ) return oa->oclass->id<ob->oclass->id ? -1 : 1;
+	if ( oa->id!=ob->id ) return oa->id<ob->id ? -1 : 1;
+	return 0;
+}
+
+/* pool shared by the passes - its items are chunk numbers and the batch comes with the input */
+static MTI *pass_pool = NULL; /* the pool, NULL when single threaded */
+static int pass_tried = 0; /* pool creation has been attempted */
+static unsigned int *pass_chunk = NULL; /* chunk numbers iterated by the pool */
+static unsigned int pass_chunks = 0; /* number of chunks (one per thread) */
+static unsigned int pass_run = 0; /* number of runs of the pool */
+static MTIITEM pass_get(MTIITEM item)
+{
+	unsigned int *chunk = (unsigned int*)item;
+	if ( chunk==NULL )
+		return pass_chunks>0 ? (MTIITEM)pass_chunk : NULL;
+	else if ( ++chunk<pass_chunk+pass_chunks )
+		return (MTIITEM)chunk;
+	else
+		return NULL;
+}
+static void pass_gather(MTIDATA a, MTIDATA b);
+static void pass_call(MTIDATA output, MTIITEM item, MTIDATA input)
+{
+	PASSDATA *in = (PASSDATA*)input;
+	PASSBATCH *batch = in->batch;
+	unsigned int chunk = *(unsigned int*)item;
+	unsigned int n = (unsigned int)((unsigned long long)chunk*batch->n_obj/pass_chunks);
+	unsigned int last = (unsigned int)((unsigned long long)(chunk+1)*batch->n_obj/pass_chunks);
+	for ( ; n<last ; n++ )
+	{
+		PASSDATA result;
+		result.result = TS_NEVER;
+		result.failed = NULL;
+		in->call(&result,batch->obj[n],in);
+		pass_gather(output,&result);
+	}
+}
+static MTIDATA pass_set(MTIDATA to, MTIDATA from)
+{
+	/* allocation request */
+	if ( to==NULL ) to = (MTIDATA)malloc(sizeof(PASSDATA));
+
+	/* clear request (may follow allocation request) */
+	if ( from==NULL )
+	{
+		PASSDATA *data = (PASSDATA*)to;
+		data->run = 0;
+		data->t0 = data->t2 = TS_ZERO;
+		data->result = TS_NEVER;
+		data->failed = NULL;
+		data->batch = NULL;
+		data->call = NULL;
+	}
+
+	/* copy request */
+	else memcpy(to,from,sizeof(PASSDATA));
+
+	return to;
+}
+static int pass_compare(MTIDATA a, MTIDATA b)
+{
+	return ((PASSDATA*)a)->run==((PASSDATA*)b)->run ? 0 : -1;
+}
+static void pass_gather(MTIDATA a, MTIDATA b)
+{
+	PASSDATA *to = (PASSDATA*)a, *from = (PASSDATA*)b;
+	if ( a==NULL || b==NULL ) return;
+	if ( from->result<to->result ) to->result = from->result;
+	if ( to->failed==NULL ) to->failed = from->failed;
+}
+static int pass_reject(MTI *mti, MTIDATA value)
+{
+	return 0;
+}
+static MTIFUNCTIONS pass_fns = {pass_get, pass_call, pass_set, pass_compare, pass_gather, pass_reject};
+
+/* run a batch on the shared pool; returns 0 if the caller must run the batch itself */
+static int pass_batch_run(PASSDATA *output, PASSBATCH *batch, PASSDATA *input)
+{
+	if ( !batch->threaded || pass_pool==NULL )
+		return 0;
+	input->batch = batch;
+	input->run = ++pass_run;
+	return mti_run(output,pass_pool,input);
+}
+
+/* build the list of objects selected for a pass - must be called only once */
+static STATUS passlist_init(PASSLIST *list, int (*select)(OBJECT*))
+{
+	OBJECT *obj;
+	unsigned int n;
+
+	memset(list,0,sizeof(PASSLIST));
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+	{
+		if ( select(obj) )
+			list->n_obj++;
+	}
+	if ( list->n_obj==0 )
+		return SUCCESS;
+	list->obj = (OBJECT**)malloc(sizeof(OBJECT*)*list->n_obj);
+	list->batch = (PASSBATCH*)malloc(sizeof(PASSBATCH)*list->n_obj);
+	if ( list->obj==NULL || list->batch==NULL )
+		return FAILED;
+	n = 0;
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+	{
+		if ( select(obj) )
+			list->obj[n++] = obj;
+	}
+	qsort(list->obj,list->n_obj,sizeof(OBJECT*),passlist_cmp);
+
+	/* split the list into batches of the same rank */
+	for ( n=0 ; n<list->n_obj ; n++ )
+	{
+		if ( n==0 || list->obj[n]->rank!=list->obj[n-1]->rank )
+		{
+			PASSBATCH *batch = &list->batch[list->n_batches++];
+			batch->obj = list->obj+n;
+			batch->n_obj = 0;
+			batch->threaded = 0;
+		}
+		list->batch[list->n_batches-1].n_obj++;
+	}
+	if ( global_threadcount==1 )
+		return SUCCESS;
+
+	/* the pool is created once with one thread per chunk and shared by every pass list */
+	if ( !pass_tried )
+	{
+		pass_tried = 1;
+		pass_chunk = (unsigned int*)malloc(sizeof(unsigned int)*global_threadcount);
+		if ( pass_chunk!=NULL )
+		{
+			for ( pass_chunks=0 ; pass_chunks<(unsigned int)global_threadcount ; pass_chunks++ )
+				pass_chunk[pass_chunks] = pass_chunks;
+			pass_pool = mti_init("pass",&pass_fns,1);
+		}
+	}
+
+	/* batches that are too small to split are run single threaded */
+	for ( n=0 ; n<list->n_batches ; n++ )
+		list->batch[n].threaded = ( list->batch[n].n_obj>=2*PASS_MTI_MINOBJECTS );
+	return SUCCESS;
+}
+
+/* precommit an object (if it is in service) */
+static STATUS precommit_object(OBJECT *obj, TIMESTAMP t0)
+{
+	if ((obj->in_svc <= t0 && obj->out_svc >= t0) && (obj->in_svc_micro >= obj->out_svc_micro))
+		return object_precommit(obj, t0);
+	return SUCCESS;
+}
+static int precommit_select(OBJECT *obj)
+{
+	return obj->oclass->precommit!=NULL;
+}
+static void precommit_call(PASSDATA *output, OBJECT *obj, PASSDATA *input)
+{
+	if ( precommit_object(obj,input->t0)==FAILED )
+		output->failed = obj;
+}
+
 static STATUS precommit_all(TIMESTAMP t0)
 {
 	STATUS rv=SUCCESS;
 	static int first=1;
-	/* TODO implement this multithreaded */
-	static SIMPLELINKLIST *precommit_list = NULL;
-	SIMPLELINKLIST *item;
+	static PASSLIST precommit_list;
+	static PASSDATA input;
+	unsigned int n;
 	if ( first )
 	{
-		OBJECT *obj;
-		for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+		if ( passlist_init(&precommit_list,precommit_select)==FAILED )
 		{
-			if ( obj->oclass->precommit!=NULL )
-			{
-				item = (SIMPLELINKLIST*)malloc(sizeof(SIMPLELINKLIST));
-				if ( item==NULL )
-				{
-					char name[64];
-					output_error("object %s precommit memory allocation failed", object_name(obj,name,sizeof(name)-1));
-					/* TROUBLESHOOT
-					   Insufficient memory remains to perform the precommit operation.
-					   Free up memory and try again.
-					 */
-					return FAILED;
-				}
-				item->data = (void*)obj;
-				item->next = precommit_list;
-				precommit_list = item;
-			}
+			output_error("precommit memory allocation failed");
+			/* TROUBLESHOOT
+			   Insufficient memory remains to perform the precommit operation.
+			   Free up memory and try again.
+			 */
+			return FAILED;
 		}
 		first = 0;
 	}
 
 	TRY {
-		for ( item=precommit_list ; item!=NULL ; item=item->next )
+		input.t0 = t0;
+		input.call = precommit_call;
+		for ( n=0 ; n<precommit_list.n_batches && rv==SUCCESS ; n++ )
 		{
-			OBJECT *obj = (OBJECT*)item->data;
-			if ((obj->in_svc <= t0 && obj->out_svc >= t0) && (obj->in_svc_micro >= obj->out_svc_micro))
+			PASSBATCH *batch = &precommit_list.batch[n];
+			OBJECT *failed = NULL;
+			PASSDATA output;
+			if ( pass_batch_run(&output,batch,&input) )
+				failed = output.failed;
+			else
 			{
-				if ( object_precommit(obj, t0)==FAILED )
+				unsigned int k;
+				for ( k=0 ; k<batch->n_obj ; k++ )
 				{
-					char name[64];
-					output_error("object %s precommit failed", object_name(obj,name,sizeof(name)-1));
-					/* TROUBLESHOOT
-						The precommit function of the named object has failed.  Make sure that the object's
-						requirements for precommit'ing are satisfied and try again.  (likely internal state aberations)
-					 */
-					rv=FAILED;
-					break;
+					if ( precommit_object(batch->obj[k],t0)==FAILED )
+					{
+						failed = batch->obj[k];
+						break;
+					}
 				}
 			}
+			if ( failed!=NULL )
+			{
+				char name[64];
+				output_error("object %s precommit failed", object_name(failed,name,sizeof(name)-1));
+				/* TROUBLESHOOT
+					The precommit function of the named object has failed.  Make sure that the object's
+					requirements for precommit'ing are satisfied and try again.  (likely internal state aberations)
+				 */
+				rv=FAILED;
+			}
 		}
 	} 
 	CATCH(const char *msg)
@@ -981,190 +1197,102 @@ static STATUS precommit_all(TIMESTAMP t0)
 	return rv;
 }
 
-/**************************************************************************
- ** COMMIT ITERATOR
- **************************************************************************/
-static SIMPLELINKLIST *commit_list[2] = {NULL, NULL};
-/* initialize commit_list - must be called only once */
-static int commit_init(void)
+/* commit an object, updating the earliest next time
+   @return TS_INVALID if the commit failed
+ */
+static TIMESTAMP commit_object(OBJECT *obj, TIMESTAMP t0, TIMESTAMP t2, TIMESTAMP result)
 {
-	int n_commits = 0;
-	OBJECT *obj;
-	SIMPLELINKLIST *item;
-
-	/* build commit list */
-	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+	if ( t0<obj->in_svc )
 	{
-		if ( obj->oclass->commit!=NULL )
-		{
-			/* separate observers */
-			unsigned int pc = ((obj->oclass->passconfig&PC_OBSERVER)==PC_OBSERVER)?1:0;
-			item = (SIMPLELINKLIST*)malloc(sizeof(SIMPLELINKLIST));
-			if ( item==NULL ) 
-				throw_exception("commit_init memory allocation failure");
-			item->data = (void*)obj;
-			item->next = commit_list[pc];
-			commit_list[pc] = item;
-			n_commits++;
-		}
+		if ( obj->in_svc<result ) result = obj->in_svc;
 	}
-	return n_commits;
-}
-/* commit_list iterator */
-static MTIITEM commit_get0(MTIITEM item)
-{
-	if ( item==NULL )
-		return (MTIITEM)commit_list[0];
-	else
-		return (MTIITEM)(((SIMPLELINKLIST*)item)->next);
-}
-static MTIITEM commit_get1(MTIITEM item)
-{
-	if ( item==NULL )
-		return (MTIITEM)commit_list[1];
-	else
-		return (MTIITEM)(((SIMPLELINKLIST*)item)->next);
-}
-/* commit function call */
-static void commit_call(MTIDATA output, MTIITEM item, MTIDATA input)
-{
-	OBJECT *obj = (OBJECT*)(((SIMPLELINKLIST*)item)->data);
-	TIMESTAMP *t2 = (TIMESTAMP*)output;
-	TIMESTAMP *t0 = (TIMESTAMP*)input;
-	if ( *t0<obj->in_svc )
-		*t2 = obj->in_svc;
-	else if ((*t0 == obj->in_svc) && (obj->in_svc_micro != 0))
-		*t2 = obj->in_svc + 1;
-	else if ( obj->out_svc>=*t0 )
-		*t2 = obj->oclass->commit(obj,*t0);
-	else
-		*t2 = TS_NEVER;
-}
-/* commit data set accessor */
-static MTIDATA commit_set(MTIDATA to, MTIDATA from)
-{
-	/* allocation request */
-	if ( to==NULL ) to = (MTIDATA)malloc(sizeof(TIMESTAMP));
-
-	/* clear request (may follow allocation request) */
-	if ( from==NULL ) *(TIMESTAMP*)to = TS_NEVER;
-	
-	/* copy request */ 
-	else memcpy(to,from,sizeof(TIMESTAMP));	
-
-	return to;
-}
-/* commit data compare accessor */
-static int commit_compare(MTIDATA a, MTIDATA b)
-{
-	TIMESTAMP t0 = (a?*(TIMESTAMP*)a:TS_NEVER);
-	TIMESTAMP t1 = (b?*(TIMESTAMP*)b:TS_NEVER);
-	if ( t0>t1  ) return 1;
-	if ( t0<t1 ) return -1;
-	return 0;
+	else if ((t0 == obj->in_svc) && (obj->in_svc_micro != 0))
+	{
+		if (obj->in_svc == result)
+			result = obj->in_svc + 1;
+	}
+	else if ( obj->out_svc>=t0 )
+	{
+		TIMESTAMP next = object_commit(obj,t0,t2);
+		if ( next==TS_INVALID )
+			return TS_INVALID;
+		if ( next<result ) result = next;
+	}
+	return result;
 }
-/* commit data gather accessor */
-static void commit_gather(MTIDATA a, MTIDATA b)
+static int commit_select0(OBJECT *obj)
 {
-	TIMESTAMP *t0 = (TIMESTAMP*)a;
-	TIMESTAMP *t1 = (TIMESTAMP*)b;
-	if ( a==NULL || b==NULL ) return;
-	if ( *t1<*t0 ) *t0 = *t1;
+	return obj->oclass->commit!=NULL && (obj->oclass->passconfig&PC_OBSERVER)!=PC_OBSERVER;
 }
-/* commit iterator reject test */
-static int commit_reject(MTI *mti, MTIDATA value)
+static int commit_select1(OBJECT *obj)
 {
-	TIMESTAMP *t1 = (TIMESTAMP*)value;
-	TIMESTAMP *t2 = (TIMESTAMP*)mti->output;
-	if ( value==NULL ) return 0;
-	return ( *t2>*t1 && *t2<TS_NEVER ) ? 1 : 0;
+	return obj->oclass->commit!=NULL && (obj->oclass->passconfig&PC_OBSERVER)==PC_OBSERVER;
 }
-/* single threaded version of commit_all */
-static TIMESTAMP commit_all_st(TIMESTAMP t0, TIMESTAMP t2)
+static void commit_call(PASSDATA *output, OBJECT *obj, PASSDATA *input)
 {
-	TIMESTAMP result = TS_NEVER;
-	SIMPLELINKLIST *item;
-	unsigned int pc;
-	for ( pc=0 ; pc<2 ; pc ++ )
-	{
-		for ( item=commit_list[pc] ; item!=NULL ; item=item->next )
-		{
-			OBJECT *obj = (OBJECT*)item->data;
-			if ( t0<obj->in_svc )
-			{
-				if ( obj->in_svc<result ) result = obj->in_svc;
-			}
-			else if ((t0 == obj->in_svc) && (obj->in_svc_micro != 0))
-			{
-				if (obj->in_svc == result)
-					result = obj->in_svc + 1;
-			}
-			else if ( obj->out_svc>=t0 )
-			{
-				TIMESTAMP next = object_commit(obj,t0,t2);
-				if ( next==TS_INVALID )
-				{
-					char name[64];
-					throw_exception("object %s commit failed", object_name(obj,name,sizeof(name)-1));
-					/* TROUBLESHOOT
-						The commit function of the named object has failed.  Make sure that the object's
-						requirements for committing are satisfied and try again.  (likely internal state aberations)
-					 */
-				}
-				if ( next<result ) result = next;
-			}
-		}
-	}
-	return result;
+	TIMESTAMP result = commit_object(obj,input->t0,input->t2,TS_NEVER);
+	if ( result==TS_INVALID )
+		output->failed = obj;
+	else
+		output->result = result;
 }
-/* multi-threaded version of commit_all */
+
+/* commit all objects, observers after the others */
 static TIMESTAMP commit_all(TIMESTAMP t0, TIMESTAMP t2)
 {
-	static int n_commits = -1;
-	static MTI *mti[] = {NULL,NULL};
-	static int init_tried = FALSE;
-	MTIDATA input = (MTIDATA)&t0;
-	MTIDATA output = (MTIDATA)&t2;
+	static int first = 1;
+	static PASSLIST commit_list[2];
+	static PASSDATA input;
 	TIMESTAMP result = TS_NEVER;
 
 	TRY {
-		unsigned int pc;
-
-		/* build commit list */
-		if ( n_commits==-1 ) n_commits = commit_init();
+		unsigned int pc, n;
 
-		/* if no commits found, stop here */
-		if ( n_commits==0 )
+		/* build commit lists */
+		if ( first )
 		{
-			result = TS_NEVER;
+			if ( passlist_init(&commit_list[0],commit_select0)==FAILED
+				|| passlist_init(&commit_list[1],commit_select1)==FAILED )
+				throw_exception("commit_init memory allocation failure");
+			first = 0;
 		}
-		else
+
+		input.t0 = t0;
+		input.t2 = t2;
+		input.call = commit_call;
+		for ( pc=0 ; pc<2 ; pc++ )
 		{
-			/* initialize MTI */
-			for ( pc=0 ; pc<2 ; pc++ )
+			for ( n=0 ; n<commit_list[pc].n_batches ; n++ )
 			{
-				if ( mti[pc]==NULL && global_threadcount!=1 && !init_tried )
+				PASSBATCH *batch = &commit_list[pc].batch[n];
+				OBJECT *failed = NULL;
+				PASSDATA output;
+				if ( pass_batch_run(&output,batch,&input) )
+				{
+					failed = output.failed;
+					if ( output.result<result ) result = output.result;
+				}
+				else
 				{
-					/* build mti */
-					static MTIFUNCTIONS fns[] = {
-						{commit_get0, commit_call, commit_set,commit_compare, commit_gather, commit_reject},
-						{commit_get1, commit_call, commit_set,commit_compare, commit_gather, commit_reject},
-					};
-					mti[pc] = mti_init("commit",&fns[pc],8);
-					if ( mti[pc]==NULL )
+					unsigned int k;
+					for ( k=0 ; k<batch->n_obj && failed==NULL ; k++ )
 					{
-						output_warning("commit_all multi-threaded iterator initialization failed - using single-threaded iterator as fallback");
-						init_tried = TRUE;
+						TIMESTAMP next = commit_object(batch->obj[k],t0,t2,result);
+						if ( next==TS_INVALID )
+							failed = batch->obj[k];
+						else
+							result = next;
 					}
 				}
-
-				/* attempt to run multithreaded iterator */
-				if ( mti[pc]!=NULL && mti_run(output,mti[pc],input) )
-					result = *(TIMESTAMP*)output;
-
-				/* resort to single threaded iterator (which handles both passes) */
-				else if ( pc==0 )
-					result = commit_all_st(t0,t2);
+				if ( failed!=NULL )
+				{
+					char name[64];
+					throw_exception("object %s commit failed", object_name(failed,name,sizeof(name)-1));
+					/* TROUBLESHOOT
+						The commit function of the named object has failed.  Make sure that the object's
+						requirements for committing are satisfied and try again.  (likely internal state aberations)
+					 */
+				}
 			}
 		}
 	}
@@ -1355,13 +1483,27 @@ typedef struct s_objsyncdata {
 	unsigned int n; // thread id 0~n_threads for this object rank list
 	pthread_t pt;
 	bool ok;
-	//void *item;
-	LISTITEM *ls;
-	unsigned int nObj; // number of obj in this object rank list
 	unsigned int t0;
 	int i; // index of mutex or cond this object rank list uses 
 } OBJSYNCDATA;
 
+/* range of a flattened rank list owned by a sync thread */
+typedef struct s_objsyncrange {
+	unsigned int lock; // spinlock protecting next and end
+	unsigned int next; // next object not yet claimed
+	unsigned int end; // end of the range (exclusive)
+} OBJSYNCRANGE;
+
+/* flattened object rank list shared by the threads of its threadpool */
+typedef struct s_objranklist {
+	OBJECT **obj; // objects in the rank list
+	unsigned int n_obj; // number of objects in the rank list
+	unsigned int chunk; // number of objects claimed at once
+	unsigned int *offset; // first object initially assigned to each thread (n_threads+1 entries)
+	OBJSYNCRANGE *range; // one range per thread
+	OBJECTPROFILEITEM opi; // profile item of the pass this rank list is synced in
+} OBJRANKLIST;
+
 static pthread_mutex_t *startlock;
 static pthread_mutex_t *donelock;
 static pthread_cond_t *start;
@@ -1370,12 +1512,189 @@ static pthread_cond_t *done;
 static unsigned int *next_t1;
 static unsigned int *donecount;
 static unsigned int *n_threads; //number of thread used in the threadpool of an object rank list
+static OBJRANKLIST *ranklist; // flattened object rank lists
+
+/* flatten a rank list and assign its initial thread ranges */
+static STATUS objsync_setup(unsigned int i, GLLIST *list, OBJECTPROFILEITEM opi)
+{
+	OBJRANKLIST *rl = &ranklist[i];
+	LISTITEM *ptr;
+	unsigned int n = 0, incr;
+
+	rl->n_obj = list->size;
+	rl->opi = opi;
+	rl->obj = (OBJECT**)malloc(sizeof(OBJECT*)*rl->n_obj);
+	rl->offset = (unsigned int*)malloc(sizeof(unsigned int)*(n_threads[i]+1));
+	rl->range = (OBJSYNCRANGE*)malloc(sizeof(OBJSYNCRANGE)*n_threads[i]);
+	if ( rl->obj==NULL || rl->offset==NULL || rl->range==NULL )
+		return FAILED;
+	memset(rl->range,0,sizeof(OBJSYNCRANGE)*n_threads[i]);
+	for ( ptr=list->first ; ptr!=NULL && n<rl->n_obj ; ptr=ptr->next )
+		rl->obj[n++] = ptr->data;
+	rl->n_obj = n;
+
+	/* split evenly by object count until costs are known */
+	incr = (rl->n_obj+n_threads[i]-1)/n_threads[i];
+	for ( n=0 ; n<=n_threads[i] ; n++ )
+		rl->offset[n] = n*incr<rl->n_obj ? n*incr : rl->n_obj;
+
+	/* static scheduling claims the whole range at once */
+	if ( global_sync_scheduler==SS_STATIC )
+		rl->chunk = incr;
+	else if ( global_sync_chunksize>0 )
+		rl->chunk = global_sync_chunksize;
+	else
+		rl->chunk = incr/8>1 ? incr/8 : 1;
+	return SUCCESS;
+}
+
+/* reset the thread ranges of a rank list before a pass starts */
+static void objsync_reset(unsigned int i)
+{
+	OBJRANKLIST *rl = &ranklist[i];
+	unsigned int n;
+	for ( n=0 ; n<n_threads[i] ; n++ )
+	{
+		rl->range[n].next = rl->offset[n];
+		rl->range[n].end = rl->offset[n+1];
+	}
+}
+
+/* measured sync cost of an object in a rank list */
+typedef struct s_objsynccost {
+	OBJECT *obj;
+	double cost;
+	unsigned int thread;
+} OBJSYNCCOST;
+static int objsync_costcmp(const void *a, const void *b)
+{
+	const OBJSYNCCOST *ca = (const OBJSYNCCOST*)a, *cb = (const OBJSYNCCOST*)b;
+	if ( ca->thread!=cb->thread )
+		return ca->thread<cb->thread ? -1 : 1;
+	if ( ca->cost!=cb->cost )
+		return ca->cost>cb->cost ? -1 : 1;
+	return 0;
+}
+
+/* repartition a rank list among its threads using the measured sync cost of each object 
+   (longest processing time first), so each thread starts with about the same amount of work
+ */
+static STATUS objsync_rebalance(unsigned int i)
+{
+	OBJRANKLIST *rl = &ranklist[i];
+	OBJSYNCCOST *cost;
+	double *load;
+	unsigned int n, k;
+
+	if ( n_threads[i]<2 )
+		return SUCCESS;
+	cost = (OBJSYNCCOST*)malloc(sizeof(OBJSYNCCOST)*rl->n_obj);
+	load = (double*)malloc(sizeof(double)*n_threads[i]);
+	if ( cost==NULL || load==NULL )
+	{
+		free(cost);
+		free(load);
+		return FAILED;
+	}
+	for ( k=0 ; k<n_threads[i] ; k++ )
+		load[k] = 0.0;
+
+	/* cost is the moving average of the time each object's recent sync calls took */
+	for ( n=0 ; n<rl->n_obj ; n++ )
+	{
+		cost[n].obj = rl->obj[n];
+		cost[n].cost = rl->obj[n]->synccost[rl->opi];
+		cost[n].thread = 0;
+	}
+	qsort(cost,rl->n_obj,sizeof(OBJSYNCCOST),objsync_costcmp);
+
+	/* assign the most expensive remaining object to the least loaded thread */
+	for ( n=0 ; n<rl->n_obj ; n++ )
+	{
+		unsigned int best = 0;
+		for ( k=1 ; k<n_threads[i] ; k++ )
+		{
+			if ( load[k]<load[best] )
+				best = k;
+		}
+		cost[n].thread = best;
+		load[best] += cost[n].cost;
+	}
+
+	/* group by thread keeping the most expensive objects at the front of each range */
+	qsort(cost,rl->n_obj,sizeof(OBJSYNCCOST),objsync_costcmp);
+	for ( k=0 ; k<=n_threads[i] ; k++ )
+		rl->offset[k] = rl->n_obj;
+	for ( n=rl->n_obj ; n>0 ; n-- )
+	{
+		rl->obj[n-1] = cost[n-1].obj;
+		rl->offset[cost[n-1].thread] = n-1;
+	}
+	for ( k=n_threads[i] ; k>0 ; k-- )
+	{
+		if ( rl->offset[k-1]>rl->offset[k] )
+			rl->offset[k-1] = rl->offset[k];
+	}
+	free(cost);
+	free(load);
+	return SUCCESS;
+}
+
+/* claim the next chunk of objects for a thread, stealing from other threads when its own range is exhausted */
+static bool objsync_claim(unsigned int i, unsigned int thread, unsigned int *first, unsigned int *last)
+{
+	OBJRANKLIST *rl = &ranklist[i];
+	OBJSYNCRANGE *own = &rl->range[thread];
+	unsigned int k;
+
+	/* take the next chunk from the front of the thread's own range */
+	wlock(&own->lock);
+	*first = own->next;
+	*last = own->end-own->next>rl->chunk ? own->next+rl->chunk : own->end;
+	own->next = *last;
+	wunlock(&own->lock);
+	if ( *first<*last )
+		return true;
+	if ( global_sync_scheduler==SS_STATIC )
+		return false;
+
+	/* steal the back half of the first busy thread's remaining range */
+	for ( k=1 ; k<n_threads[i] ; k++ )
+	{
+		OBJSYNCRANGE *victim = &rl->range[(thread+k)%n_threads[i]];
+		unsigned int remain;
+		if ( victim->next>=victim->end )
+			continue;
+		wlock(&victim->lock);
+		remain = victim->end>victim->next ? victim->end-victim->next : 0;
+		if ( remain>0 )
+		{
+			*first = victim->next + remain/2;
+			*last = victim->end;
+			victim->end = *first;
+		}
+		wunlock(&victim->lock);
+		if ( remain==0 )
+			continue;
+
+		/* keep one chunk and publish the rest so it can be stolen in turn */
+		if ( *last-*first>rl->chunk )
+		{
+			wlock(&own->lock);
+			own->next = *first+rl->chunk;
+			own->end = *last;
+			wunlock(&own->lock);
+			*last = *first+rl->chunk;
+		}
+		return true;
+	}
+	return false;
+}
 
 static void *obj_syncproc(void *ptr)
 {
 	OBJSYNCDATA *data = (OBJSYNCDATA*)ptr;
-	LISTITEM *s;
-	unsigned int n;
+	unsigned int first, last, n;
 	int i = data->i;
 
 	// begin processing loop
@@ -1390,10 +1709,11 @@ static void *obj_syncproc(void *ptr)
 		// unlock access to start count
 		pthread_mutex_unlock(&startlock[i]);
 
-		// process the list for this thread
-		for (s=data->ls, n=0; s!=NULL, n<data->nObj; s=s->next,n++) {
-			OBJECT *obj = s->data;
-			ss_do_object_sync(data->n, s->data);
+		// process chunks of the rank list until none are left
+		while ( objsync_claim(i,data->n,&first,&last) )
+		{
+			for ( n=first ; n<last ; n++ )
+				ss_do_object_sync(data->n, ranklist[i].obj[n]);
 		}
 
 		// signal completed condition
@@ -1856,9 +2176,9 @@ STATUS exec_start(void)
 	/*** GET FIRST SIGNAL FROM MASTER HERE ****/
 	if (global_multirun_mode == MRM_SLAVE)
 	{
+		pthread_mutex_lock(&mls_inst_lock);
 		pthread_cond_broadcast(&mls_inst_signal); // tell slaveproc() it's time to get rolling
 		IN_MYCONTEXT output_debug("exec_start(), slave waiting for first time signal");
-		pthread_mutex_lock(&mls_inst_lock);
 		pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
 		pthread_mutex_unlock(&mls_inst_lock);
 		// will have copied data down and updated step_to with slave_cache
@@ -1917,6 +2237,9 @@ STATUS exec_start(void)
 	n_threads = malloc(sizeof(n_threads[0])*nObjRankList);
 	memset(n_threads,0,sizeof(n_threads[0])*nObjRankList);
 
+	ranklist = malloc(sizeof(ranklist[0])*nObjRankList);
+	memset(ranklist,0,sizeof(ranklist[0])*nObjRankList);
+
 	// allocation and nitialize mutex and cond for object rank lists
 	startlock = malloc(sizeof(startlock[0])*nObjRankList);
 	donelock = malloc(sizeof(donelock[0])*nObjRankList);
@@ -2166,7 +2489,7 @@ STATUS exec_start(void)
 						} 
 						else 
 						{ //sjin: implement pthreads
-							unsigned int n_items,objn=0,n;
+							unsigned int n;
 							unsigned int n_obj = ranks[pass]->ordinal[i]->size;
 
 							// Only create threadpool for each object rank list at the first iteration. 
@@ -2174,45 +2497,39 @@ STATUS exec_start(void)
 							if (setTP == true) { 
 								incr = (int)ceil((float) n_obj / global_threadcount);
 								// if the number of objects is less than or equal to the number of threads, each thread process one object 
-								if (incr <= 1) {
+								if (incr <= 1)
 									n_threads[iObjRankList] = n_obj;
-									n_items = 1;
-								// if the number of objects is greater than the number of threads, each thread process the same number of 
-								// objects (incr), except that the last thread may process less objects 
-								} else {
+								// if the number of objects is greater than the number of threads, each thread starts with the same number of 
+								// objects (incr), except that the last thread may start with less objects 
+								else
 									n_threads[iObjRankList] = (int)ceil((float) n_obj / incr);
-									n_items = incr;
-								}
 								if ((int)n_threads[iObjRankList] > global_threadcount) {
 									output_error("Running threads > global_threadcount");
 									exit(0);
 								}
 
+								// flatten the rank list into the shared object array
+								if ( objsync_setup(iObjRankList,ranks[pass]->ordinal[i],(OBJECTPROFILEITEM)pass)==FAILED )
+									THROW("object rank list allocation failed");
+
 								// allocate thread list
 								thread = (OBJSYNCDATA*)malloc(sizeof(OBJSYNCDATA)*n_threads[iObjRankList]);
 								memset(thread,0,sizeof(OBJSYNCDATA)*n_threads[iObjRankList]);
-								// assign starting obj for each thread
-								for (ptr=ranks[pass]->ordinal[i]->first;ptr!=NULL;ptr=ptr->next)
-								{
-									if (thread[objn].nObj==n_items)
-										objn++;
-									if (thread[objn].nObj==0) {
-										thread[objn].ls=ptr;
-									}
-									thread[objn].nObj++;
-								}
 								// create threads
 								for (n=0; n<n_threads[iObjRankList]; n++) {
 									thread[n].ok = true;
 									thread[n].i = iObjRankList;
+									thread[n].n = n;
 									if (pthread_create(&(thread[n].pt),NULL,obj_syncproc,&(thread[n]))!=0) {
 										output_fatal("obj_sync thread creation failed");
 										thread[n].ok = false;
-									} else
-										thread[n].n = n;
+									}
 								}
 
 							}
+
+							// restore the initial range of each thread
+							objsync_reset(iObjRankList);
 														
 							// lock access to done count
 							pthread_mutex_lock(&donelock[iObjRankList]);
@@ -2270,15 +2587,26 @@ STATUS exec_start(void)
 			/* count number of passes */
 			passes++;
 
+			/* rebalance sync threads using the cost measured so far */
+			if ( !global_debug_mode && global_threadcount>1 && global_sync_scheduler==SS_COSTAWARE 
+				&& global_sync_rebalance_interval>0 && passes%global_sync_rebalance_interval==0 )
+			{
+				for ( k=0 ; k<nObjRankList ; k++ )
+				{
+					if ( ranklist[k].obj!=NULL && objsync_rebalance(k)==FAILED )
+						THROW("sync thread rebalancing failed");
+				}
+				IN_MYCONTEXT output_debug("sync threads rebalanced after %lli passes", passes);
+			}
+
 			/**** LOOPED SLAVE PAUSE HERE ****/
 			if(global_multirun_mode == MRM_SLAVE)
 			{
 				IN_MYCONTEXT output_debug("step_to = %lli", exec_sync_get(NULL));
 				IN_MYCONTEXT output_debug("exec_start(), slave waiting for looped time signal");
 
-				pthread_cond_broadcast(&mls_inst_signal);
-
 				pthread_mutex_lock(&mls_inst_lock);
+				pthread_cond_broadcast(&mls_inst_signal);
 				pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
 				pthread_mutex_unlock(&mls_inst_lock);
 
@@ -2393,7 +2721,7 @@ STATUS exec_start(void)
 	IN_MYCONTEXT output_debug("*** main loop ended at %lli; stoptime=%lli, n_events=%i, exitcode=%i ***", exec_sync_get(NULL), global_stoptime, exec_sync_getevents(NULL), exec_getexitcode());
 	if(global_multirun_mode == MRM_MASTER)
 	{
-		instance_master_done(TS_NEVER); // tell everyone to pack up and go home
+		instance_dispose(); // tell everyone to pack up and go home
 	}
 
 	//sjin: GetMachineCycleCount
@@ -2425,8 +2753,11 @@ STATUS exec_start(void)
 #endif
 	}
 
-	// Destroy mutex and cond
+	// Destroy mutex and cond, except those the sync threads of a rank list
+	// are still blocked on (pthread_cond_destroy waits for the waiters)
 	for(k=0;k<nObjRankList;k++) {
+		if ( n_threads[k]>0 )
+			continue;
 		pthread_mutex_destroy(&startlock[k]);
 		pthread_mutex_destroy(&donelock[k]);
 		pthread_cond_destroy(&start[k]);
@@ -35,6 +35,7 @@ STATUS t_setup_ranks(void);
 INDEX **exec_getranks(void);
 void exec_sleep(unsigned int usec);
 int64 exec_clock(void);
+double exec_clock_hires(void);
 
 void exec_mls_create(void);
 void exec_mls_init(void);
@@ -71,6 +72,7 @@ EXITCODE exec_run_commitscripts(void);
 EXITCODE exec_run_termscripts(void);
 
 int64 exec_clock(void);
+double exec_clock_hires(void);
 
 #ifdef __cplusplus
 }
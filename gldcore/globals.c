@@ -47,7 +47,8 @@ static KEYWORD cpt_keys[] = {
 
 static KEYWORD rng_keys[] = {
 	{"RNG2", RNG2, rng_keys+1},		/**< version 2 random number generator (stateless) */
-	{"RNG3", RNG3, NULL,},			/**< version 3 random number generator (statefull) */
+	{"RNG3", RNG3, rng_keys+2},		/**< version 3 random number generator (statefull) */
+	{"RNG4", RNG4, NULL,},			/**< version 4 random number generator (counter-based streams) */
 };
 
 static KEYWORD mls_keys[] = {
@@ -96,6 +97,11 @@ static KEYWORD vo_keys[] = {
 	{"RDIR", VO_RPTDIR, vo_keys+9},
 	{"RGLM", VO_RPTGLM, NULL},
 };
+static KEYWORD ss_keys[] = {
+	{"STATIC", SS_STATIC, ss_keys+1},				/**< fixed contiguous chunks per thread */
+	{"WORKSTEALING", SS_WORKSTEALING, ss_keys+2},	/**< dynamic chunks with work stealing */
+	{"COSTAWARE", SS_COSTAWARE, NULL},			/**< work stealing with ranges balanced by measured sync cost */
+};
 static KEYWORD so_keys[] = {
 	{"NAMES", SO_NAMES, so_keys+1},
 	{"POSITIONS", SO_GEOCOORDS, NULL},
@@ -260,7 +266,7 @@ static struct s_varmap {
 	{"master_port", PT_int64, &global_master_port, PA_PUBLIC, "master server port number"},
 	{"multirun_mode", PT_enumeration, &global_multirun_mode, PA_PUBLIC, "multirun enable flag", mrm_keys},
 	{"multirun_conn", PT_enumeration, &global_multirun_connection, PA_PUBLIC, "unused", mrc_keys},
-	{"signal_timeout", PT_int32, &global_signal_timeout, PA_PUBLIC, "unused"},
+	{"signal_timeout", PT_int32, &global_signal_timeout, PA_PUBLIC, "master/slave signal timeout in milliseconds (-1 is infinite)"},
 	{"slave_port", PT_int16, &global_slave_port, PA_PUBLIC, "unused"},
 	{"slave_id", PT_int64, &global_slave_id, PA_PUBLIC, "unused"},
 	{"return_code", PT_int32, &global_return_code, PA_REFERENCE, "unused"},
@@ -268,6 +274,9 @@ static struct s_varmap {
 	{"module_compiler_flags", PT_set, &global_module_compiler_flags, PA_PUBLIC, "module compiler flags", mcf_keys},
 	{"init_max_defer", PT_int32, &global_init_max_defer, PA_REFERENCE, "deferred initialization limit"},
 	{"mt_analysis", PT_bool, &global_mt_analysis, PA_PUBLIC, "perform multithread profile optimization analysis"},
+	{"sync_scheduler", PT_enumeration, &global_sync_scheduler, PA_PUBLIC, "sync pass thread scheduling method", ss_keys},
+	{"sync_chunksize", PT_int32, &global_sync_chunksize, PA_PUBLIC, "number of objects claimed at once by a sync thread (0 is automatic)"},
+	{"sync_rebalance_interval", PT_int32, &global_sync_rebalance_interval, PA_PUBLIC, "number of passes between cost-aware sync thread rebalancing"},
 	{"inline_block_size", PT_int32, &global_inline_block_size, PA_PUBLIC, "inline code block size"},
 	{"validate", PT_set, &global_validateoptions, PA_PUBLIC, "validation test options",vo_keys},
 	{"sanitize", PT_set, &global_sanitizeoptions, PA_PUBLIC, "sanitize process options",so_keys},
@@ -283,6 +292,9 @@ static struct s_varmap {
 	{"deltamode_iteration_limit", PT_int32, &global_deltamode_iteration_limit, PA_PUBLIC, "iteration limit for each delta timestep (object and interupdate)"},
 	{"deltamode_forced_extra_timesteps",PT_int32, &global_deltamode_forced_extra_timesteps, PA_PUBLIC, "forced extra deltamode timesteps before returning to event-driven mode"},
 	{"deltamode_forced_always",PT_bool, &global_deltamode_forced_always, PA_PUBLIC, "forced deltamode for debugging -- prevents event-driven mode"},
+	{"deltamode_adaptive",PT_bool, &global_deltamode_adaptive, PA_PUBLIC, "vary the deltamode step size according to the state changes reported by the modules"},
+	{"deltamode_timestep_max",PT_int32,&global_deltamode_timestep_max,PA_PUBLIC, "largest step size (ns) for adaptive deltamode simulations"},
+	{"deltamode_error_tolerance",PT_double,&global_deltamode_error_tolerance,PA_PUBLIC, "largest state change (pu) allowed in one adaptive deltamode step"},
 	{"run_powerworld", PT_bool, &global_run_powerworld, PA_PUBLIC, "boolean that that says your system is set up correctly to run with PowerWorld"},
 	{"bigranks", PT_bool, &global_bigranks, PA_PUBLIC, "enable fast/blind set_rank operations"},
 	{"exename", PT_char1024, &global_execname, PA_REFERENCE, "argv[0] value"},
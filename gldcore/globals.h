@@ -217,6 +217,7 @@ GLOBAL int global_check_version INIT(0); /**< check version flag */
 typedef enum {
 	RNG2=2, /**< random numbers generated using pre-V3 method */
 	RNG3=3, /**< random numbers generated using post-V2 method */
+	RNG4=4, /**< random numbers generated using counter-based per-object and per-thread streams */
 } RANDOMNUMBERGENERATOR; /**< identifies the type of random number generator used */
 GLOBAL int global_randomnumbergenerator INIT(RNG3); /**< select which random number generator to use */
 
@@ -258,6 +259,9 @@ GLOBAL char global_deltamode_updateorder[1025] INIT(""); /**< the order in which
 GLOBAL unsigned int global_deltamode_iteration_limit INIT(10);	/**< Global iteration limit for each delta timestep (object and interupdate calls) */
 GLOBAL unsigned int global_deltamode_forced_extra_timesteps INIT(0);	/**< Deltamode forced extra time steps -- once all items want SM_EVENT, this will force this many more updates */
 GLOBAL bool global_deltamode_forced_always INIT(false);	/**< Deltamode flag - prevents exit from deltamode (no SM_EVENT) -- mainly for debugging purposes */
+GLOBAL bool global_deltamode_adaptive INIT(false);	/**< Deltamode flag - vary the timestep according to the state changes reported by the modules */
+GLOBAL DT global_deltamode_timestep_max INIT(1000000000);	/**< largest adaptive delta mode time step in ns (default is 1s) */
+GLOBAL double global_deltamode_error_tolerance INIT(0.001);	/**< largest state change per adaptive delta mode time step (pu) */
 
 /* master/slave */
 GLOBAL char global_master[1024] INIT(""); /**< master hostname */
@@ -300,6 +304,16 @@ GLOBAL MODULECOMPILEFLAGS global_module_compiler_flags INIT(MC_NONE); /** module
 /* multithread performance optimization analysis */
 GLOBAL unsigned int global_mt_analysis INIT(0); /**< perform multithread analysis (requires profiler) */
 
+/* sync pass thread scheduling */
+typedef enum {
+	SS_STATIC=0,		/**< each thread syncs a fixed contiguous chunk of the rank list */
+	SS_WORKSTEALING=1,	/**< threads claim small chunks and steal from busy threads when idle */
+	SS_COSTAWARE=2,		/**< like SS_WORKSTEALING but ranges are periodically balanced using measured sync cost */
+} SYNCSCHEDULER; /**< determines how objects in a rank are distributed among threads */
+GLOBAL int global_sync_scheduler INIT(SS_WORKSTEALING); /**< sync pass thread scheduler */
+GLOBAL unsigned int global_sync_chunksize INIT(0); /**< number of objects claimed at once by a sync thread (0 means automatic) */
+GLOBAL unsigned int global_sync_rebalance_interval INIT(100); /**< number of main loop passes between cost-aware rebalancing of sync threads */
+
 /* inline code block size */
 GLOBAL unsigned int global_inline_block_size INIT(16*65536); /**< inline code block size */
 
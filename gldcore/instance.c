@@ -18,6 +18,9 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <sys/errno.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
 #define SOCKET int
 #define INVALID_SOCKET (-1)
 #define closesocket close
@@ -218,10 +221,14 @@ void *instance_runproc(void *ptr)
 #endif
 		case CI_SHMEM:
 #ifdef WIN32
+			output_error("Shared Memory (shmem) instance mode not supported under Windows, please use Memory Map (mmap) instead.");
 			rc = -1;
-			break;
 #else
-			// shmem not written yet
+			/* run new instance and wait for it to exit */
+			sprintf(cmd,"%s/gridlabd %s %s --slave localhost:%"FMT_INT64"x %s", global_execdir, global_verbose_mode?"--verbose":"", global_debug_output?"--debug":"", inst->cacheid, inst->model);
+			IN_MYCONTEXT output_verbose("starting new instance with command '%s'", cmd);
+			rc = system(cmd);
+			rc = ( rc!=-1 && WIFEXITED(rc) ) ? WEXITSTATUS(rc) : -1;
 #endif
 			break;
 		case CI_SOCKET:
@@ -345,6 +352,82 @@ int instance_master_wait_mmap(instance *inst){
 #endif
 }
 
+#ifndef WIN32
+/** instance_shmem_wait
+	Wait on a shared memory signal for at most global_signal_timeout milliseconds
+	(forever if the timeout is negative).
+	@returns 0 when signalled, otherwise the errno of the failed wait.
+ **/
+int instance_shmem_wait(sem_t *sem)
+{
+	struct timespec ts;
+	int rc;
+
+	if ( global_signal_timeout<0 )
+	{
+		while ( (rc=sem_wait(sem))!=0 && errno==EINTR ) {}
+		return rc==0 ? 0 : errno;
+	}
+	clock_gettime(CLOCK_REALTIME,&ts);
+	ts.tv_sec += global_signal_timeout/1000;
+	ts.tv_nsec += (long)(global_signal_timeout%1000)*1000000L;
+	if ( ts.tv_nsec>=1000000000L )
+	{
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	while ( (rc=sem_timedwait(sem,&ts))!=0 && errno==EINTR ) {}
+	return rc==0 ? 0 : errno;
+}
+
+/** instance_shmem_release
+	Unmap the shared memory segment of an instance.  The owner (the master)
+	also destroys the signals, so it may only do so once the slave has exited.
+ **/
+void instance_shmem_release(instance *inst, int owner)
+{
+	if ( inst->shmem==NULL )
+		return;
+	if ( owner )
+	{
+		sem_destroy(&inst->shmem->master);
+		sem_destroy(&inst->shmem->slave);
+	}
+	if ( munmap(inst->shmem,inst->shmsize)!=0 )
+		output_warning("unable to unmap cache of slave %d (%s)", inst->id, strerror(errno));
+	inst->shmem = NULL;
+}
+#endif
+
+int instance_master_wait_shmem(instance *inst){
+#ifndef WIN32
+	int rc;
+
+	if(0 == inst){
+		output_error("instance_master_wait_shmem(): null inst pointer");
+		return 0;
+	}
+
+	/* the slave writes its links and next time directly into the shared cache */
+	rc = instance_shmem_wait(&inst->shmem->master);
+	switch ( rc ) {
+		case 0:
+			IN_MYCONTEXT output_debug("slave %d wait completed", inst->id);
+			return 1;
+		case ETIMEDOUT:
+			output_error("slave %d wait timeout", inst->id);
+			break;
+		default:
+			output_error("slave %d wait failed (%s)", inst->id, strerror(rc));
+			break;
+	}
+	return 0;
+#else
+	output_error("instance_master_wait_shmem(): should not have been called under Windows");
+	return 0;
+#endif
+}
+
 int instance_master_wait_socket(instance *inst){
 
 	if(0 == inst){
@@ -399,7 +482,9 @@ int instance_master_wait(void)
 			status = instance_master_wait_mmap(inst);
 		}
 #else
-	// @todo linux/unix slave signalling
+		if(inst->cnxtype == CI_SHMEM){
+			status = instance_master_wait_shmem(inst);
+		}
 #endif
 		if(inst->cnxtype == CI_SOCKET){
 			status = instance_master_wait_socket(inst);
@@ -429,7 +514,14 @@ void instance_master_done_mmap(instance *inst){
 }
 
 void instance_master_done_shmem(instance *inst){
-	;	// send
+	if(0 == inst){
+		output_error("instance_master_done_shmem(): null inst pointer");
+		return;
+	}
+#ifndef WIN32
+	if ( sem_post(&inst->shmem->slave)!=0 )
+		output_error("instance_master_done_shmem(): unable to signal slave %d (%s)", inst->id, strerror(errno));
+#endif
 }
 
 void instance_master_done_socket(instance *inst){
@@ -443,6 +535,8 @@ void instance_master_done_socket(instance *inst){
 	}
 
 	// write data from cache to buffer
+	// the frame always carries every slot because the slave reads a fixed size,
+	// so unchanged links only save their conversion on this transport
 	memset(inst->buffer, 0, inst->buffer_size);
 	sprintf(inst->buffer, MSG_DATA);
 	offset = (int)strlen(MSG_DATA);
@@ -650,9 +744,6 @@ STATUS instance_initall(void)
 		global_multirun_mode = MRM_MASTER;
 		IN_MYCONTEXT output_verbose("entering multirun mode");
 		output_prefix_enable();
-		pthread_mutex_lock(&mls_inst_lock);
-		pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
-		
 	} else {
 		return SUCCESS;
 	}
@@ -665,6 +756,27 @@ STATUS instance_initall(void)
 
 	// wait for slaves to signal init done
 	rv = instance_master_wait();
+	// settle the link encodings offered by the slaves
+	for ( inst=instance_list ; rv!=0 && inst!=NULL ; inst=inst->next )
+	{
+		linkage *lnk;
+		for ( lnk=inst->write ; lnk!=NULL ; lnk=lnk->next )
+			linkage_negotiate(lnk);
+		for ( lnk=inst->read ; lnk!=NULL ; lnk=lnk->next )
+			linkage_negotiate(lnk);
+	}
+#ifndef WIN32
+	// slaves have mapped their caches by now, so the names can go
+	for ( inst=instance_list ; inst!=NULL ; inst=inst->next )
+	{
+		if ( inst->cnxtype==CI_SHMEM )
+		{
+			char cachename[64];
+			sprintf(cachename,SHMEM_NAME,inst->cacheid);
+			shm_unlink(cachename);
+		}
+	}
+#endif
 	if(0 == rv){
 		output_error("instance_initall(): final wait() failed");
 		return FAILED;
@@ -696,7 +808,22 @@ STATUS instance_write_slave(instance *inst)
 		}
 	}
 	//IN_MYCONTEXT output_verbose("copying %d bytes from %x to %x (%lli)", inst->cachesize, inst->cache, inst->buffer, inst->cache->ts);
-	memcpy(inst->buffer, inst->cache, inst->cachesize);
+	switch ( inst->cnxtype ) {
+	case CI_MMAP:
+		// only the header and the slots written since the last sync are copied to the map
+		memcpy(inst->buffer, inst->cache, sizeof(MESSAGE));
+		for ( lnk=inst->write ; lnk!=NULL ; lnk=lnk->next )
+		{
+			size_t offset = lnk->addr - (char*)inst->cache;
+			if ( ((LINKAGEHEADER*)(inst->buffer+offset))->seq!=lnk->seq )
+				memcpy(inst->buffer+offset, lnk->addr, lnk->prop_size);
+		}
+		break;
+	case CI_SOCKET: // instance_master_done_socket frames the whole cache when it sends it
+	case CI_SHMEM: // shmem links write in place
+	default:
+		break;
+	}
 	printcontent(inst->buffer, (int)inst->cachesize);
 	return SUCCESS;
 }
@@ -799,7 +926,16 @@ STATUS instance_dispose(){
 		instance_master_done(TS_NEVER);
 		for(inst = instance_list; inst != 0; inst = inst->next){
 			// release pthread and event resources
-			;
+#ifndef WIN32
+			if ( inst->cnxtype==CI_SHMEM && inst->shmem!=NULL )
+			{
+				// the signals may only be destroyed once the slave has exited
+				pthread_join(inst->threadid,NULL);
+				inst->cache = NULL;
+				inst->buffer = NULL;
+				instance_shmem_release(inst,1);
+			}
+#endif
 		}
 		return SUCCESS;
 	} else { // slave
@@ -14,6 +14,10 @@
 #include "linkage.h"
 #include "lock.h"
 
+#ifndef WIN32
+#include <semaphore.h>
+#endif
+
 #define HS_SYN		"GLDMTR"
 #define HS_ACK		"GLDSND"
 // note trailing space for CBK
@@ -68,6 +72,22 @@ typedef struct s_message_wrapper {
 	char *data_buffer;
 } MESSAGEWRAPPER;
 
+#ifndef WIN32
+/** shared memory segment header (linux localhost)
+	The message cache follows the header in the same segment, so linkages
+	read and write their data in place and only the semaphores cross the
+	process boundary.
+ **/
+typedef struct s_shmem_header {
+	sem_t master;		///< posted by the slave when its step is done
+	sem_t slave;		///< posted by the master when the slave may step
+	size_t cachesize;	///< size of the message cache after the header
+} SHMEMHEADER;
+#define SHMEM_CACHE(H) ((MESSAGE*)((char*)(H)+sizeof(SHMEMHEADER)))
+#define SHMEM_NAME "/gld-%"FMT_INT64"x" ///< name of the segment of a cacheid (process id in the high word, count in the low word)
+#define SHMEM_MAXTRIES 256 ///< names tried by a master before it gives up creating a segment
+#endif
+
 typedef struct s_instance {
 
 	// master info
@@ -126,6 +146,8 @@ typedef struct s_instance {
 			int fd; ///<
 			int shmkey; ///<
 			int shmid; ///<
+			SHMEMHEADER *shmem; ///< mapped shared memory segment
+			size_t shmsize; ///< size of the mapped segment
 		};
 #endif
 		struct {
@@ -171,7 +193,14 @@ int linkage_create_writer(instance *inst, char *fromobj, char *fromvar, char *to
 STATUS linkage_init(instance *inst, linkage *lnk);
 STATUS linkage_master_to_slave(char *buffer, linkage *lnk);
 STATUS linkage_slave_to_master(char *buffer, linkage *lnk);
+size_t linkage_buffersize(PROPERTY *prop);
+void linkage_offer(linkage *lnk);
+void linkage_negotiate(linkage *lnk);
 
 void printcontent(unsigned char *data, size_t len);
+#ifndef WIN32
+int instance_shmem_wait(sem_t *sem);
+void instance_shmem_release(instance *inst, int owner);
+#endif
 
 #endif
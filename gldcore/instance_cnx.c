@@ -96,8 +96,108 @@ STATUS instance_cnx_mmap(instance *inst){
 #endif
 }
 
+/** instance_cnx_shmem
+	Create the POSIX shared memory segment and semaphores for a slave on
+	the local host.  The instance cache is moved into the segment so the
+	linkages exchange their data in place with no copy on either side.
+ **/
 STATUS instance_cnx_shmem(instance *inst){
+#ifndef WIN32
+	static unsigned int shmem_count = 0; /* caches created by this process */
+	char cachename[64];
+	size_t shmsize, prop_offset = 0;
+	linkage *lnk;
+
+	if(inst == 0){
+		output_error("instance_cnx_shmem: no instance provided");
+		return FAILED;
+	}
+
+	/* setup cache - the id given to the slave holds the process id and a count of the caches
+	   created by this process, so masters started together on this host never use the same name,
+	   and names left by runs that did not clean up are skipped */
+	do {
+		inst->cacheid = ((unsigned int64)getpid()<<32) | ++shmem_count;
+		sprintf(cachename,SHMEM_NAME,inst->cacheid);
+		inst->fd = shm_open(cachename,O_RDWR|O_CREAT|O_EXCL,0600);
+	} while ( inst->fd<0 && errno==EEXIST && shmem_count<SHMEM_MAXTRIES );
+	if ( inst->fd<0 )
+	{
+		output_error("unable to create cache '%s' for instance '%s' (%s)", cachename, inst->model, strerror(errno));
+		/* TROUBLESHOOT
+		   The shared memory object could not be created.  If the error indicates that the file exists,
+		   previous runs that did not clean up have left many objects in /dev/shm;
+		   remove the stale objects named /dev/shm/gld-* and try again.
+		   */
+		return FAILED;
+	}
+	shmsize = sizeof(SHMEMHEADER) + inst->cachesize;
+	if ( ftruncate(inst->fd,(off_t)shmsize)!=0 )
+	{
+		output_error("unable to size cache '%s' for instance '%s' (%s)", cachename, inst->model, strerror(errno));
+		close(inst->fd);
+		shm_unlink(cachename);
+		return FAILED;
+	}
+	inst->shmem = (SHMEMHEADER*)mmap(NULL,shmsize,PROT_READ|PROT_WRITE,MAP_SHARED,inst->fd,0);
+	close(inst->fd); /* the mapping stays valid without the descriptor */
+	inst->fd = -1;
+	if ( inst->shmem==MAP_FAILED )
+	{
+		inst->shmem = NULL;
+		output_error("unable to map cache '%s' for instance '%s' (%s)", cachename, inst->model, strerror(errno));
+		shm_unlink(cachename);
+		return FAILED;
+	}
+	inst->shmsize = shmsize;
+	IN_MYCONTEXT output_debug("cache '%s' created for instance '%s' (%d bytes)", cachename, inst->model, shmsize);
+
+	/* setup signalling semaphores */
+	if ( sem_init(&inst->shmem->master,1,0)!=0 )
+	{
+		output_error("unable to create signals in cache '%s' for slave %d (%s)", cachename, inst->id, strerror(errno));
+		instance_shmem_release(inst,0);
+		shm_unlink(cachename);
+		return FAILED;
+	}
+	if ( sem_init(&inst->shmem->slave,1,0)!=0 )
+	{
+		output_error("unable to create signals in cache '%s' for slave %d (%s)", cachename, inst->id, strerror(errno));
+		sem_destroy(&inst->shmem->master);
+		instance_shmem_release(inst,0);
+		shm_unlink(cachename);
+		return FAILED;
+	}
+	inst->shmem->cachesize = inst->cachesize;
+
+	/* move the message cache into the segment and repoint the linkages at it */
+	memcpy(SHMEM_CACHE(inst->shmem), inst->cache, inst->cachesize);
+	free(inst->cache);
+	free(inst->message);
+	inst->buffer = (char*)(inst->cache = SHMEM_CACHE(inst->shmem));
+	if ( FAILED==messagewrapper_init(&(inst->message), inst->cache) )
+	{
+		inst->buffer = NULL;
+		inst->cache = NULL;
+		instance_shmem_release(inst,1);
+		shm_unlink(cachename);
+		return FAILED;
+	}
+	for ( lnk=inst->write ; lnk!=NULL ; lnk=lnk->next ){
+		lnk->addr = inst->message->data_buffer + prop_offset;
+		prop_offset += lnk->prop_size;
+	}
+	for ( lnk=inst->read ; lnk!=NULL ; lnk=lnk->next ){
+		lnk->addr = inst->message->data_buffer + prop_offset;
+		prop_offset += lnk->prop_size;
+	}
+
+	IN_MYCONTEXT output_verbose("slave %d assigned to '%s'", inst->id, inst->model);
+	return SUCCESS;
+#else
+	output_error("Shared Memory (shmem) instance mode not supported under Windows, please use Memory Map (mmap) instead.");
 	return FAILED;
+#endif
 }
 
 STATUS instance_cnx_socket(instance *inst){
@@ -131,7 +131,7 @@ STATUS instance_slave_parse_prop_list(char *line, linkage **root, LINKAGETYPE ty
 		link->type = type;
 		link->next = 0;
 		
-		link->prop_size = property_minimum_buffersize(link->target.prop);
+		link->prop_size = linkage_buffersize(link->target.prop);
 		link->name_size = strlen(token)+1; // +1 since there was a comma or space trimmed off
 		link->size = link->name_size + link->prop_size;
 
@@ -233,6 +233,13 @@ STATUS instance_slave_link_properties(){
 		link->addr = local_inst.message->data_buffer + offset;
 		offset += link->prop_size;
 	}
+	// offer binary encodings, the master settles them before the first exchange
+	for(link = local_inst.write; link != 0; link = link->next){
+		linkage_offer(link);
+	}
+	for(link = local_inst.read; link != 0; link = link->next){
+		linkage_offer(link);
+	}
 	// compare pickles
 	if(0 != pickle_size){
 		if(pickle_size != local_inst.prop_size){
@@ -333,6 +340,24 @@ int instance_slave_wait_socket(){
 	return status;
 }
 
+int instance_slave_wait_shmem(){
+#ifndef WIN32
+	int rc = instance_shmem_wait(&local_inst.shmem->slave);
+	switch ( rc ) {
+		case 0:
+			IN_MYCONTEXT output_verbose("instance_slave_wait_shmem(): slave %d wait completed", slave_id);
+			return 1;
+		case ETIMEDOUT:
+			output_error("instance_slave_wait_shmem(): slave %d wait timeout", slave_id);
+			break;
+		default:
+			output_error("instance_slave_wait_shmem(): slave %d wait failed (%s)", slave_id, strerror(rc));
+			break;
+	}
+#endif
+	return 0;
+}
+
 /** instance_slave_wait
 	Place slave in wait state until master signal it to resume
 	@return 1 on success, 0 on failure.
@@ -350,7 +375,7 @@ int instance_slave_wait(void)
 	} else if(local_inst.cnxtype == CI_SOCKET){
 		status = instance_slave_wait_socket();
 	} else if(local_inst.cnxtype == CI_SHMEM){
-		; // linux-specific
+		status = instance_slave_wait_shmem();
 	}
 	/* signal main loop to resume with new timestamp */
 	return status;
@@ -410,6 +435,18 @@ int instance_slave_done_socket(){
 	return 0;
 }
 
+int instance_slave_done_shmem(){
+#ifndef WIN32
+	// links and next time are already in the shared cache
+	if ( sem_post(&local_inst.shmem->master)!=0 )
+	{
+		output_error("instance_slave_done_shmem(): slave %d unable to signal master (%s)", slave_id, strerror(errno));
+		return XC_PRCERR;
+	}
+#endif
+	return 0;
+}
+
 /** instance_slave_done
 	Signal the master that the slave is done.
  **/
@@ -426,6 +463,7 @@ void instance_slave_done(void)
 			rv = instance_slave_done_mmap();
 			break;
 		case CI_SHMEM:
+			rv = instance_slave_done_shmem();
 			break;
 		case CI_SOCKET:
 			rv = instance_slave_done_socket();
@@ -487,18 +525,22 @@ void *instance_slaveproc(void *ptr)
 		//IN_MYCONTEXT output_debug("slave %d controller resuming exec with %lli", slave_id, local_inst.cache->ts);
 		IN_MYCONTEXT output_debug("slave %d controller resuming exec with %lli", local_inst.cache->id, local_inst.cache->ts);
 		IN_MYCONTEXT output_debug("slave %d controller setting step_to %lli to cache->ts %lli", local_inst.cache->id, exec_sync_get(NULL), local_inst.cache->ts);
-		exec_sync_merge(NULL,(void*)&local_inst.cache);
+		exec_sync_set(NULL,local_inst.cache->ts,false);
+		if ( local_inst.cache->ts==TS_NEVER )
+			global_stoptime = global_clock; // the master is done, so the main loop must not wait for another step
 
+		// hold the lock from the signal to the wait so the main loop cannot pause in between
+		pthread_mutex_lock(&mls_inst_lock);
 		pthread_cond_broadcast(&mls_inst_signal);
 
 		if(local_inst.cache->ts == TS_NEVER){
+			pthread_mutex_unlock(&mls_inst_lock);
 			break;
 		}
 
 		/* wait for main loop to pause */
 		IN_MYCONTEXT output_verbose("slave %d controller waiting for main to complete", slave_id);
 
-		pthread_mutex_lock(&mls_inst_lock);
 		pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
 		pthread_mutex_unlock(&mls_inst_lock);
 
@@ -515,12 +557,20 @@ void *instance_slaveproc(void *ptr)
 
 		/* copy the next time stamp */
 		/* how about we copy the time we want to step to and see what the master says, instead? -MH */
-		exec_sync_reset((void*)&local_inst.cache);
-		exec_sync_set((void*)&local_inst.cache,0,false);
+		local_inst.cache->ts = exec_sync_get(NULL);
 
 		instance_slave_done();
 	} while (global_clock != TS_NEVER && rv == SUCCESS);
 	IN_MYCONTEXT output_verbose("slave %"FMT_INT64" completion state reached", local_inst.cacheid);
+#ifndef WIN32
+	// the controller is the only user of the shared cache, the master destroys it
+	if ( local_inst.cnxtype==CI_SHMEM )
+	{
+		local_inst.cache = NULL;
+		local_inst.buffer = NULL;
+		instance_shmem_release(&local_inst,0);
+	}
+#endif
 	pthread_exit(NULL);
 	return NULL;
 }
@@ -611,7 +661,58 @@ STATUS instance_slave_init_mem(){
 	}
 	return SUCCESS;
 #else
-	// @todo linux/unix slave signalling
+	char cacheName[64];
+	struct stat st;
+
+	IN_MYCONTEXT output_debug("instance_slave_init_mem()");
+	local_inst.cacheid = global_master_port;
+	sprintf(cacheName,SHMEM_NAME,global_master_port);
+	local_inst.fd = shm_open(cacheName,O_RDWR,0);
+	if ( local_inst.fd<0 )
+	{
+		output_error("unable to open cache '%s' for slave (%s)", cacheName, strerror(errno));
+		return FAILED;
+	}
+	if ( fstat(local_inst.fd,&st)!=0 || (size_t)st.st_size<sizeof(SHMEMHEADER)+sizeof(MESSAGE) )
+	{
+		output_error("cache '%s' for slave is not valid", cacheName);
+		close(local_inst.fd);
+		return FAILED;
+	}
+	local_inst.shmem = (SHMEMHEADER*)mmap(NULL,(size_t)st.st_size,PROT_READ|PROT_WRITE,MAP_SHARED,local_inst.fd,0);
+	close(local_inst.fd); // the mapping stays valid without the descriptor
+	local_inst.fd = -1;
+	if ( local_inst.shmem==MAP_FAILED )
+	{
+		local_inst.shmem = NULL;
+		output_error("unable to map cache '%s' for slave (%s)", cacheName, strerror(errno));
+		return FAILED;
+	}
+	local_inst.shmsize = (size_t)st.st_size;
+	if ( sizeof(SHMEMHEADER)+local_inst.shmem->cachesize!=(size_t)st.st_size )
+	{
+		output_error("cache '%s' for slave has size %d but header says %d", cacheName, (int)st.st_size, (int)(sizeof(SHMEMHEADER)+local_inst.shmem->cachesize));
+		instance_shmem_release(&local_inst,0);
+		return FAILED;
+	}
+	IN_MYCONTEXT output_debug("cache '%s' opened for slave", cacheName);
+
+	// the cache is used in place, links will point into the shared data buffer
+	local_inst.cache = SHMEM_CACHE(local_inst.shmem);
+	local_inst.buffer = (char*)local_inst.cache;
+	local_inst.buffer_size = local_inst.cachesize = local_inst.shmem->cachesize;
+	local_inst.id = slave_id = local_inst.cache->id;
+	if ( FAILED==messagewrapper_init(&(local_inst.message), local_inst.cache) )
+	{
+		local_inst.cache = NULL;
+		local_inst.buffer = NULL;
+		instance_shmem_release(&local_inst,0);
+		return FAILED;
+	}
+	local_inst.name_size = *(local_inst.message->name_size);
+	local_inst.prop_size = *(local_inst.message->data_size);
+	exec_sync_set(NULL,local_inst.cache->ts,false);
+	return SUCCESS;
 #endif
 }
 
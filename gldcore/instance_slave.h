@@ -11,7 +11,12 @@
 #define _WIN32_WINNT 0x0400
 #include <winsock2.h>
 #include <windows.h>
-
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
 #endif
 
 
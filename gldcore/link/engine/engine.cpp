@@ -58,6 +58,8 @@ EXPORT bool glx_create(glxlink *mod, CALLBACKS *fntable)
 
 	engine->recv_timeout = 100; // 10 seconds before recv gives up
 	engine->cachesize = 0; // automatic
+	engine->encoding = EE_TEXT;
+	engine->binary = false;
 	engine->send = NULL;
 	engine->recv = NULL;
 
@@ -100,6 +102,20 @@ EXPORT bool glx_settag(glxlink *mod, char *tag, char *data)
 			return true;
 		}
 	}
+	else if ( strcmp(tag,"encoding")==0 )
+	{
+		if ( strcmp(data,"text")==0 )
+			engine->encoding = EE_TEXT;
+		else if ( strcmp(data,"binary")==0 )
+			engine->encoding = EE_BINARY;
+		else
+		{
+			gl_error("invalid encoding value '%s'", data);
+			return false;
+		}
+		gl_debug("encoding set to %s", data);
+		return true;
+	}
 	gl_error("tag '%s' not valid for engine target", tag);
 	return false;
 }
@@ -144,7 +160,8 @@ bool recv_status(ENGINELINK *engine, ENGINELINKSTATUS *status, char *msg=NULL, i
 		gl_error("recv_status failed");
 		return false;
 	}
-	char *tag = strchr(buffer,' ');
+	char *tag = strpbrk(buffer," \n");
+	if ( tag!=NULL ) *tag = '\0';
 	if ( strcmp(buffer,"INIT")==0 ) 
 	{
 		if ( msg!=NULL && tag!=NULL && maxlen>1) strncpy(msg,tag+1,maxlen-1);
@@ -204,8 +221,9 @@ bool send_init(ENGINELINK *engine)
 
 bool send_protocol(ENGINELINK *engine)
 {
-        char buffer[1500];
-	int len=sprintf(buffer,"PROTOCOL %s", engine->protocol);
+	char buffer[1500];
+	// engines that do not know the encoding offer ignore it and reply with a plain OK
+	int len=sprintf(buffer,"PROTOCOL %s%s", engine->protocol, engine->encoding==EE_BINARY?" BINARY":"");
 	return engine_send(engine,buffer,len+1) > 0;
 }
 
@@ -278,8 +296,136 @@ bool send_time(ENGINELINK *engine,TIMESTAMP t0){
   return true;
 }
 
+/// size of the native value sent for a property in binary encoding (0 means text)
+static size_t engine_binary_size(gld_property *prop)
+{
+	switch ( prop->get_property()->ptype ) {
+	case PT_double: return sizeof(double);
+	case PT_complex: return 2*sizeof(double); // real and imaginary parts only
+	case PT_int16: return sizeof(int16);
+	case PT_int32: return sizeof(int32);
+	case PT_int64: return sizeof(int64);
+	case PT_float: return sizeof(float);
+	case PT_bool: return sizeof(bool);
+	default: return 0; // enumerations, sets, timestamps, etc. need the keywords
+	}
+}
+
+bool send_exports_binary(ENGINELINK *engine)
+{
+	char buffer[1499]; // engines terminate received messages at the last byte
+	ENGINEDATA *data = (ENGINEDATA*)buffer;
+	size_t len = sizeof(ENGINEDATA);
+	memcpy(data->tag,ENGINE_BINARY_TAG,sizeof(data->tag));
+	data->count = 0;
+	data->more = 0;
+	for ( SYNCDATA *item=engine->send ; item!=NULL ; item=item->next )
+	{
+		char value[1025];
+		unsigned short size = (unsigned short)engine_binary_size(item->prop);
+		unsigned short flag = 0;
+		if ( size>0 )
+			memcpy(value,item->prop->get_addr(),size);
+		else
+		{
+			int n = item->prop->to_string(value,sizeof(value));
+			size = n>0 ? (unsigned short)n : 0;
+			flag = ENGINE_TEXT_FLAG;
+		}
+
+		// only send changes
+		if ( item->last==NULL )
+			item->last = new char[sizeof(value)];
+		else if ( item->lastlen==(size|flag) && memcmp(item->last,value,size)==0 )
+			continue;
+		memcpy(item->last,value,size);
+		item->lastlen = size|flag;
+
+		// flush when the next record does not fit
+		size_t reclen = sizeof(unsigned int) + sizeof(unsigned short) + size;
+		if ( len+reclen>sizeof(buffer) )
+		{
+			data->more = 1;
+			if ( engine_send(engine,buffer,(int)len)<=0 )
+				return false;
+			data->count = 0;
+			data->more = 0;
+			len = sizeof(ENGINEDATA);
+		}
+		unsigned int index = item->index;
+		unsigned short length = size|flag;
+		memcpy(buffer+len,&index,sizeof(index)); len += sizeof(index);
+		memcpy(buffer+len,&length,sizeof(length)); len += sizeof(length);
+		memcpy(buffer+len,value,size); len += size;
+		data->count++;
+	}
+	return engine_send(engine,buffer,(int)len) > 0;
+}
+
+bool recv_imports_binary(ENGINELINK *engine)
+{
+	char buffer[1500];
+	ENGINEDATA *data = (ENGINEDATA*)buffer;
+	do {
+		int len = engine_recv(engine,buffer,sizeof(buffer));
+		if ( len<(int)sizeof(ENGINEDATA) || memcmp(data->tag,ENGINE_BINARY_TAG,sizeof(data->tag))!=0 )
+		{
+			gl_error("recv_imports did not receive a binary import message");
+			return false;
+		}
+		size_t pos = sizeof(ENGINEDATA);
+		for ( unsigned short n=0 ; n<data->count ; n++ )
+		{
+			unsigned int index;
+			unsigned short length, size;
+			if ( pos+sizeof(index)+sizeof(length)>(size_t)len )
+			{
+				gl_error("recv_imports binary message is truncated");
+				return false;
+			}
+			memcpy(&index,buffer+pos,sizeof(index)); pos += sizeof(index);
+			memcpy(&length,buffer+pos,sizeof(length)); pos += sizeof(length);
+			size = length&~ENGINE_TEXT_FLAG;
+			if ( pos+size>(size_t)len )
+			{
+				gl_error("recv_imports binary message is truncated");
+				return false;
+			}
+			char *value = buffer+pos;
+			pos += size;
+			if ( index>=sync_index_size || sync_index[index]==NULL )
+			{
+				gl_warning("recv_imports index value %d is invalid", index);
+				continue;
+			}
+			gld_property *prop = sync_index[index];
+			if ( length&ENGINE_TEXT_FLAG )
+			{
+				char text[1025];
+				if ( size>=sizeof(text) ) size = sizeof(text)-1;
+				memcpy(text,value,size);
+				text[size] = '\0';
+				if ( prop->from_string(text)<=0 )
+					gl_warning("unable to read import value '%s' for %s", text, prop->get_name());
+			}
+			else if ( size!=engine_binary_size(prop) )
+				gl_warning("import value for %s has %d bytes, expected %d", prop->get_name(), (int)size, (int)engine_binary_size(prop));
+			else if ( prop->get_object()!=NULL )
+			{
+				gld_wlock lock(prop->get_object());
+				memcpy(prop->get_addr(),value,size);
+			}
+			else
+				memcpy(prop->get_addr(),value,size);
+		}
+	} while ( data->more );
+	return true;
+}
+
 bool send_exports(ENGINELINK *engine)
 {
+	if ( engine->binary )
+		return send_exports_binary(engine);
 	char buffer[1500];
 	int len;
 	SYNCDATA *item;
@@ -294,6 +440,8 @@ bool send_exports(ENGINELINK *engine)
 
 bool recv_imports(ENGINELINK *engine)
 {
+	if ( engine->binary )
+		return recv_imports_binary(engine);
 	SYNCDATA *item;
 	for ( item=engine->recv ; item!=NULL ; item=item->next )
 	{
@@ -329,9 +477,21 @@ SYNCDATA *add_property(SYNCDATA *list, unsigned int index, gld_property *prop)
 	SYNCDATA *data = new SYNCDATA;
 	data->index = index;
 	data->prop = prop;
+	data->last = NULL;
+	data->lastlen = 0;
 	data->next = list;
 	return data;
 }
+void free_properties(SYNCDATA *list)
+{
+	while ( list!=NULL )
+	{
+		SYNCDATA *next = list->next;
+		delete [] list->last;
+		delete list;
+		list = next;
+	}
+}
 bool add_global(ENGINELINK *engine, unsigned int index, GLOBALVAR *var)
 {
 	gld_property *prop = new gld_property(var);
@@ -465,14 +625,16 @@ EXPORT bool glx_init(glxlink *mod)
 		return false;
 	}
 
-	// recent status message
-	char msg[1500];
+	// recent status message, the engine accepts the binary encoding with "OK BINARY"
+	char msg[1500] = "";
 	ENGINELINKSTATUS status;
 	if ( !recv_status(engine,&status,msg,sizeof(msg)) || status!=ELS_OK )
 	{
 		gl_error("engine link status not OK [%s]", msg);
 		return false;
 	}
+	engine->binary = ( engine->encoding==EE_BINARY && strcmp(msg,"BINARY")==0 );
+	gl_verbose("engine link uses %s encoding", engine->binary?"binary":"text");
 
 	// index send/recv lists
 	SYNCDATA *data;
@@ -529,14 +691,18 @@ EXPORT bool glx_term(glxlink* mod)
 {
 	ENGINELINK *engine = (ENGINELINK*)mod->get_data();
 
+	bool rv = true;
 	if ( !send_time(engine,TS_NEVER) )
-		return TS_NEVER;
-
-	if ( !send_exports(engine) )
-		return TS_INVALID; // error
-
-	if ( !send_status(engine,ELS_TERM) )
-		return TS_INVALID; // error
-
-	return true;
+		rv = TS_NEVER;
+	else if ( !send_exports(engine) )
+		rv = TS_INVALID; // error
+	else if ( !send_status(engine,ELS_TERM) )
+		rv = TS_INVALID; // error
+
+	// the lists share the properties, so only the items and last values are freed
+	free_properties(engine->send);
+	free_properties(engine->recv);
+	engine->send = engine->recv = NULL;
+
+	return rv;
 }
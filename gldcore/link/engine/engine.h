@@ -40,9 +40,30 @@ TCP code is not yet stable.
 typedef struct s_syncdata {
 	unsigned int index;
 	gld_property *prop;
+	char *last; ///< last value sent (binary encoding only)
+	unsigned short lastlen; ///< length of last value sent
 	struct s_syncdata *next;
 } SYNCDATA;
 
+/**
+Binary encoding.
+When the engine accepts the binary encoding offered in the PROTOCOL message,
+exports and imports are sent as one or more datagrams starting with this header
+followed by \p count records of (unsigned int index, unsigned short length, value).
+Numeric types carry the native value, all others carry the text value without a
+terminating null and set ENGINE_TEXT_FLAG in the length.  Only changed values are
+sent, and the last datagram of a set has \p more cleared.
+*/
+#define ENGINE_BINARY_TAG "GLDB"
+#define ENGINE_TEXT_FLAG 0x8000
+typedef struct s_enginedata {
+	char tag[4]; ///< ENGINE_BINARY_TAG
+	unsigned short count; ///< number of records in this datagram
+	unsigned short more; ///< nonzero if another datagram follows
+} ENGINEDATA;
+
+typedef enum {EE_TEXT=0, EE_BINARY=1} ENGINE_ENCODING;
+
 typedef enum {TCP=1, UDP} SOCKET_TYPE;
 
 typedef struct s_socket_data{
@@ -61,6 +82,8 @@ typedef struct s_enginelink {
 	char protocol[16];
 	unsigned int recv_timeout;
 	unsigned int cachesize;
+	ENGINE_ENCODING encoding; ///< encoding requested by the link file
+	bool binary; ///< binary encoding accepted by the engine
 	SYNCDATA *send;
 	SYNCDATA *recv;
 } ENGINELINK;
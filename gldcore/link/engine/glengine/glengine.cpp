@@ -54,6 +54,7 @@ void glengine::exception(const char *fmt, ...)
 glengine::glengine(void)
 {
 	debug_level = 0;
+	binary=false;
 	shut=false;
 	this->interface=NULL;
 }
@@ -253,19 +254,23 @@ void glengine::protocolConnect(){
 		  debug(2,"data spec [%s]", spec);
 	}
 
-	if ( send("OK")<=0 )
+	// accept the binary encoding if gridlabd offered it
+	if ( send(binary?"OK BINARY":"OK")<=0 )
 	{
 		exception("send status OK failed");
 	}
-	debug(1,"Connection established");
+	debug(1,"Connection established (%s encoding)", binary?"binary":"text");
 }
 
 bool glengine::recvProtocol(char *given){
 
+	char encoding[32]="";
 	if(recv(buffer,1500)<0)
 		return false;
-	if(sscanf(buffer,"PROTOCOL %s",given) !=1)
+	int n=sscanf(buffer,"PROTOCOL %31s %31s",given,encoding);
+	if(n<1)
 		return false;
+	binary=(n==2 && strcmp(encoding,"BINARY")==0);
 	return true;
 
 }
@@ -473,8 +478,11 @@ int glengine::sync_start(int64_t &syncCurrentTime)
   }
   debug(2,"Sync_start received time %ld",syncCurrentTime);
   
-  recv_exports();
-  debug(2,"Sync_start received exports",time);
+  if(binary)
+    recv_exports_binary();
+  else
+    recv_exports();
+  debug(2,"Sync_start received exports");
   //GET OK or TERM from server
  
   string syncState;
@@ -522,7 +530,10 @@ void glengine::sync_finalize(const int64_t syncto)
 	}
 	debug(1,"Sync sending imports");
 
-	send_imports();
+	if(binary)
+		send_imports_binary();
+	else
+		send_imports();
 
 	if(send("OK")<=0){
 	  exception("Sync send failed!");
@@ -574,3 +585,76 @@ void glengine::recv_exports()
   }
 }
 
+void glengine::recv_exports_binary()
+{
+  ENGINEDATA *data=(ENGINEDATA*)buffer;
+  do{
+    int len=recv(buffer,1500);
+    if(len<(int)sizeof(ENGINEDATA) || memcmp(data->tag,ENGINE_BINARY_TAG,sizeof(data->tag))!=0)
+      exception("Recv export error, expected binary export message");
+    size_t pos=sizeof(ENGINEDATA);
+    for(unsigned short n=0;n<data->count;n++){
+      unsigned int index;
+      unsigned short length,size;
+      if(pos+sizeof(index)+sizeof(length)>(size_t)len)
+        exception("Recv export error, message truncated");
+      memcpy(&index,buffer+pos,sizeof(index)); pos+=sizeof(index);
+      memcpy(&length,buffer+pos,sizeof(length)); pos+=sizeof(length);
+      size=length&~ENGINE_TEXT_FLAG;
+      if(pos+size>(size_t)len)
+        exception("Recv export error, message truncated");
+      map<int,glproperty*>::iterator it=this->exports_cache.find(index);
+      if(it==this->exports_cache.end())
+        exception("Index %d of export item is invalid",index);
+      if(length&ENGINE_TEXT_FLAG)
+        it->second->value=string(buffer+pos,size);
+      else if(size==it->second->binarySize())
+        it->second->fromBinary(buffer+pos);
+      else
+        exception("Export item %d has %d bytes, expected %d",index,size,(int)it->second->binarySize());
+      pos+=size;
+    }
+  }while(data->more);
+}
+
+void glengine::send_imports_binary()
+{
+  char message[1499]; // recv terminates messages at the last byte
+  ENGINEDATA *data=(ENGINEDATA*)message;
+  size_t len=sizeof(ENGINEDATA);
+  memcpy(data->tag,ENGINE_BINARY_TAG,sizeof(data->tag));
+  data->count=0;
+  data->more=0;
+  for(map<int,glproperty*>::iterator it=imports_cache.begin();it!=imports_cache.end();++it){
+    glproperty *prop=it->second;
+    if(prop->sent && prop->last==prop->value)
+      continue;
+    char value[1025];
+    unsigned short size=(unsigned short)prop->binarySize();
+    unsigned short flag=0;
+    if(size==0 || !prop->toBinary(value)){
+      size=(unsigned short)(prop->value.length()<sizeof(value) ? prop->value.length() : sizeof(value));
+      memcpy(value,prop->value.c_str(),size);
+      flag=ENGINE_TEXT_FLAG;
+    }
+    size_t reclen=sizeof(unsigned int)+sizeof(unsigned short)+size;
+    if(len+reclen>sizeof(message)){
+      data->more=1;
+      if(interface->send(message,(int)len)<0)
+        exception("send of imports failed!");
+      data->count=0;
+      data->more=0;
+      len=sizeof(ENGINEDATA);
+    }
+    unsigned int index=prop->index;
+    unsigned short length=size|flag;
+    memcpy(message+len,&index,sizeof(index)); len+=sizeof(index);
+    memcpy(message+len,&length,sizeof(length)); len+=sizeof(length);
+    memcpy(message+len,value,size); len+=size;
+    data->count++;
+    prop->last=prop->value;
+    prop->sent=true;
+  }
+  if(interface->send(message,(int)len)<0)
+    exception("send of imports failed!");
+}
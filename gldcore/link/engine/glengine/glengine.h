@@ -51,6 +51,15 @@
 #include "glproperty.h"
 #include "absconnection.h"
 
+/// binary encoding datagram header, must match ENGINEDATA in gldcore/link/engine/engine.h
+#define ENGINE_BINARY_TAG "GLDB"
+#define ENGINE_TEXT_FLAG 0x8000
+typedef struct s_enginedata {
+	char tag[4];
+	unsigned short count;
+	unsigned short more;
+} ENGINEDATA;
+
 
 class glengine {
 
@@ -84,6 +93,7 @@ private:
 	char branch[32];
 	char protocol[32];
 	int cachesize,timeout;
+	bool binary; ///< gridlabd offered the binary encoding and it was accepted
 	char buffer[1500];
 	void protocolConnect();
 public:
@@ -162,9 +172,11 @@ private:
 	bool recv_gldversion();
 	///recv exports_cache
 	void recv_exports();
+	void recv_exports_binary();
 	
 	///send imports_cache
 	void send_imports();
+	void send_imports_binary();
 };
 
 #endif
@@ -30,6 +30,8 @@
 
 #include <sstream>
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 glproperty::glproperty(PROPOERTYCONTEXT context, PROPERTYTYPE type,int index, string name, size_t size, string value)
 {
@@ -40,6 +42,7 @@ glproperty::glproperty(PROPOERTYCONTEXT context, PROPERTYTYPE type,int index, st
   //TODO string to value conversions
   this->value=value;
   this->index=index;
+  this->sent=false;
 }
 
 glproperty* glproperty::deserialize(char* given)
@@ -127,6 +130,69 @@ string glproperty::getValue()
   return this->value;
 }
 
+size_t glproperty::binarySize() const
+{
+  switch(type){
+    case PT_double: return sizeof(double);
+    case PT_complex: return 2*sizeof(double);
+    case PT_int16: return sizeof(short);
+    case PT_int32: return sizeof(int);
+    case PT_int64: return sizeof(long long);
+    case PT_float: return sizeof(float);
+    case PT_bool: return sizeof(bool);
+    default: return 0;
+  }
+}
+
+bool glproperty::toBinary(char *buffer) const
+{
+  const char *str=value.c_str();
+  char *end=NULL;
+  switch(type){
+    case PT_double: { double x=strtod(str,&end); memcpy(buffer,&x,sizeof(x)); break; }
+    case PT_float: { float x=(float)strtod(str,&end); memcpy(buffer,&x,sizeof(x)); break; }
+    case PT_complex: {
+      double x[2];
+      if(sscanf(str,"%lg%lg",&x[0],&x[1])!=2)
+        return false;
+      memcpy(buffer,x,sizeof(x));
+      return true;
+    }
+    case PT_int16: { short x=(short)strtol(str,&end,10); memcpy(buffer,&x,sizeof(x)); break; }
+    case PT_int32: { int x=(int)strtol(str,&end,10); memcpy(buffer,&x,sizeof(x)); break; }
+    case PT_int64: { long long x=strtoll(str,&end,10); memcpy(buffer,&x,sizeof(x)); break; }
+    case PT_bool: {
+      bool x;
+      if(value=="TRUE" || value=="true" || value=="1")
+        x=true;
+      else if(value=="FALSE" || value=="false" || value=="0")
+        x=false;
+      else
+        return false;
+      memcpy(buffer,&x,sizeof(x));
+      return true;
+    }
+    default: return false;
+  }
+  return end!=str;
+}
+
+void glproperty::fromBinary(const char *buffer)
+{
+  char str[64];
+  switch(type){
+    case PT_double: { double x; memcpy(&x,buffer,sizeof(x)); sprintf(str,"%.17g",x); break; }
+    case PT_float: { float x; memcpy(&x,buffer,sizeof(x)); sprintf(str,"%.9g",x); break; }
+    case PT_complex: { double x[2]; memcpy(x,buffer,sizeof(x)); sprintf(str,"%+.17g%+.17gj",x[0],x[1]); break; }
+    case PT_int16: { short x; memcpy(&x,buffer,sizeof(x)); sprintf(str,"%d",x); break; }
+    case PT_int32: { int x; memcpy(&x,buffer,sizeof(x)); sprintf(str,"%d",x); break; }
+    case PT_int64: { long long x; memcpy(&x,buffer,sizeof(x)); sprintf(str,"%lld",x); break; }
+    case PT_bool: { bool x; memcpy(&x,buffer,sizeof(x)); strcpy(str,x?"TRUE":"FALSE"); break; }
+    default: return;
+  }
+  value=str;
+}
+
 
 
 
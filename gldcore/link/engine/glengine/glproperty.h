@@ -79,11 +79,17 @@ class glproperty
     string name,value;
     size_t size;
     int index;
+    string last; ///< last value sent in binary encoding
+    bool sent; ///< whether a value was sent in binary encoding yet
   public:
     glproperty(PROPOERTYCONTEXT context,PROPERTYTYPE type,int index,string name,size_t size,string value);
     string getName();
     string getValue();
     PROPERTYTYPE getType();
+    /// binary encoding of the value (size 0 means the value is sent as text)
+    size_t binarySize() const;
+    bool toBinary(char *buffer) const;
+    void fromBinary(const char *buffer);
     static glproperty* deserialize(char *given);
     static char* serialize(glproperty *given);
 };
@@ -5,6 +5,8 @@
 #include "output.h"
 #include "object.h"
 #include "property.h"
+#include "class.h"
+#include "globals.h"
 
 SET_MYCONTEXT(DMC_INSTANCE)
 
@@ -82,16 +84,151 @@ int linkage_create_reader(instance *inst, char *fromobj, char *fromvar, char *to
 	}
 }
 
+/** linkage_binary_type
+	Determine whether a linked property can be carried in native binary form.
+	Properties with units always go as text so the receiver can convert them.
+	@returns the property type if it can, PT_void if not
+ **/
+static int16 linkage_binary_type(PROPERTY *prop)
+{
+	if ( prop->unit!=NULL )
+		return PT_void;
+	switch ( prop->ptype ) {
+	case PT_double:
+	case PT_complex:
+	case PT_int16:
+	case PT_int32:
+	case PT_int64:
+	case PT_bool:
+	case PT_timestamp:
+	case PT_float:
+		return (int16)prop->ptype;
+	default:
+		return PT_void;
+	}
+}
+
+/** linkage_buffersize
+	Calculate the size of the message data slot needed for a linked property.
+	@returns the slot size in bytes, including the slot header
+ **/
+size_t linkage_buffersize(PROPERTY *prop)
+{
+	return sizeof(LINKAGEHEADER) + property_minimum_buffersize(prop);
+}
+
+/** linkage_offer
+	Slave side of the encoding negotiation.  Marks the slot with the binary
+	type the slave can accept for this link.
+ **/
+void linkage_offer(linkage *lnk)
+{
+	LINKAGEHEADER *hdr = (LINKAGEHEADER*)lnk->addr;
+	hdr->type = linkage_binary_type(lnk->target.prop);
+	hdr->reserved = 0;
+	hdr->seq = 0;
+}
+
+/** linkage_negotiate
+	Master side of the encoding negotiation.  Keeps the slave's binary offer
+	only if the master's property has exactly the same binary type, otherwise
+	the link falls back to text.
+ **/
+void linkage_negotiate(linkage *lnk)
+{
+	LINKAGEHEADER *hdr = (LINKAGEHEADER*)lnk->addr;
+	if ( hdr->type!=PT_void && hdr->type!=linkage_binary_type(lnk->target.prop) )
+		hdr->type = PT_void;
+	IN_MYCONTEXT output_verbose("linkage %s:%s uses %s encoding", lnk->local.obj, lnk->local.prop, hdr->type==PT_void?"text":"binary");
+}
+
+/** linkage_write
+	Copy the local property value into the linkage slot if it changed.
+	@returns SUCCESS or FAILED
+ **/
+static STATUS linkage_write(linkage *lnk)
+{
+	LINKAGEHEADER *hdr = (LINKAGEHEADER*)lnk->addr;
+	char *data = lnk->addr + sizeof(LINKAGEHEADER);
+	void *addr = GETADDR(lnk->target.obj,lnk->target.prop);
+	if ( hdr->type!=PT_void && hdr->type==linkage_binary_type(lnk->target.prop) )
+	{
+		size_t len = property_getspec(lnk->target.prop->ptype)->size;
+		if ( lnk->seq!=0 && memcmp(data,addr,len)==0 )
+			return SUCCESS;
+		memcpy(data,addr,len);
+	}
+	else
+	{
+		char value[1025];
+		int size = (int)(lnk->prop_size - sizeof(LINKAGEHEADER));
+		if ( size>(int)sizeof(value) ) size = sizeof(value);
+		if ( object_get_value_by_addr(lnk->target.obj, addr, value, size, lnk->target.prop)==0 )
+			return FAILED;
+		if ( lnk->seq!=0 && strcmp(data,value)==0 )
+			return SUCCESS;
+		strcpy(data,value);
+	}
+	if ( ++hdr->seq==0 ) hdr->seq = 1;
+	lnk->seq = hdr->seq;
+	IN_MYCONTEXT output_debug("linkage %s:%s wrote update %u", lnk->target.obj->name, lnk->target.prop->name, lnk->seq);
+	return SUCCESS;
+}
+
+/** linkage_read
+	Copy the linkage slot into the local property if the writer changed it.
+	@returns SUCCESS or FAILED
+ **/
+static STATUS linkage_read(linkage *lnk)
+{
+	LINKAGEHEADER *hdr = (LINKAGEHEADER*)lnk->addr;
+	char *data = lnk->addr + sizeof(LINKAGEHEADER);
+	OBJECT *obj = lnk->target.obj;
+	PROPERTY *prop = lnk->target.prop;
+	void *addr = GETADDR(obj,prop);
+
+	if ( hdr->seq==lnk->seq )
+		return SUCCESS;
+	if ( hdr->type!=PT_void && hdr->type==linkage_binary_type(prop) )
+	{
+		if ( prop->notify!=NULL || obj->oclass->notify!=NULL )
+		{
+			/* notifiers expect the text value */
+			char value[1025];
+			if ( class_property_to_string(prop,data,value,sizeof(value))==0
+				|| object_set_value_by_addr(obj,addr,value,prop)==0 )
+				return FAILED;
+		}
+		else if ( prop->access!=PA_PUBLIC && !global_permissive_access )
+		{
+			output_error("trying to set the value of non-public property %s in %s", prop->name, obj->oclass->name);
+			return FAILED;
+		}
+		else
+		{
+			if ( prop->flags&PF_RECALC ) obj->flags |= OF_RECALC;
+			memcpy(addr,data,property_getspec(prop->ptype)->size);
+		}
+	}
+	else if ( hdr->type!=PT_void )
+	{
+		output_error("linkage %s.%s received binary type %d that was not negotiated", obj->name, prop->name, hdr->type);
+		return FAILED;
+	}
+	else if ( object_set_value_by_addr(obj, addr, data, prop)==0 )
+		return FAILED;
+	lnk->seq = hdr->seq;
+	IN_MYCONTEXT output_debug("linkage %s:%s read update %u", obj->name, prop->name, lnk->seq);
+	return SUCCESS;
+}
+
 /** linkage_master_to_slave
     Updates the instance cache for a master->slave linkage.
 	@returns 1 on success, 0 on failure
  **/
 STATUS linkage_master_to_slave(char *buffer, linkage *lnk)
 {
-	int rv = 0;
-	int size = 0;
-
-	//IN_MYCONTEXT output_debug("linkage_master_to_slave");
+	STATUS rv = FAILED;
 
 	// null checks
 	if(0 == lnk){
@@ -102,24 +239,19 @@ STATUS linkage_master_to_slave(char *buffer, linkage *lnk)
 		output_error("linkage_master_to_slave has null lnk->target.obj pointer");
 		return FAILED;
 	}
-	size = (int)property_minimum_buffersize(lnk->target.prop);
 	switch ( global_multirun_mode ) {
 		case MRM_MASTER:
-//			rv = class_property_to_string(lnk->target.prop,GETADDR(lnk->target.obj,lnk->target.prop),(char *)((int64)lnk->addr),size);
-			rv = object_get_value_by_addr(lnk->target.obj, GETADDR(lnk->target.obj,lnk->target.prop), (char*)((int64)lnk->addr), size, lnk->target.prop);
-			IN_MYCONTEXT output_debug("prop %s, addr %x, addr2 %x, val %s", lnk->target.prop->name, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->addr);
+			rv = linkage_write(lnk);
 			break;
 		case MRM_SLAVE:
-//			rv = class_string_to_property(lnk->target.prop,GETADDR(lnk->target.obj,lnk->target.prop),(char *)((int64)lnk->addr));
-			rv = object_set_value_by_addr(lnk->target.obj, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->target.prop);
-			IN_MYCONTEXT output_debug("prop %s, addr %x, addr2 %x, val %s", lnk->target.prop->name, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->addr);
+			rv = linkage_read(lnk);
 			break;
 		default:
 			break;
 	}
-	if(0 == rv){
+	if(FAILED == rv){
 		output_error("linkage_master_to_slave failed for link %s.%s", lnk->target.obj->name, lnk->target.prop->name);
-		IN_MYCONTEXT output_debug("str=%8s", (char *)((int64)lnk->addr));
+		IN_MYCONTEXT output_debug("str=%8s", lnk->addr+sizeof(LINKAGEHEADER));
 		return FAILED;
 	}
 	return SUCCESS;
@@ -131,36 +263,31 @@ STATUS linkage_master_to_slave(char *buffer, linkage *lnk)
  **/
 STATUS linkage_slave_to_master(char *buffer, linkage *lnk)
 {
-	int rv = 0;
-	int size = (int)property_minimum_buffersize(lnk->target.prop);
+	STATUS rv = FAILED;
 
 	// null checks
 	if(0 == lnk){
-		output_error("linkage_master_to_slave has null lnk pointer");
+		output_error("linkage_slave_to_master has null lnk pointer");
 		return FAILED;
 	}
 	if(0 == lnk->target.obj){
-		output_error("linkage_master_to_slave has null lnk->target.obj pointer");
+		output_error("linkage_slave_to_master has null lnk->target.obj pointer");
 		return FAILED;
 	}
 
 	switch ( global_multirun_mode ) {
 	case MRM_MASTER:
-//		rv = class_string_to_property(lnk->target.prop,GETADDR(lnk->target.obj,lnk->target.prop),(char *)((int64)lnk->addr));
-		rv = object_set_value_by_addr(lnk->target.obj, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->target.prop);
-		IN_MYCONTEXT output_debug("prop %s, addr %x, addr2 %x, val %s", lnk->target.prop->name, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->addr);
+		rv = linkage_read(lnk);
 		break;
 	case MRM_SLAVE:
-//		rv = class_property_to_string(lnk->target.prop,GETADDR(lnk->target.obj,lnk->target.prop),(char *)((int64)lnk->addr),size);
-		rv = object_get_value_by_addr(lnk->target.obj, GETADDR(lnk->target.obj,lnk->target.prop), (char*)((int64)lnk->addr), size, lnk->target.prop);
-		IN_MYCONTEXT output_debug("prop %s, addr %x, addr2 %x, val %s", lnk->target.prop->name, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->addr);
+		rv = linkage_write(lnk);
 		break;
 	default:
 		break;
 	}
-	if(0 == rv){
+	if(FAILED == rv){
 		output_error("linkage_slave_to_master failed for link %s.%s", lnk->target.obj->name, lnk->target.prop->name);
-		IN_MYCONTEXT output_debug("str=%8s", (char *)((int64)lnk->addr));
+		IN_MYCONTEXT output_debug("str=%8s", lnk->addr+sizeof(LINKAGEHEADER));
 		return FAILED;
 	}
 	return SUCCESS;
@@ -189,7 +316,7 @@ STATUS linkage_init(instance *inst, linkage *lnk)
 	}
 
 	/* calculate buffer size */
-	lnk->prop_size = property_minimum_buffersize(lnk->target.prop);
+	lnk->prop_size = linkage_buffersize(lnk->target.prop);
 	lnk->name_size = strlen(lnk->remote.obj) + strlen(lnk->remote.prop) + 2;
 	lnk->size = lnk->name_size + lnk->prop_size;
 
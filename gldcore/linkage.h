@@ -13,6 +13,20 @@ typedef enum {
 	LT_MASTERTOSLAVE = 1,	 ///<
 	LT_SLAVETOMASTER = 2,	 ///<
 } LINKAGETYPE;
+
+/** linkage data slot header
+	Every linkage slot in the message data buffer starts with this header.  The
+	type is PT_void when the value is carried as text, or the property type when
+	both sides agreed at init to exchange it in native binary form.  The writer
+	only rewrites the slot when the value changes, and bumps the sequence number
+	when it does so the reader can skip unchanged values.
+ **/
+typedef struct s_linkage_header {
+	int16 type;		///< negotiated encoding (PT_void for text)
+	int16 reserved;	///< padding, always 0
+	uint32 seq;		///< change count written by the sending side
+} LINKAGEHEADER;
+
 typedef struct s_linkage {
 	LINKAGETYPE type; ///<
 	struct {
@@ -28,6 +42,7 @@ typedef struct s_linkage {
 	size_t size;	 ///< buffer size in MESSAGE
 	size_t name_size;
 	size_t prop_size;
+	uint32 seq;		///< last sequence number written or read on this side
 	struct s_linkage *next; ///<
 } linkage; ///<
 
@@ -38,6 +38,7 @@
 #include "exception.h"
 #include "convert.h"
 #include "globals.h"
+#include "eventqueue.h"
 #include "random.h"
 #include "schedule.h"
 #include "exec.h"
@@ -46,6 +47,8 @@ SET_MYCONTEXT(DMC_LOADSHAPE)
 
 static loadshape *loadshape_list = NULL;
 static unsigned int n_shapes = 0;
+static unsigned int n_seeded = 0; /* number of loadshape random streams seeded */
+RANDOMSTATE_LAYOUT(loadshape,rng_state,rng_check,rng_stream);
 
 static void sync_analog(loadshape *ls, double dt)
 {
@@ -736,7 +739,7 @@ int loadshape_init(loadshape *ls) /**< load shape */
 	}
 	
 	/* initialize the random number generator state */
-	ls->rng_state = randwarn(NULL);
+	random_stream(&ls->rng_state,RS_LOADSHAPE,n_seeded++);
 
 	/* establish the initial parameters */
 	loadshape_recalc(ls);
@@ -871,9 +874,6 @@ typedef struct s_loadshapesyncdata {
 	unsigned int n;
 	pthread_t pt;
 	bool ok;
-	loadshape *ls;
-	unsigned int ns;
-	TIMESTAMP t0;
 	unsigned int ran;
 } LOADSHAPESYNCDATA;
 
@@ -881,18 +881,32 @@ static pthread_cond_t start_ls = PTHREAD_COND_INITIALIZER;
 static pthread_mutex_t startlock_ls = PTHREAD_MUTEX_INITIALIZER;
 static pthread_cond_t done_ls = PTHREAD_COND_INITIALIZER;
 static pthread_mutex_t donelock_ls = PTHREAD_MUTEX_INITIALIZER;
-static TIMESTAMP next_t1_ls, next_t2_ls;
+static TIMESTAMP next_t1_ls;
 static unsigned int run = 0;
 static unsigned int donecount_ls;
+static unsigned int n_threads_ls = 0;
+
+/* Loadshapes are kept in an event queue by the time of their next update, which is
+   the sooner of their own next state change and the next change of their schedule,
+   so that only the loadshapes whose update has come are synced.  Loadshapes driven by
+   interpolated schedules follow their schedule between its changes, and the pulse timing
+   of pulsed, modulated and queued loadshapes is recomputed from the time of each sync, so
+   these are not queued and are synced whenever any loadshape is. */
+static EVENTQUEUE *loadshape_queue = NULL;
+static loadshape **loadshape_due = NULL; /* loadshapes synced by the current pass */
+static TIMESTAMP *loadshape_next = NULL; /* next update reported by each synced loadshape */
+static unsigned int n_due_ls = 0;
+static loadshape **loadshape_always = NULL;
+static TIMESTAMP *loadshape_always_next = NULL;
+static unsigned int n_always_ls = 0;
+static unsigned int n_queued_ls = 0; /* number of loadshapes when the queue was built */
 
 clock_t loadshape_synctime = 0;
 
 void *loadshape_syncproc(void *ptr)
 {
 	LOADSHAPESYNCDATA *data = (LOADSHAPESYNCDATA*)ptr;
-	loadshape *s;
 	unsigned int n;
-	TIMESTAMP t2;
 
 	// begin processing loop
 	while ( data->ok )
@@ -901,31 +915,24 @@ void *loadshape_syncproc(void *ptr)
 		pthread_mutex_lock(&startlock_ls);
 
 		// wait for thread start condition
-		while ( data->t0==next_t1_ls && data->ran==run ) 
+		while ( data->ran==run ) 
 			pthread_cond_wait(&start_ls,&startlock_ls);
 		
 		// unlock access to start count
 		pthread_mutex_unlock(&startlock_ls);
 
-		// process the list for this thread
-		t2 = TS_NEVER;
-		for ( s=data->ls, n=0 ; s!=NULL, n<data->ns ; s=s->next, n++ )
-		{
-			TIMESTAMP t = loadshape_sync(s,next_t1_ls);
-			if (t<t2) t2 = t;
-		}
+		// process the due shapes assigned to this thread
+		for ( n=data->n ; n<n_due_ls ; n+=n_threads_ls )
+			loadshape_next[n] = loadshape_sync(loadshape_due[n],next_t1_ls);
 
 		// signal completed condition
-		data->t0 = next_t1_ls;
-		data->ran++;
+		data->ran = run;
 
 		// lock access to done condition
 		pthread_mutex_lock(&donelock_ls);
 
 		// signal thread is done for now
 		donecount_ls--;
-		///printf("action: donecount_ls-- = %d\n", donecount_ls);
-		if ( t2<next_t2_ls ) next_t2_ls = t2;
 
 		// signal change in done condition
 		pthread_cond_broadcast(&done_ls);
@@ -936,12 +943,68 @@ void *loadshape_syncproc(void *ptr)
 	pthread_exit((void*)0);
 	return (void*)0;
 }
+
+/* queue a shape at the time of its next update */
+static void loadshape_enqueue(loadshape *ls, TIMESTAMP t2)
+{
+	if ( ls->schedule!=NULL && ls->schedule->next_t<t2 )
+		t2 = ls->schedule->next_t;
+	if ( t2!=TS_NEVER && !eventqueue_push(loadshape_queue,t2,ls) )
+		throw_exception("loadshape_syncall(): unable to allocate the loadshape event queue");
+		/* TROUBLESHOOT
+			There was not enough memory to queue the loadshapes by the time of their next update.
+			Try freeing up system memory and try again.
+		 */
+}
+
+/* queue all the shapes for an update now */
+static void loadshape_queue_build(void)
+{
+	loadshape *s;
+	if ( loadshape_queue==NULL )
+		loadshape_queue = eventqueue_create();
+	loadshape_due = (loadshape**)realloc(loadshape_due,sizeof(loadshape*)*n_shapes);
+	loadshape_next = (TIMESTAMP*)realloc(loadshape_next,sizeof(TIMESTAMP)*n_shapes);
+	loadshape_always = (loadshape**)realloc(loadshape_always,sizeof(loadshape*)*n_shapes);
+	loadshape_always_next = (TIMESTAMP*)realloc(loadshape_always_next,sizeof(TIMESTAMP)*n_shapes);
+	if ( loadshape_queue==NULL || loadshape_due==NULL || loadshape_next==NULL || loadshape_always==NULL || loadshape_always_next==NULL )
+		throw_exception("loadshape_syncall(): unable to allocate the loadshape event queue");
+	eventqueue_clear(loadshape_queue);
+	n_always_ls = 0;
+	for ( s=loadshape_list ; s!=NULL ; s=s->next )
+	{
+		if ( (s->schedule!=NULL && (s->schedule->flags&SN_INTERPOLATED)==SN_INTERPOLATED)
+			|| s->type==MT_PULSED || s->type==MT_MODULATED || s->type==MT_QUEUED )
+		{
+			loadshape_always[n_always_ls] = s;
+			loadshape_always_next[n_always_ls++] = TS_ZERO;
+		}
+		else
+			loadshape_enqueue(s,TS_ZERO);
+	}
+	n_queued_ls = n_shapes;
+}
+
+/* the time of the next update of any loadshape */
+static TIMESTAMP loadshape_nextall(void)
+{
+	TIMESTAMP t2 = eventqueue_next(loadshape_queue);
+	unsigned int n;
+	for ( n=0 ; n<n_always_ls ; n++ )
+	{
+		if ( loadshape_always_next[n]<t2 )
+			t2 = loadshape_always_next[n];
+	}
+	return t2;
+}
+
 TIMESTAMP loadshape_syncall(TIMESTAMP t1)
 {
-	static unsigned int n_threads_ls=0;
 	static LOADSHAPESYNCDATA *thread_ls = NULL;
-	TIMESTAMP t2 = TS_NEVER;
 	clock_t ts = (clock_t)exec_clock();
+	TIMESTAMP t2;
+	loadshape *s;
+	unsigned int n;
 
 	// skip loadshape_syncall if there's no loadshape in the glm
 	if (n_shapes == 0)
@@ -950,16 +1013,12 @@ TIMESTAMP loadshape_syncall(TIMESTAMP t1)
 	// number of threads desired
 	if (n_threads_ls==0) 
 	{
-		loadshape *s;
-		int n_items, ln=0;
-
 		IN_MYCONTEXT output_debug("loadshape_syncall setting up for %d shapes", n_shapes);
 
 		// determine needed threads
 		n_threads_ls = global_threadcount;
 		if (n_threads_ls>1)
 		{
-			unsigned int n;
 			if (n_shapes<n_threads_ls*4)
 				n_threads_ls = n_shapes/4;
 
@@ -967,59 +1026,47 @@ TIMESTAMP loadshape_syncall(TIMESTAMP t1)
 			if (n_threads_ls == 0)
 				n_threads_ls = 1;
 
-			// determine shapes per thread
-			n_items = n_shapes/n_threads_ls;
-			n_threads_ls = n_shapes/n_items;
-			if (n_threads_ls*n_items<n_shapes) // not enough slots yet
-				n_threads_ls++; // add one underused threads
-
 			IN_MYCONTEXT output_debug("loadshape_syncall is using %d of %d available threads", n_threads_ls, global_threadcount);
-			IN_MYCONTEXT output_debug("loadshape_syncall is assigning %d shapes per thread", n_items);
 
 			// allocate thread list
 			thread_ls = (LOADSHAPESYNCDATA*)malloc(sizeof(LOADSHAPESYNCDATA)*n_threads_ls);
 			memset(thread_ls,0,sizeof(LOADSHAPESYNCDATA)*n_threads_ls);
 
-			// assign starting shape for each thread
-			for (s=loadshape_list; s!=NULL; s=s->next)
-			{
-				if (thread_ls[ln].ns==n_items)
-					ln++;
-				if (thread_ls[ln].ns==0)
-					thread_ls[ln].ls = s;
-				thread_ls[ln].ns++;
-			}
-
 			// create threads
 			for (n=0; n<n_threads_ls; n++)
 			{
 				thread_ls[n].ok = true;
+				thread_ls[n].n = n;
 				if ( pthread_create(&(thread_ls[n].pt),NULL,loadshape_syncproc,&(thread_ls[n]))!=0 )
 				{
 					output_fatal("loadshape_sync thread creation failed");
 					thread_ls[n].ok = false;
 				}
-				else
-					thread_ls[n].n = n;
 			}
 		}
 	}
 
-	// don't update if next_t2 < next_t1
-	if ( next_t2_ls>t1 && next_t2_ls<TS_NEVER )
-		return next_t2_ls;
+	// queue the shapes when they are first synced or when new ones have been added
+	if (n_queued_ls != n_shapes)
+		loadshape_queue_build();
+
+	// don't update if no shape is due yet
+	t2 = loadshape_nextall();
+	if (t2>t1)
+		return t2;
+
+	// collect the shapes synced on every pass and the shapes whose update has come
+	for (n_due_ls=0; n_due_ls<n_always_ls; n_due_ls++)
+		loadshape_due[n_due_ls] = loadshape_always[n_due_ls];
+	while ((s=(loadshape*)eventqueue_pop(loadshape_queue,t1))!=NULL)
+		loadshape_due[n_due_ls++] = s;
 
 	// no threading required
-	if (n_threads_ls<2) 
+	if (n_threads_ls<2 || n_due_ls<n_threads_ls*4) 
 	{
 		// process list directly
-		loadshape *s;
-		for (s=loadshape_list; s!=NULL; s=s->next)
-		{
-			TIMESTAMP t3 = loadshape_sync(s,t1);
-			if (t3<t2) t2 = t3;
-		}
-		next_t2_ls = t2;
+		for (n=0; n<n_due_ls; n++)
+			loadshape_next[n] = loadshape_sync(loadshape_due[n],t1);
 	}
 	else
 	{
@@ -1034,7 +1081,6 @@ TIMESTAMP loadshape_syncall(TIMESTAMP t1)
 
 		// update start condition
 		next_t1_ls = t1;
-		next_t2_ls = TS_NEVER;
 		run++;
 
 		// signal all the threads
@@ -1044,22 +1090,25 @@ TIMESTAMP loadshape_syncall(TIMESTAMP t1)
 		pthread_mutex_unlock(&startlock_ls);
 
 		// begin wait
-		while (donecount_ls>0) {
-			///printf("status: donecount_ls-- = %d\n", donecount_ls);
-			///printf("thread_ls.ok=%d\n",thread_ls->ok);
+		while (donecount_ls>0)
 			pthread_cond_wait(&done_ls,&donelock_ls);
-		}
 		IN_MYCONTEXT output_debug("passed donecount==0 condition");
 
 		// unlock done count
 		pthread_mutex_unlock(&donelock_ls);
+	}
 
-		// process results from all threads
-		if (next_t2_ls<t2) t2=next_t2_ls;
+	// requeue the synced shapes
+	for (n=0; n<n_due_ls; n++)
+	{
+		if (n<n_always_ls)
+			loadshape_always_next[n] = loadshape_next[n];
+		else
+			loadshape_enqueue(loadshape_due[n],loadshape_next[n]);
 	}
 
 	loadshape_synctime += exec_clock() - ts;
-	return t2;
+	return loadshape_nextall();
 }
 
 int convert_from_loadshape(char *string,int size,void *data, PROPERTY *prop)
@@ -94,6 +94,8 @@ struct s_loadshape {
 	TIMESTAMP t0;	/**< time of last update (in seconds since epoch) */
 	TIMESTAMP t2;	/**< time of next update (in seconds since epoch) */
 	unsigned int rng_state; /**< state of the random number generator */
+	unsigned int rng_check; /**< RNG4 stream check (see #RANDOMSTATE) */
+	unsigned int64 rng_stream; /**< RNG4 stream of the state (see #RANDOMSTATE) */
 
 	struct s_loadshape *next;	/* next loadshape in list */
 };
@@ -219,6 +219,9 @@ int main(int argc, /**< the number entries on command-line argument list \p argv
 		module_profiles();
 	}
 
+	/* release the class property indexes */
+	class_free_property_indexes();
+
 #ifdef DUMP_SCHEDULES
 	/* dump a copy of the schedules for reference */
 	schedule_dumpall("schedules.txt");
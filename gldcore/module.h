@@ -30,6 +30,7 @@ struct s_module_list {
 	unsigned long (*preupdate)(void*,int64,unsigned int64);
 	SIMULATIONMODE (*interupdate)(void*,int64,unsigned int64,unsigned long,unsigned int);
 	SIMULATIONMODE (*deltaClockUpdate)(void *, double, unsigned long, SIMULATIONMODE);
+	double (*deltaerror)(void*,unsigned long);
 	STATUS (*postupdate)(void*,int64,unsigned int64);
 	/* clock hook*/
 	TIMESTAMP (*clockupdate)(TIMESTAMP *);
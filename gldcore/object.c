@@ -45,6 +45,8 @@
 
 SET_MYCONTEXT(DMC_OBJECT)
 
+RANDOMSTATE_LAYOUT(OBJECT,rng_state,rng_check,rng_stream);
+
 /* object list */
 static OBJECTNUM next_object_id = 0;
 static OBJECTNUM deleted_object_count = 0;
@@ -349,7 +351,7 @@ OBJECT *object_create_single(CLASS *oclass){ /**< the class of the object */
 	obj->out_svc_double = (double)obj->out_svc;
 	obj->space = object_current_namespace();
 	obj->flags = OF_NONE;
-	obj->rng_state = randwarn(NULL);
+	random_stream(&obj->rng_state,RS_OBJECT,obj->id);
 	obj->heartbeat = 0;
 	random_key(obj->guid,sizeof(obj->guid)/sizeof(obj->guid[0]));
 
@@ -403,6 +405,7 @@ OBJECT *object_create_foreign(OBJECT *obj) /**< a pointer to the OBJECT data str
 		 */
 
 	memset(obj->synctime,0,sizeof(obj->synctime));
+	memset(obj->synccost,0,sizeof(obj->synccost));
 
 	obj->id = next_object_id++;
 	obj->next = NULL;
@@ -1430,6 +1433,20 @@ void object_profile(OBJECT *obj, OBJECTPROFILEITEM pass, clock_t t)
 	}
 }
 
+/* weight of the latest sample in the sync cost moving average */
+#define SYNCCOST_WEIGHT 0.2
+
+/* update the moving average of an object's sync cost used by cost-aware sync scheduling;
+   the average follows objects whose cost changes during the run instead of weighting every pass since the start */
+static void object_synccost(OBJECT *obj, OBJECTPROFILEITEM pass, double t)
+{
+	double dt = exec_clock_hires()-t;
+	if ( obj->synccost[pass]==0.0 )
+		obj->synccost[pass] = dt;
+	else
+		obj->synccost[pass] += SYNCCOST_WEIGHT*(dt-obj->synccost[pass]);
+}
+
 void object_synctime_profile_dump(char *filename)
 {
 	char *fname = filename?filename:"object_profile.txt";
@@ -1544,11 +1561,14 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 					  PASSCONFIG pass) /**< the pass configuration */
 {
 	clock_t t = (clock_t)exec_clock();
+	double th = global_sync_scheduler==SS_COSTAWARE ? exec_clock_hires() : 0.0;
 	TIMESTAMP t2=TS_NEVER;
+	unsigned int *rng = random_context(&obj->rng_state); /* draws made without a state use the object's stream */
 	do {
 		/* don't call sync beyond valid horizon */
 		t2 = _object_sync(obj,(ts<(obj->valid_to>0?obj->valid_to:TS_NEVER)?ts:obj->valid_to),pass);	
 	} while (t2>0 && ts>(t2<0?-t2:t2) && t2<TS_NEVER);
+	random_context(rng);
 
 	/* do profiling, if needed */
 	if ( global_profiler==1 )
@@ -1560,6 +1580,17 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 		default: break;
 		}
 	}
+
+	/* measure sync cost for the cost-aware scheduler */
+	if ( global_sync_scheduler==SS_COSTAWARE )
+	{
+		switch (pass) {
+		case PC_PRETOPDOWN: object_synccost(obj,OPI_PRESYNC,th);break;
+		case PC_BOTTOMUP: object_synccost(obj,OPI_SYNC,th);break;
+		case PC_POSTTOPDOWN: object_synccost(obj,OPI_POSTSYNC,th);break;
+		default: break;
+		}
+	}
 	if ( global_debug_output>0 )
 	{
 		const char *passname[]={"NOSYNC","PRESYNC","SYNC","INVALID","POSTSYNC"};
@@ -1573,7 +1604,9 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 TIMESTAMP object_heartbeat(OBJECT *obj)
 {
 	clock_t t = (clock_t)exec_clock();
+	unsigned int *rng = random_context(&obj->rng_state);
 	TIMESTAMP t1 = obj->oclass->heartbeat ? obj->oclass->heartbeat(obj) : TS_NEVER;
+	random_context(rng);
 	object_profile(obj,OPI_HEARTBEAT,t);
 		if ( global_debug_output>0 )
 		{
@@ -1593,8 +1626,11 @@ int object_init(OBJECT *obj) /**< the object to initialize */
 	clock_t t = (clock_t)exec_clock();
 	int rv = 1;
 	obj->clock = global_starttime;
-	if(obj->oclass->init != NULL)
+	if(obj->oclass->init != NULL){
+		unsigned int *rng = random_context(&obj->rng_state);
 		rv = (int)(*(obj->oclass->init))(obj, obj->parent);
+		random_context(rng);
+	}
 	object_profile(obj,OPI_INIT,t);
 	if ( global_debug_output>0 )
 	{
@@ -1617,7 +1653,9 @@ STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 	clock_t t = (clock_t)exec_clock();
 	STATUS rv = SUCCESS;
 	if(obj->oclass->precommit != NULL){
+		unsigned int *rng = random_context(&obj->rng_state);
 		rv = (STATUS)(*(obj->oclass->precommit))(obj, t1);
+		random_context(rng);
 	}
 	if(rv == 1){ // if 'old school' or no precommit callback,
 		rv = SUCCESS;
@@ -1635,7 +1673,9 @@ TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
 	clock_t t = (clock_t)exec_clock();
 	TIMESTAMP rv = 1;
 	if(obj->oclass->commit != NULL){
+		unsigned int *rng = random_context(&obj->rng_state);
 		rv = (TIMESTAMP)(*(obj->oclass->commit))(obj, t1, t2);
+		random_context(rng);
 	}
 	if(rv == 1){ // if 'old school' or no commit callback,
 		rv =TS_NEVER;
@@ -1660,7 +1700,9 @@ STATUS object_finalize(OBJECT *obj)
 	clock_t t = (clock_t)exec_clock();
 	STATUS rv = SUCCESS;
 	if(obj->oclass->finalize != NULL){
+		unsigned int *rng = random_context(&obj->rng_state);
 		rv = (STATUS)(*(obj->oclass->finalize))(obj);
+		random_context(rng);
 	}
 	if(rv == 1){ // if 'old school' or no finalize callback,
 		rv = SUCCESS;
@@ -91,9 +91,12 @@ typedef struct s_object_list {
 	double in_svc_double;	/**< Double value representation of in service time */
 	double out_svc_double;	/**< Double value representation of out of service time */
 	clock_t synctime[_OPI_NUMITEMS]; /**< total time used by this object */
+	double synccost[_OPI_NUMITEMS]; /**< moving average of the time taken by this object's sync calls, in seconds (only measured by the COSTAWARE sync scheduler) */
 	NAMESPACE *space; /**< namespace of object */
-	unsigned int lock; /**< object lock */
 	unsigned int rng_state; /**< random number generator state */
+	unsigned int rng_check; /**< RNG4 stream check (see #RANDOMSTATE) */
+	unsigned int64 rng_stream; /**< RNG4 stream of the state (see #RANDOMSTATE) */
+	unsigned int lock; /**< object lock */
 	TIMESTAMP heartbeat; /**< heartbeat call interval (in sim-seconds) */
 	uint64 guid[1]; /**< globally unique identifier */
 	/* IMPORTANT: flags must be last */
@@ -10,6 +10,13 @@
 	a problem, unless you are using the pseudo-random sequences.  In that case, you
 	need to lock the state variable you are using when generating random numbers.
 
+	When the RNG4 generator is selected no lock is taken to draw.  The streams of
+	objects, loadshapes and randomvars are keyed by \p randomseed and their id, which
+	random_stream stores next to their state, so their draws are reproducible regardless
+	of the number of threads.  Draws made without a state during an object callback use
+	the stream of that object; other draws made without a state share one stream, so they
+	are only reproducible with one thread.
+
  @{
  **/
 
@@ -21,6 +28,7 @@
 #include <time.h>
 #include <float.h>
 #include <ctype.h>
+#include <pthread.h>
 
 #include "random.h"
 #include "find.h"
@@ -76,6 +84,90 @@ inline char* strtok_t(char *str, const char *delim, char **nextp)
 
 static unsigned int *ur_state = NULL;
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#define rng4_fetch_and_increment(ptr) ((unsigned int)_InterlockedExchangeAdd((volatile long*)(ptr),1))
+#else
+#define rng4_fetch_and_increment(ptr) __sync_fetch_and_add(ptr,1)
+#endif
+
+/* RNG4 streams are keyed by (domain,id) and the random seed, and their state holds the index
+   of the next draw.  random_stream writes the domain and id next to the state (see RANDOMSTATE),
+   so a draw only depends on the state it is given and takes no lock. */
+#define RNG4_CHECK 0x52e6f34bU
+
+/* draws made without a state outside of an object callback share one stream with an atomic counter */
+static unsigned int rng4_shared_counter = 0;
+
+/* state of the object whose callback the thread is running (see random_context) */
+static pthread_key_t rng4_context;
+static int rng4_context_ok = 0;
+
+/* RNG4 mixing function - the splitmix64 finalizer, a bijection with good avalanche */
+static unsigned int64 rng4_mix64(unsigned int64 x)
+{
+	x ^= x>>30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x>>27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x>>31;
+	return x;
+}
+
+/* key of a stream - distinct for every (domain,id) under a given seed */
+static unsigned int64 rng4_key(unsigned int domain, unsigned int id, unsigned int seed)
+{
+	return rng4_mix64((((unsigned int64)domain<<32)|id) ^ rng4_mix64(((unsigned int64)seed<<1)|1));
+}
+
+/* draw number counter of the stream with key - mixing the counter before the key is applied
+   keeps streams with close keys from being shifted copies of each other */
+static unsigned int rng4_draw(unsigned int64 key, unsigned int counter)
+{
+	return (unsigned int)(rng4_mix64(key ^ rng4_mix64(((unsigned int64)counter<<1)|1))>>32);
+}
+
+/* check of a stream - a state whose check does not match was not started by random_stream */
+static unsigned int rng4_check(unsigned int64 stream)
+{
+	return RNG4_CHECK ^ (unsigned int)stream ^ (unsigned int)(stream>>32);
+}
+
+/* set the stream kept next to state and restart its counter */
+static void rng4_start(unsigned int *state, unsigned int domain, unsigned int id)
+{
+	RANDOMSTATE *rs = (RANDOMSTATE*)state;
+	rs->stream = ((unsigned int64)domain<<32)|id;
+	rs->check = rng4_check(rs->stream);
+	rs->state = 0;
+}
+
+/* state drawn from when none is given, or NULL if the draw uses the shared stream */
+static unsigned int *rng4_default(void)
+{
+	return rng4_context_ok ? (unsigned int*)pthread_getspecific(rng4_context) : NULL;
+}
+
+/* RNG4 is counter-based: a draw is a keyed hash of the index of the draw, so each draw yields
+   32 bits, a stream has 2^32 draws, and streams with different keys are independent */
+static unsigned int rng4_next(unsigned int *state)
+{
+	RANDOMSTATE *rs;
+
+	if ( state==NULL || state==ur_state )
+	{
+		state = rng4_default();
+		if ( state==NULL )
+			return rng4_draw(rng4_key(RS_SHARED,0,global_randomseed),rng4_fetch_and_increment(&rng4_shared_counter));
+	}
+
+	/* the key is made at each draw so that a seed changed after the stream was started is used */
+	rs = (RANDOMSTATE*)state;
+	if ( rs->check!=rng4_check(rs->stream) )
+		return rng4_draw(rng4_key(RS_STATE,0,global_randomseed),rs->state++);
+	return rng4_draw(rng4_key((unsigned int)(rs->stream>>32),(unsigned int)rs->stream,global_randomseed),rs->state++);
+}
+
 unsigned entropy_source(void)
 {
 	struct timeval t;
@@ -91,6 +183,9 @@ int random_init(void)
 
 	srand(1);
 	ur_state = &global_randomseed;
+	rng4_shared_counter = 0;
+	if ( !rng4_context_ok )
+		rng4_context_ok = ( pthread_key_create(&rng4_context,NULL)==0 );
 
 	return 1;
 }
@@ -142,8 +237,8 @@ int random_nargs(char *name)
 	return 0;
 }
 
-/** randwarn checks to see if non-determinism warning is necessary **/
-int randwarn(unsigned int *state)
+/* issue the non-determinism warning once */
+static void nondeterminism_warning(void)
 {
 	static int warned=0;
 	if (global_nondeterminism_warning && !warned)
@@ -151,6 +246,14 @@ int randwarn(unsigned int *state)
 		warned=1;
 		output_warning("non-deterministic behavior probable--rand was called while running multiple threads");
 	}
+}
+
+/** randwarn checks to see if non-determinism warning is necessary **/
+int randwarn(unsigned int *state)
+{
+	/* RNG4 streams given by their state are the same regardless of the thread that uses them */
+	if ( global_randomnumbergenerator!=RNG4 || ( (state==NULL || state==ur_state) && rng4_default()==NULL ) )
+		nondeterminism_warning();
 	
 	if ( global_randomnumbergenerator==RNG2 )
 	{
@@ -181,6 +284,11 @@ int randwarn(unsigned int *state)
 		return ((*state)>>16)&0x7fff;
 		/* note that RNG3 writes back the state */
 	}
+	else if ( global_randomnumbergenerator==RNG4 )
+	{
+		/* keep the 15 bit range of the older generators */
+		return (int)(rng4_next(state)>>17);
+	}
 	else
 	{
 		/* can't recognize what RNG is selected */
@@ -189,17 +297,48 @@ int randwarn(unsigned int *state)
 	}
 }
 
+/** Start an independent random number stream in a state.  When RNG4 is used the stream is
+	keyed by the stream domain and the id and the state counts its draws, so the draws made
+	with it only depend on the random seed, the domain and the id, and not on the order in
+	which streams are created or the number of threads.  Older generators draw the state
+	from the global sequence as before.
+ **/
+void random_stream(unsigned int *state, /**< the state that will be used for the stream */
+				   unsigned int domain, /**< kind of stream, e.g., RS_OBJECT */
+				   unsigned int id) /**< id of the stream within its domain */
+{
+	if ( global_randomnumbergenerator==RNG4 )
+		rng4_start(state,domain,id);
+	else
+		*state = randwarn(NULL);
+}
+
+/** Set the state that RNG4 draws made without a state use on the calling thread.  The core
+	sets it to the state of the object whose callback is running (see object_sync), so the
+	draws a module makes without a state are reproducible regardless of the number of threads.
+	@return the state used before, which the caller restores when the callback returns
+ **/
+unsigned int *random_context(unsigned int *state) /**< the state to use, or NULL for the shared stream */
+{
+	unsigned int *prev;
+	if ( global_randomnumbergenerator!=RNG4 || !rng4_context_ok )
+		return NULL;
+	prev = (unsigned int*)pthread_getspecific(rng4_context);
+	pthread_setspecific(rng4_context,state);
+	return prev;
+}
+
 /* generate a random id number */
 unsigned int64 random_id(void)
 {
-	static unsigned int state = 0;
+	static RANDOMSTATE state = {0};
 	int64 rv = 0;
-	if ( state==0 ) state = (unsigned int)time(NULL);	
-	rv = randwarn(&state);
-	rv = (rv<<15) ^ randwarn(&state);
-	rv = (rv<<15) ^ randwarn(&state);
-	rv = (rv<<15) ^ randwarn(&state);
-	rv = (rv<<3) ^ randwarn(&state);
+	if ( state.state==0 ) state.state = (unsigned int)time(NULL);	
+	rv = randwarn(&state.state);
+	rv = (rv<<15) ^ randwarn(&state.state);
+	rv = (rv<<15) ^ randwarn(&state.state);
+	rv = (rv<<15) ^ randwarn(&state.state);
+	rv = (rv<<3) ^ randwarn(&state.state);
 	if(rv < 0){
 		return -rv;
 	}
@@ -209,17 +348,17 @@ unsigned int64 random_id(void)
 /* generate a random key */
 void random_key(unsigned int64 *ptr, size_t len)
 {
-	static unsigned int state = 0;
+	static RANDOMSTATE state = {0};
 	int64 rv = 0;
-	if ( state == 0 ) state = (unsigned int)time(NULL);
+	if ( state.state == 0 ) state.state = (unsigned int)time(NULL);
 	while ( len-- > 0 )
 	{
 		unsigned int64 rv = 0;
-		rv = randwarn(&state);
-		rv = (rv<<15) ^ randwarn(&state);
-		rv = (rv<<15) ^ randwarn(&state);
-		rv = (rv<<15) ^ randwarn(&state);
-		rv = (rv<<3) ^ randwarn(&state);
+		rv = randwarn(&state.state);
+		rv = (rv<<15) ^ randwarn(&state.state);
+		rv = (rv<<15) ^ randwarn(&state.state);
+		rv = (rv<<15) ^ randwarn(&state.state);
+		rv = (rv<<3) ^ randwarn(&state.state);
 		*ptr++ = rv;
 	}
 }
@@ -231,6 +370,14 @@ double randunit(unsigned int *state)
 	unsigned int ur;
 	static int random_lock=0;
 
+	/* RNG4 never returns 0 or 1 and takes no lock */
+	if ( global_randomnumbergenerator==RNG4 )
+	{
+		if ( (state==NULL || state==ur_state) && rng4_default()==NULL )
+			nondeterminism_warning();
+		return (rng4_next(state)+0.5)/4294967296.0;
+	}
+
 	if ( state==NULL || state==ur_state )
 	{
 		state=ur_state;
@@ -886,7 +1033,8 @@ int random_test(void)
 	double a, b;
 	unsigned int count = sizeof(sample)/sizeof(sample[0]);
 	unsigned int i;
-	unsigned int initstate, state;
+	unsigned int initstate;
+	RANDOMSTATE state = {0};
 
 	output_test("\nBEGIN: random random distributions tests");
 
@@ -1104,14 +1252,14 @@ int random_test(void)
 	preverrors=errorcount;
 
 	/* test deterministic sequences */
-	initstate = state = rand();
+	initstate = state.state = rand();
 	output_test("\nDeterministic test for state %u (N=%d)",initstate,count);
 	for (i=0; i<count; i++)
-		sample[i] = pseudorandom_value(RT_UNIFORM,&state,0.0,1.0);
-	state = initstate;
+		sample[i] = pseudorandom_value(RT_UNIFORM,&state.state,0.0,1.0);
+	state.state = initstate;
 	for (i=0; i<count; i++)
 	{
-		double v = pseudorandom_value(RT_UNIFORM,&state,0.0,1.0);
+		double v = pseudorandom_value(RT_UNIFORM,&state.state,0.0,1.0);
 		if (sample[i] != v)
 			failed++,output_test("Sample %d did not match (%f!=%f)", i, sample[i],v);
 	}	
@@ -1119,10 +1267,10 @@ int random_test(void)
 	preverrors=errorcount;
 
 	/* test modulus */
-	initstate = state;
-	output_test("\nTesting modulus starting at state 0x%08x", state);
-	for ( randwarn(&state),count=1; state!=initstate && count!=0 ; count++)
-		randwarn(&state);
+	initstate = state.state;
+	output_test("\nTesting modulus starting at state 0x%08x", state.state);
+	for ( randwarn(&state.state),count=1; state.state!=initstate && count!=0 ; count++)
+		randwarn(&state.state);
 	if ( count==0 )
 		output_test("Modulus exceeds 2^32");
 	else
@@ -1148,6 +1296,7 @@ int random_test(void)
 
 static randomvar *randomvar_list = NULL;
 static unsigned int n_randomvars = 0;
+RANDOMSTATE_LAYOUT(randomvar,state,check,stream);
 clock_t randomvar_synctime = 0;
 
 int convert_to_randomvar(char *string, void *data, PROPERTY *prop)
@@ -1157,10 +1306,14 @@ int convert_to_randomvar(char *string, void *data, PROPERTY *prop)
 	char *token = NULL;
 	char *last = NULL;
 
-	/* clean memory */
+	/* clean memory, keeping the list and the stream started by randomvar_create */
 	randomvar *next = var->next;
+	unsigned int check = var->check;
+	unsigned int64 stream = var->stream;
 	memset(var,0,sizeof(randomvar));
 	var->next = next;
+	var->check = check;
+	var->stream = stream;
 
 	/* check string length before copying to buffer */
 	if (strlen(string)>sizeof(buffer)-1)
@@ -1281,7 +1434,7 @@ int randomvar_create(randomvar *var)
 {
 	memset(var,0,sizeof(randomvar));
 	var->next = randomvar_list;
-	var->state = randwarn(NULL);
+	random_stream(&var->state,RS_RANDOMVAR,n_randomvars);
 	randomvar_list = var;
 	n_randomvars++;
 	return 1;
@@ -9,6 +9,8 @@
 #ifndef _RANDOM_H
 #define _RANDOM_H
 
+#include <stddef.h>
+
 #include "platform.h"
 #include "timestamp.h"
 #include "property.h"
@@ -30,12 +32,40 @@ typedef enum {
 	RT_TRIANGLE,	/**< Triangle distribution; double a, double b */
 } RANDOMTYPE;
 
+typedef enum {
+	RS_SHARED=0,	/**< stream of the draws made without a state outside of an object callback
+					     (see random_context); threads take the next draw of this stream in whatever
+					     order they reach it, so these draws are not reproducible across thread counts */
+	RS_OBJECT=1,	/**< stream of an object (id is the object id) */
+	RS_LOADSHAPE=2,	/**< stream of a loadshape (id is the order in which loadshapes are initialized) */
+	RS_RANDOMVAR=3,	/**< stream of a randomvar (id is the order in which randomvars are created) */
+	RS_STATE=4,		/**< stream of a state not started by random_stream (the state is the index of the draw) */
+} RANDOMSTREAM; /**< domains of the independent streams used by RNG4 */
+
+/** Layout of a state started by random_stream.  RNG4 keeps the stream of the state next to
+	its counter, so a draw only reads and increments the state it is given.  States of
+	objects, loadshapes and randomvars are laid out this way (checked by #RANDOMSTATE_LAYOUT);
+	a bare unsigned int may only be used as a state with the older generators.
+ **/
+typedef struct s_randomstate {
+	unsigned int state;		/**< index of the next draw */
+	unsigned int check;		/**< marks the stream as started by random_stream */
+	unsigned int64 stream;	/**< domain and id of the stream */
+} RANDOMSTATE;
+
+/** Fails to compile unless the fields S, C and K of type T are laid out like #RANDOMSTATE */
+#define RANDOMSTATE_LAYOUT(T,S,C,K) typedef char T##_randomstate_layout[ \
+	(offsetof(T,C)-offsetof(T,S)==offsetof(RANDOMSTATE,check) \
+	&& offsetof(T,K)-offsetof(T,S)==offsetof(RANDOMSTATE,stream)) ? 1 : -1]
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 	int random_init(void);
 	int random_test(void);
 	int randwarn(unsigned int *state);
+	void random_stream(unsigned int *state, unsigned int domain, unsigned int id);
+	unsigned int *random_context(unsigned int *state);
 	void random_key(unsigned int64 *ptr, size_t len);
 	double randunit(unsigned int *state);
 	double random_degenerate(unsigned int *state, double a);
@@ -68,6 +98,8 @@ typedef struct s_randomvar randomvar;
 struct s_randomvar {
 	double value;				/**< current value */
 	unsigned int state;			/**< RNG state */
+	unsigned int check;			/**< RNG4 stream check (see #RANDOMSTATE) */
+	unsigned int64 stream;		/**< RNG4 stream of the state (see #RANDOMSTATE) */
 	RANDOMTYPE type;			/**< RNG distribution */
 	double a, b;				/**< RNG distribution parameters */
 	double low, high;			/**< RNG truncations limits */
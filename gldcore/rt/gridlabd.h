@@ -402,6 +402,8 @@ typedef complex triplex[3];
 typedef struct s_randomvar {
 	double value;				/**< current value */
 	unsigned int state;			/**< RNG state */
+	unsigned int check;			/**< RNG4 stream check */
+	unsigned int64 stream;		/**< RNG4 stream of the state */
 	RANDOMTYPE type;			/**< RNG distribution */
 	double a, b;				/**< RNG distribution parameters */
 	double low, high;			/**< RNG truncations limits */
@@ -672,6 +674,8 @@ struct s_class_list {
 	TECHNOLOGYREADINESSLEVEL trl; // technology readiness level (1-9, 0=unknown)
 	bool has_runtime;	///< flag indicating that a runtime dll, so, or dylib is in use
 	char runtime[1024]; ///< name of file containing runtime dll, so, or dylib
+	struct s_property_index *pindex; ///< hashed index of the class and inherited properties (built by class_find_property)
+	unsigned int pgeneration; ///< number of properties added to the class, so indexes built before an addition can be told apart
 	CLASS *next;
 };
 
@@ -725,9 +729,12 @@ struct s_object_list {
 	double in_svc_double;	/**< Double value representation of in service time */
 	double out_svc_double;	/**< Double value representation of out of service time */
 	clock_t synctime[_OPI_NUMITEMS]; /**< total time used by this object */
+	double synccost[_OPI_NUMITEMS]; /**< moving average of the time taken by this object's sync calls, in seconds (only measured by the COSTAWARE sync scheduler) */
 	NAMESPACE *space; /**< namespace of object */
-	unsigned int lock; /**< object lock */
 	unsigned int rng_state; /**< random number generator state */
+	unsigned int rng_check; /**< RNG4 stream check */
+	unsigned int64 rng_stream; /**< RNG4 stream of the state */
+	unsigned int lock; /**< object lock */
 	TIMESTAMP heartbeat; /**< heartbeat call interval (in sim-seconds) */
 	unsigned int64 guid; /**< globally unique identifier */
 	/* IMPORTANT: flags must be last */
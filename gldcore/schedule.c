@@ -21,6 +21,7 @@
 #include "exception.h"
 #include "lock.h"
 #include "exec.h"
+#include "eventqueue.h"
 
 SET_MYCONTEXT(DMC_SCHEDULE)
 
@@ -1069,9 +1070,7 @@ typedef struct s_schedulesyncdata {
 	unsigned int n;
 	pthread_t pt;
 	bool ok;
-	SCHEDULE *sch;
-	unsigned int nsch;
-	TIMESTAMP t0;
+	unsigned int ran;
 } SCHEDULESYNCDATA;
 
 static pthread_cond_t start_sch = PTHREAD_COND_INITIALIZER;
@@ -1079,17 +1078,26 @@ static pthread_mutex_t startlock_sch = PTHREAD_MUTEX_INITIALIZER;
 static pthread_cond_t done_sch = PTHREAD_COND_INITIALIZER;
 static pthread_mutex_t donelock_sch = PTHREAD_MUTEX_INITIALIZER;
 static TIMESTAMP next_t1_sch;
-static TIMESTAMP next_t2_sch = TS_ZERO;
+static unsigned int run_sch = 0;
 static unsigned int donecount_sch;
+static unsigned int n_threads_sch = 0;
+
+/* Schedules are kept in an event queue by the time of their next change so that only
+   the schedules whose change has come are synced.  Interpolated schedules change on
+   every pass so they are not queued. */
+static EVENTQUEUE *schedule_queue = NULL;
+static SCHEDULE **schedule_due = NULL; /* schedules synced by the current pass */
+static unsigned int n_due_sch = 0;
+static SCHEDULE **schedule_interpolated = NULL;
+static unsigned int n_interpolated_sch = 0;
+static uint32 n_queued_sch = 0; /* number of schedules when the queue was built */
 
 clock_t schedule_synctime = 0;
 
 void *schedule_syncproc(void *ptr)
 {
 	SCHEDULESYNCDATA *data = (SCHEDULESYNCDATA*)ptr;
-	SCHEDULE *sch;
 	unsigned int n;
-	TIMESTAMP t2;
 
 	// begin processing loop
 	while ( data->ok )
@@ -1098,29 +1106,24 @@ void *schedule_syncproc(void *ptr)
 		pthread_mutex_lock(&startlock_sch);
 
 		// wait for thread start condition
-		while (data->t0==next_t1_sch) 
+		while (data->ran==run_sch) 
 			pthread_cond_wait(&start_sch,&startlock_sch);
 		
 		// unlock access to start count
 		pthread_mutex_unlock(&startlock_sch);
 
-		// process the list for this thread
-		t2 = TS_NEVER;
-		for ( sch=data->sch, n=0 ; sch!=NULL, n<data->nsch ; sch=sch->next, n++ )
-		{
-			TIMESTAMP t = schedule_sync(sch,next_t1_sch);
-			if (t<t2) t2 = t;
-		}
+		// process the due schedules assigned to this thread
+		for ( n=data->n ; n<n_due_sch ; n+=n_threads_sch )
+			schedule_sync(schedule_due[n],next_t1_sch);
 
 		// signal completed condition
-		data->t0 = next_t1_sch;
+		data->ran = run_sch;
 
 		// lock access to done condition
 		pthread_mutex_lock(&donelock_sch);
 
 		// signal thread is done for now
 		donecount_sch--;
-		if ( t2<next_t2_sch ) next_t2_sch = t2;
 
 		// signal change in done condition
 		pthread_cond_broadcast(&done_sch);
@@ -1132,34 +1135,61 @@ void *schedule_syncproc(void *ptr)
 	return (void*)0;
 }
 
+/* queue all the schedules by the time of their next change */
+static void schedule_queue_build(void)
+{
+	SCHEDULE *sch;
+	if ( schedule_queue==NULL )
+		schedule_queue = eventqueue_create();
+	schedule_due = (SCHEDULE**)realloc(schedule_due,sizeof(SCHEDULE*)*n_schedules);
+	schedule_interpolated = (SCHEDULE**)realloc(schedule_interpolated,sizeof(SCHEDULE*)*n_schedules);
+	if ( schedule_queue==NULL || schedule_due==NULL || schedule_interpolated==NULL )
+		throw_exception("schedule_syncall(): unable to allocate the schedule event queue");
+		/* TROUBLESHOOT
+			There was not enough memory to queue the schedules by the time of their next change.
+			Try freeing up system memory and try again.
+		 */
+	eventqueue_clear(schedule_queue);
+	n_interpolated_sch = 0;
+	for ( sch=schedule_list ; sch!=NULL ; sch=sch->next )
+	{
+		int ok = 1;
+		if ( (sch->flags&SN_INTERPOLATED)==SN_INTERPOLATED )
+			schedule_interpolated[n_interpolated_sch++] = sch;
+		else if ( sch->since==TS_ZERO ) // not synced yet
+			ok = eventqueue_push(schedule_queue,TS_ZERO,sch);
+		else if ( sch->next_t!=TS_NEVER )
+			ok = eventqueue_push(schedule_queue,sch->next_t,sch);
+		if ( !ok )
+			throw_exception("schedule_syncall(): unable to allocate the schedule event queue");
+	}
+	n_queued_sch = n_schedules;
+}
+
 /** synchronized all the schedules to the time given
     @return the time of the next schedule change
  **/
 TIMESTAMP schedule_syncall(TIMESTAMP t1) /**< the time to which the schedule is synchronized */
 {
-	static unsigned int n_threads_sch=0;
 	static SCHEDULESYNCDATA *thread_sch = NULL;
 	TIMESTAMP t2 = TS_NEVER;
 	clock_t ts = (clock_t)exec_clock();
+	SCHEDULE *sch;
+	unsigned int n;
 
 	// skip schedule_syncall if there's no schedule in the glm
 	if (n_schedules == 0)
 		return TS_NEVER;
 
-
 	// number of threads desired
 	if (n_threads_sch==0) 
 	{
-		SCHEDULE *sch;
-		int n_items, schn=0;
-
-		IN_MYCONTEXT output_debug("loadshape_syncall setting up for %d shapes", n_schedules);
+		IN_MYCONTEXT output_debug("schedule_syncall setting up for %d schedules", n_schedules);
 
 		// determine needed threads
 		n_threads_sch = global_threadcount;
 		if (n_threads_sch>1)
 		{
-			unsigned int n;
 			if (n_schedules<n_threads_sch*4)
 				n_threads_sch = n_schedules/4;
 
@@ -1167,63 +1197,42 @@ TIMESTAMP schedule_syncall(TIMESTAMP t1) /**< the time to which the schedule is
 			if (n_threads_sch == 0)
 				n_threads_sch = 1;
 
-			// determine shapes per thread
-			n_items = n_schedules/n_threads_sch;
-			n_threads_sch = n_schedules/n_items;
-			if (n_threads_sch*n_items<n_schedules) // not enough slots yet
-				n_threads_sch++; // add one underused threads
-
 			IN_MYCONTEXT output_debug("schedule_syncall is using %d of %d available threads", n_threads_sch, global_threadcount);
-			IN_MYCONTEXT output_debug("schedule_syncall is assigning %d shapes per thread", n_items);
 
 			// allocate thread list
 			thread_sch = (SCHEDULESYNCDATA*)malloc(sizeof(SCHEDULESYNCDATA)*n_threads_sch);
 			memset(thread_sch,0,sizeof(SCHEDULESYNCDATA)*n_threads_sch);
 
-			// assign starting shape for each thread
-			for (sch=schedule_list; sch!=NULL; sch=sch->next)
-			{
-				if (thread_sch[schn].nsch==n_items)
-					schn++;
-				if (thread_sch[schn].nsch==0)
-					thread_sch[schn].sch = sch;
-				thread_sch[schn].nsch++;
-			}
-
 			// create threads
 			for (n=0; n<n_threads_sch; n++)
 			{
 				thread_sch[n].ok = true;
+				thread_sch[n].n = n;
 				if ( pthread_create(&(thread_sch[n].pt),NULL,schedule_syncproc,&(thread_sch[n]))!=0 )
 				{
-					output_fatal("loadshape_sync thread creation failed");
+					output_fatal("schedule_sync thread creation failed");
 					thread_sch[n].ok = false;
 				}
-				else
-					thread_sch[n].n = n;
 			}
 		}
 	}
 
-	// don't update if no schedules ever expect to change again
-	if (next_t2_sch == TS_NEVER)
-		return TS_NEVER;
+	// queue the schedules when they are first synced or when new ones have been added
+	if (n_queued_sch != n_schedules)
+		schedule_queue_build();
 
-	// don't update if next_t2 < next_t1, but override this if there are interpolated schedules
-	if (next_t2_sch > t1 && !interpolated_schedules)
-		return next_t2_sch;
+	// collect the interpolated schedules and the schedules whose next change has come
+	for (n_due_sch=0; n_due_sch<n_interpolated_sch; n_due_sch++)
+		schedule_due[n_due_sch] = schedule_interpolated[n_due_sch];
+	while ((sch=(SCHEDULE*)eventqueue_pop(schedule_queue,t1))!=NULL)
+		schedule_due[n_due_sch++] = sch;
 
 	// no threading required
-	if (n_threads_sch<2) 
+	if (n_threads_sch<2 || n_due_sch<n_threads_sch*4) 
 	{
 		// process list directly
-		SCHEDULE *sch;
-		for (sch=schedule_list; sch!=NULL; sch=sch->next)
-		{
-			TIMESTAMP t3 = schedule_sync(sch,t1);
-			if (t3<t2) t2 = t3;
-		}
-		next_t2_sch = t2;
+		for (n=0; n<n_due_sch; n++)
+			schedule_sync(schedule_due[n],t1);
 	}
 	else
 	{
@@ -1238,7 +1247,7 @@ TIMESTAMP schedule_syncall(TIMESTAMP t1) /**< the time to which the schedule is
 
 		// update start condition
 		next_t1_sch = t1;
-		next_t2_sch = TS_NEVER;
+		run_sch++;
 
 		// signal all the threads
 		pthread_cond_broadcast(&start_sch);
@@ -1253,11 +1262,20 @@ TIMESTAMP schedule_syncall(TIMESTAMP t1) /**< the time to which the schedule is
 
 		// unlock done count
 		pthread_mutex_unlock(&donelock_sch);
+	}
 
-		// process results from all threads
-		if (next_t2_sch<t2) t2=next_t2_sch;
+	// requeue the synced schedules that will change again
+	for (n=0; n<n_due_sch; n++)
+	{
+		sch = schedule_due[n];
+		if (sch->next_t<t2) t2 = sch->next_t;
+		if (n>=n_interpolated_sch && sch->next_t!=TS_NEVER && !eventqueue_push(schedule_queue,sch->next_t,sch))
+			throw_exception("schedule_syncall(): unable to allocate the schedule event queue");
 	}
 
+	// the earliest change of the schedules that were not synced is at the head of the queue
+	if (eventqueue_next(schedule_queue)<t2) t2 = eventqueue_next(schedule_queue);
+
 	schedule_synctime += (clock_t)exec_clock() - ts;
 	return t2;
 }
@@ -223,6 +223,7 @@ int auction::create(void)
 	warmup = 1;
 	market_id = 1;
 	clearing_scalar = 0.5;
+	trans_time = TS_NEVER;
 	/* process dynamic statistics */
 	if(statistic_check == -1){
 		int rv;
@@ -398,22 +399,23 @@ int auction::init(OBJECT *parent)
 	// initialize arrays
 	if(statistic_count > 0){
 		statdata = (double *)malloc(sizeof(double) * statistic_count);
+		windows = (STATWINDOW *)malloc(sizeof(STATWINDOW) * statistic_count);
 	}
 	if(longest_statistic > 0){
 		history_count = (uint32)longest_statistic / (uint32)(this->period) + 2;
-		new_prices = (double *)malloc(sizeof(double) * history_count);
-		new_market_failures = (double *)malloc(sizeof(double) * history_count);
 	} else {
 		history_count = 1;
-		new_prices = (double *)malloc(sizeof(double));
-		new_market_failures = (double *)malloc(sizeof(double));
 	}
+	history = (MARKETHISTORY *)malloc(sizeof(MARKETHISTORY) * history_count);
 	price_index = 0;
 	price_count = 0;
 	for(i = 0; i < history_count; ++i){
-		new_prices[i] = init_price;
-		new_market_failures[i] = CT_EXACT; // initialize all markets as NOT FAILED
+		history[i].price = init_price;
+		history[i].quantity = 0.0;
+		history[i].clearing_type = CT_EXACT; // initialize all markets as NOT FAILED
+		history[i].skip = (ignore_pricecap == IP_TRUE) && ((init_price == pricecap) || (init_price == -pricecap));
 	}
+	reset_statistics();
 
 	if(init_stdev < 0.0){
 		gl_error("auction init_stdev is negative!");
@@ -526,20 +528,101 @@ int auction::init_statistics(){
 	return 1;
 }
 
+/*	Add a window sample to the running mean and variance (Welford's update). */
+static void window_add(STATWINDOW *w, double x){
+	double d = x - w->mean;
+	++w->count;
+	w->mean += d / w->count;
+	w->m2 += d * (x - w->mean);
+}
+
+/*	Remove a window sample from the running mean and variance. */
+static void window_remove(STATWINDOW *w, double x){
+	double d = x - w->mean;
+	if(w->count <= 1){
+		w->count = 0;
+		w->mean = 0.0;
+		w->m2 = 0.0;
+		return;
+	}
+	--w->count;
+	w->mean -= d / w->count;
+	w->m2 -= d * (x - w->mean);
+	if(w->m2 < 0.0){
+		w->m2 = 0.0;
+	}
+}
+
+/*	Recompute the statistic windows from the price history.  This is done when the history
+	is created and each time it wraps so that rounding does not accumulate in the windows. */
+void auction::reset_statistics(){
+	STATISTIC *current = 0;
+	STATWINDOW *w = windows;
+	unsigned int newest = (price_index + history_count - 1) % history_count;
+	unsigned int i = 0;
+	if(windows == 0){
+		return;
+	}
+	for(current = stats; current != 0; current = current->next, ++w){
+		w->samples = (unsigned int)(current->interval / this->period);
+		w->offset = (current->stat_mode == ST_PAST ? 1 : 0);
+		w->count = 0;
+		w->mean = 0.0;
+		w->m2 = 0.0;
+		for(i = w->samples; i > 0; --i){
+			MARKETHISTORY *h = &history[(newest + 2 * history_count - w->offset - i + 1) % history_count];
+			if(!h->skip){
+				window_add(w, h->price);
+			}
+		}
+	}
+}
+
+/*	Add the cleared market to the price history and slide the statistic windows over it. */
+void auction::record_history(double price, double quantity, enumeration clearing_type){
+	STATWINDOW *w = windows;
+	unsigned int i = 0;
+	if(price_index == history_count){
+		price_index = 0;
+	}
+	history[price_index].price = price;
+	history[price_index].quantity = quantity;
+	history[price_index].clearing_type = clearing_type;
+	history[price_index].skip = ((ignore_pricecap == IP_TRUE) && ((price == pricecap) || (price == -pricecap)))
+		|| ((ignore_failedmarket == IFM_TRUE) && (clearing_type == CT_FAILURE));
+	++price_count;
+	if(windows != 0){
+		if(price_count % history_count == 0){
+			++price_index;
+			reset_statistics();
+			return;
+		}
+		for(i = 0; i < statistic_count; ++i, ++w){
+			MARKETHISTORY *in = &history[(price_index + history_count - w->offset) % history_count];
+			MARKETHISTORY *out = &history[(price_index + history_count - w->offset - w->samples) % history_count];
+			if(w->samples == 0){
+				continue;
+			}
+			if(!out->skip){
+				window_remove(w, out->price);
+			}
+			if(!in->skip){
+				window_add(w, in->price);
+			}
+		}
+	}
+	++price_index;
+}
+
 int auction::update_statistics(){
 	OBJECT *obj = OBJECTHDR(this);
 	STATISTIC *current = 0;
-	uint32 sample_need = 0;
-	unsigned int start = 0, stop = 0;
-	unsigned int i = 0;
-	unsigned int idx = 0;
-	unsigned int skipped = 0;
+	STATWINDOW *w = windows;
 	double mean = 0.0;
-	double stdev = 0.0;
 	if(statistic_count < 1){
 		return 1; // no statistics
 	}
-	if(new_prices == 0){
+	if(history == 0 || windows == 0){
 		return 0;
 	}
 	if(statdata == 0){
@@ -548,27 +631,9 @@ int auction::update_statistics(){
 	if(stats == 0){
 		return 1; // should've been caught with statistic_count < 1
 	}
-	for(current = stats; current != 0; current = current->next){
-		mean = 0.0;
-		sample_need = (uint32)(current->interval / this->period);
-		if(current->stat_mode == ST_CURR){
-			stop = price_index;
-		} else if(current->stat_mode == ST_PAST){
-			stop = price_index - 1;
-		}
-		start = (unsigned int)((history_count + stop - sample_need) % history_count); // one off for initial period delay
-		for(i = 0; i < sample_need; ++i){
-			idx = (start + i + history_count) % history_count;
-			if( (ignore_pricecap == IP_TRUE) && ((new_prices[idx] == pricecap) || (new_prices[idx] == -pricecap))){
-				++skipped;
-			} else if( (ignore_failedmarket == IFM_TRUE) && (new_market_failures[idx] == CT_FAILURE) )  {
-				++skipped;
-			} else {
-				mean += new_prices[idx];
-			}
-		}
-		if(skipped != sample_need){
-			mean /= (sample_need - skipped);
+	for(current = stats; current != 0; current = current->next, ++w){
+		if(w->count > 0){
+			mean = w->mean;
 		} else {
 			mean = 0; // problem!
 			gl_warning("All values in auction statistic calculations were skipped. Setting mean to zero.");
@@ -584,31 +649,15 @@ int auction::update_statistics(){
 		if(current->stat_type == SY_MEAN){
 			current->value = mean;
 		} else if(current->stat_type == SY_STDEV){
-			double x = 0.0;
-			if(sample_need + (current->stat_mode == ST_PAST ? 1 : 0) > total_samples){ // extra sample for 'past' values
+			if(w->samples + w->offset > total_samples){ // extra sample for 'past' values
 				//	still in initial period, use init_stdev
 				current->value = init_stdev;
+			} else if(w->count > 0){
+				// deviation about the mean used, which differs from the window mean for future mean prices
+				double x = w->mean - mean;
+				current->value = sqrt(w->m2 / w->count + x * x);
 			} else {
-				stdev = 0.0;
-				for(i = 0; i < sample_need; ++i){
-					idx = (start + i + history_count) % history_count;
-					if( (ignore_pricecap == IP_TRUE) && ((new_prices[idx] == pricecap) || (new_prices[idx] == -pricecap))){
-						// Ignore the value
-					}
-					else if( (ignore_failedmarket == IFM_TRUE) && (new_market_failures[idx] == CT_FAILURE) ) {
-						// Ignore the value
-					}
-					else {
-						x = new_prices[idx] - mean;
-						stdev += x * x;
-					}
-				}
-				if(skipped != sample_need){
-					stdev /= (sample_need - skipped);
-				} else {
-					stdev = 0; // problem!
-				}
-				current->value = sqrt(stdev);
+				current->value = 0; // problem!
 			}
 		}
 		if(statistic_mode == ST_ON){
@@ -1370,13 +1419,7 @@ void auction::clear_market(void)
 	}
 
 	if(history_count > 0){
-		if(price_index == history_count){
-			price_index = 0;
-		}
-		new_prices[price_index] = next.price;
-		new_market_failures[price_index] = current_frame.clearing_type;
-		//int update_rv = update_statistics();
-		++price_index;
+		record_history(next.price, next.quantity, current_frame.clearing_type);
 	}
 
 	/* limit price */
@@ -1444,34 +1487,29 @@ void auction::clear_market(void)
 }
 
 void auction::record_bid(char *from, double quantity, double real_price, BIDDERSTATE state){
-	char name_buffer[256];
-	char *unkState = "unknown";
-	char *offState = "off";
-	char *onState = "on";
-	char *unk = "unknown time";
-	char buffer[256];
-	char bigbuffer[1024];
-	char *pState;
-	char *tStr;
-	DATETIME dt;
-	TIMESTAMP submit_time = gl_globalclock;
+	const char *pState;
 	if(trans_file){ // copied from version below
 		if((this->trans_log_max <= 0) || (trans_log_count > 0)){
-			gl_localtime(submit_time,&dt);
+			/* all the bids of a market frame share the same time string */
+			if(trans_time != gl_globalclock){
+				DATETIME dt;
+				gl_localtime(gl_globalclock,&dt);
+				if(!gl_strtime(&dt,trans_timestr,sizeof(trans_timestr)))
+					strcpy(trans_timestr,"unknown time");
+				trans_time = gl_globalclock;
+			}
 			switch(state){
-				case BS_UNKNOWN:
-					pState = unkState;
-					break;
 				case BS_OFF:
-					pState = offState;
+					pState = "off";
 					break;
 				case BS_ON:
-					pState = onState;
+					pState = "on";
+					break;
+				default:
+					pState = "unknown";
 					break;
 			}
-			tStr = (gl_strtime(&dt,buffer,sizeof(buffer)) ? buffer : unk);
-			sprintf(bigbuffer, "%d,%s,%s,%f,%f,%s", (int32)market_id, tStr, from, real_price, quantity, pState);
-			fprintf(trans_file, "%s\n", bigbuffer);
+			fprintf(trans_file, "%d,%s,%s,%f,%f,%s\n", (int32)market_id, trans_timestr, from, real_price, quantity, pState);
 			--trans_log_count;
 		} else {
 			fprintf(trans_file, "# end of file \n");
@@ -1489,10 +1527,8 @@ int auction::submit(char *from, double quantity, double real_price, KEY key, BID
 int auction::submit_nolock(char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id)
 {
 	char myname[64];
-	TIMESTAMP submit_time = gl_globalclock;
 	DATETIME dt;
 	double price;
-	gl_localtime(submit_time,&dt);
 	char buffer[256];
 	BIDDEF biddef;
 	KEY b_id = key;
@@ -1537,6 +1573,7 @@ int auction::submit_nolock(char *from, double quantity, double real_price, KEY k
 	{
 		KEY out;
 		if (verbose){
+			gl_localtime(gl_globalclock,&dt);
 			gl_output("   ...  %s resubmits %s from object %s for %.2f %s at $%.2f/%s at %s", 
 				gl_name(OBJECTHDR(this),myname,sizeof(myname)), quantity<0?"ask":"offer", from,
 				fabs(quantity), unit.get_string(), price, unit.get_string(), gl_strtime(&dt,buffer,sizeof(buffer))?buffer:"unknown time");
@@ -1570,6 +1607,7 @@ int auction::submit_nolock(char *from, double quantity, double real_price, KEY k
 		char biddername[64];
 		KEY out;
 		if (verbose){
+			gl_localtime(gl_globalclock,&dt);
 			gl_output("   ...  %s receives %s from object %s for %.2f %s at $%.2f/%s at %s", 
 				gl_name(OBJECTHDR(this),myname,sizeof(myname)), quantity<0?"ask":"offer", from,
 				fabs(quantity), unit.get_string(), price, unit.get_string(), gl_strtime(&dt,buffer,sizeof(buffer))?buffer:"unknown time");
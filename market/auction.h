@@ -26,6 +26,23 @@ typedef struct s_statistic {
 	struct s_statistic *next;
 } STATISTIC;
 
+/** cleared market kept in the price history */
+typedef struct s_market_history {
+	double price;
+	double quantity;
+	enumeration clearing_type;
+	bool skip;		/**< excluded from the statistics (ignore_pricecap/ignore_failedmarket) */
+} MARKETHISTORY;
+
+/** running mean and variance of a statistic over its window of the price history */
+typedef struct s_statistic_window {
+	unsigned int samples;	/**< length of the window in markets */
+	unsigned int offset;	/**< 1 when the window excludes the latest market (past statistics) */
+	unsigned int count;		/**< markets in the window that are not skipped */
+	double mean;
+	double m2;				/**< sum of squared deviations from the mean */
+} STATWINDOW;
+
 typedef struct s_market_frame{
 	int64 market_id;
 	TIMESTAMP start_time;
@@ -69,6 +86,8 @@ private:
 	// functions
 	int init_statistics();
 	int update_statistics();
+	void reset_statistics();
+	void record_history(double price, double quantity, enumeration clearing_type);
 	int push_market_frame(TIMESTAMP t1);
 	int check_next_market(TIMESTAMP t1);
 	TIMESTAMP pop_market_frame(TIMESTAMP t1);
@@ -118,11 +137,11 @@ public:
 	double clearing_scalar;
 	
 	// statistics
-	double *new_prices;
-	double *new_market_failures; //0 indicates it did NOT fail, 1 indicates failure
+	MARKETHISTORY *history;	/**< ring of cleared markets used by the statistics */
+	STATWINDOW *windows;	/**< window of each statistic, in the order of the statistic list */
 	double *statdata;
-	unsigned int price_index;
-	unsigned int64 price_count;
+	unsigned int price_index;	/**< next slot of the history to write */
+	unsigned int64 price_count;	/**< number of markets added to the history */
 	uint32 history_count;
 	// latency market frame queue
 	MARKETFRAME next_frame;
@@ -151,6 +170,8 @@ public:
 private:
 	FILE *trans_file;
 	int64 trans_log_count;
+	TIMESTAMP trans_time;	/**< time of the cached transaction time string */
+	char trans_timestr[64];	/**< time string written for the bids of the current frame */
 	FILE *curve_file;
 	int64 curve_log_count;
 public:
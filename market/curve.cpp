@@ -10,6 +10,7 @@ curve::curve(void)
 	bids = NULL;
 	keys = NULL;
 	bid_ids = NULL;
+	work = NULL;
 	n_bids = 0;
 	total = 0;
 }
@@ -19,6 +20,31 @@ curve::~curve(void)
 	delete [] bids;
 	delete [] keys;
 	delete [] bid_ids;
+	delete [] work;
+}
+
+// the arrays are kept when the curve is cleared so later market frames reuse them
+void curve::grow(void)
+{
+	int newlen = (len==0 ? 8 : len*2);
+	BID *newbids = new BID[newlen];
+	KEY *newkeys = new KEY[newlen];
+	KEY *newbid_ids = new KEY[newlen];
+	if (n_bids>0)
+	{
+		memcpy(newbids,bids,n_bids*sizeof(BID));
+		memcpy(newkeys,keys,n_bids*sizeof(KEY));
+		memcpy(newbid_ids,bid_ids,n_bids*sizeof(KEY));
+	}
+	delete[] bids;
+	delete[] keys;
+	delete[] bid_ids;
+	delete[] work;
+	bids = newbids;
+	keys = newkeys;
+	bid_ids = newbid_ids;
+	work = new KEY[newlen];
+	len = newlen;
 }
 
 void curve::clear(void)
@@ -36,29 +62,8 @@ BID *curve::getbid(KEY n)
 
 KEY curve::submit(BID *bid)
 {
-	if (len==0) // create the bid list
-	{
-		len = 8;
-		bids = new BID[len];
-		keys = new KEY[len];
-		bid_ids = new KEY[len];
-	}
-	else if (n_bids==len) // grow the bid list
-	{
-		BID *newbids = new BID[len*2];
-		KEY *newkeys = new KEY[len*2];
-		KEY *newbid_ids = new KEY[len*2];
-		memcpy(newbids,bids,len*sizeof(BID));
-		memcpy(newkeys,keys,len*sizeof(KEY));
-		memcpy(newbid_ids,bid_ids,len*sizeof(KEY));
-		delete[] bids;
-		delete[] keys;
-		delete[] bid_ids;
-		bids = newbids;
-		keys = newkeys;
-		bid_ids = newbid_ids;
-		len*=2;
-	}
+	if (n_bids==len)
+		grow();
 	keys[n_bids] = n_bids;
 	bid_ids[n_bids] = bid->bid_id;
 	BID *next = bids + n_bids;
@@ -95,29 +100,8 @@ KEY curve::resubmit(BID *bid)
 	}
 	if(bid_hitcount == 0) {
 		gl_warning("The bid was flagged as a rebid but there is no bid in the bid curve with the bid id provided. Submitting the bid.");
-		if (len==0) // create the bid list
-		{
-			len = 8;
-			bids = new BID[len];
-			keys = new KEY[len];
-			bid_ids = new KEY[len];
-		}
-		else if (n_bids==len) // grow the bid list
-		{
-			BID *newbids = new BID[len*2];
-			KEY *newkeys = new KEY[len*2];
-			KEY *newbid_ids = new KEY[len*2];
-			memcpy(newbids,bids,len*sizeof(BID));
-			memcpy(newkeys,keys,len*sizeof(KEY));
-			memcpy(newbid_ids,bid_ids,len*sizeof(KEY));
-			delete[] bids;
-			delete[] keys;
-			delete[] bid_ids;
-			bids = newbids;
-			keys = newkeys;
-			bid_ids = newbid_ids;
-			len*=2;
-		}
+		if (n_bids==len)
+			grow();
 		keys[n_bids] = n_bids;
 		bid_ids[n_bids] = bid->bid_id;
 		BID *next = bids + n_bids;
@@ -195,27 +179,9 @@ int curve::remove_bid(KEY bid_id)
 			break;
 		}
 		total -= old->quantity;
-		/* copy all other bids into new curve */
-		BID *newbids = new BID[len];
-		KEY *newkeys = new KEY[len];
-		KEY *newbid_ids = new KEY[len];
-		for(i = 0; i <= len; i++){
-			if(i < bid_index){
-				newkeys[i] = keys[i];
-				newbids[i] = bids[i];
-				newbid_ids[i] = bid_ids[i];
-			} else if(i>bid_index){
-				newkeys[i-1] = keys[i];
-				newbids[i-1] = bids[i];
-				newbid_ids[i-1] = bid_ids[i];
-			}
-		}
-		delete[] bids;
-		delete[] keys;
-		delete[] bid_ids;
-		bids = newbids;
-		keys = newkeys;
-		bid_ids = newbid_ids;
+		/* close the gap in place - keys are still in submission order until the curve is sorted */
+		memmove(bids+bid_index,bids+bid_index+1,(n_bids-bid_index-1)*sizeof(BID));
+		memmove(bid_ids+bid_index,bid_ids+bid_index+1,(n_bids-bid_index-1)*sizeof(KEY));
 		n_bids--;
 		return n_bids;
 	} else {
@@ -224,20 +190,19 @@ int curve::remove_bid(KEY bid_id)
 }
 void curve::sort(bool reverse)
 {
-	sort(bids, keys, n_bids, reverse);
+	sort(bids, keys, work, n_bids, reverse);
 }
 
-void curve::sort(BID *list, KEY *key, const int len, const bool reverse)
+// merge sort of the keys using the scratch keys instead of a temporary array at each level
+void curve::sort(BID *list, KEY *key, KEY *work, const int len, const bool reverse)
 {
-	//merge sort
 	if (len>1)
 	{
 		int split = len/2;
 		KEY *a = key, *b = key+split;
-		if (split>1) sort(list,a,split,reverse);
-		if (len-split>1) sort(list,b,len-split,reverse);
-		KEY *res = new KEY[len];
-		KEY *p = res;
+		if (split>1) sort(list,a,work,split,reverse);
+		if (len-split>1) sort(list,b,work+split,len-split,reverse);
+		KEY *p = work;
 		do {
 			bool altb = list[*a].price < list[*b].price;
 			if ((reverse && !altb) || (!reverse && altb))
@@ -249,8 +214,7 @@ void curve::sort(BID *list, KEY *key, const int len, const bool reverse)
 			*p++ = *a++;
 		while (b<key+len)
 			*p++ = *b++;
-		memcpy(key,res,sizeof(KEY)*len);
-		delete[] res;
+		memcpy(key,work,sizeof(KEY)*len);
 	}
 }
 
@@ -13,11 +13,13 @@ private:
 	BID *bids;
 	KEY *keys;
 	KEY *bid_ids;
+	KEY *work;	/**< scratch keys used by sort() so clearing does not allocate */
 	double total;
 	double total_on;
 	double total_off;
 private:
-	static void sort(BID *list, KEY *keys, const int len, const bool reverse);
+	void grow(void);
+	static void sort(BID *list, KEY *keys, KEY *work, const int len, const bool reverse);
 public:
 	curve(void);
 	~curve(void);
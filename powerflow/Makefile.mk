@@ -52,6 +52,8 @@ powerflow_powerflow_la_SOURCES += powerflow/motor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/motor.h
 powerflow_powerflow_la_SOURCES += powerflow/node.cpp
 powerflow_powerflow_la_SOURCES += powerflow/node.h
+powerflow_powerflow_la_SOURCES += powerflow/nr_graph.cpp
+powerflow_powerflow_la_SOURCES += powerflow/nr_graph.h
 powerflow_powerflow_la_SOURCES += powerflow/overhead_line_conductor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/overhead_line_conductor.h
 powerflow_powerflow_la_SOURCES += powerflow/overhead_line.cpp
@@ -80,6 +82,8 @@ powerflow_powerflow_la_SOURCES += powerflow/sectionalizer.cpp
 powerflow_powerflow_la_SOURCES += powerflow/sectionalizer.h
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.h
+powerflow_powerflow_la_SOURCES += powerflow/solver_klu.cpp
+powerflow_powerflow_la_SOURCES += powerflow/solver_klu.h
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.cpp
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.h
 powerflow_powerflow_la_SOURCES += powerflow/substation.cpp
@@ -36,6 +36,7 @@ fault_check::fault_check(MODULE *mod) : powerflow_object(mod)
 			PT_bool,"strictly_radial",PADDR(reliability_search_mode),PT_DESCRIPTION,"Flag to indicate if a system is known to be strictly radial -- uses radial assumptions for reliability alterations",
 			PT_bool,"full_output_file",PADDR(full_print_output),PT_DESCRIPTION,"Flag to indicate if the output_filename report contains both supported and unsupported nodes -- if false, just does unsupported",
 			PT_bool,"grid_association",PADDR(grid_association_mode),PT_DESCRIPTION,"Flag to indicate if multiple, distinct grids are allowed in a GLM, or if anything not attached to the master swing is removed",
+			PT_bool,"parallel_traversal",PADDR(parallel_traversal),PT_DESCRIPTION,"Flag to search the grids of different SWING buses in parallel when grid_association is set -- uses the powerflow::NR_stamp_procs threads",
 			PT_object,"eventgen_object",PADDR(rel_eventgen),PT_DESCRIPTION,"Link to generic eventgen object to handle unexpected faults",
 			NULL) < 1) GL_THROW("unable to publish properties in %s",__FILE__);
 			if (gl_publish_function(oclass,"reliability_alterations",(FUNCTIONADDR)powerflow_alterations)==NULL)
@@ -73,6 +74,17 @@ int fault_check::create(void)
 
 	grid_association_mode = false;	//By default, we go to normal "Highlander" grid (there can be only one!)
 
+	parallel_traversal = false;	//By default, grids are searched one at a time
+
+	support_link_phases = NULL;	//Support forest is allocated on the first check
+	support_source_phases = NULL;
+	support_parent = NULL;
+	support_stack = NULL;
+	support_cleared = NULL;
+	support_queued = NULL;
+	support_stack_size = 0;
+	support_forest_mode = -1;
+
 	return result;
 }
 
@@ -344,314 +356,345 @@ TIMESTAMP fault_check::sync(TIMESTAMP t0)
 }
 
 
-void fault_check::search_links(int node_int)
+void fault_check::support_check(int swing_node_int)
 {
-	unsigned int index, indexb;
-	bool both_handled, from_val, first_resto, proceed_in;
-	int branch_val;
-	BRANCHDATA temp_branch;
-	unsigned char work_phases;
+	//Bring the support forest up to date - only the parts affected by link changes are traversed
+	update_support(swing_node_int,-99);
+}
 
-	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
-	{
-		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
+//Mesh-capable version of support check -- by default, it doesn't support restoration object
+void fault_check::support_check_mesh(int swing_node_int)
+{
+	//Same forest, the link and source masks account for the mesh rules
+	update_support(swing_node_int,-99);
+}
+
+//Phases a link can pass support across -- radial checks go by the current link phases, meshed checks
+//also pass the original phases of anything that isn't an open switch
+unsigned char fault_check::support_link_mask(int branch_idx)
+{
+	unsigned char temp_phases;
 
-		first_resto = false;		//Flag that restoration hasn't gone off
-		proceed_in = false;			//Flag that we need to go the next link in
+	temp_phases = NR_branchdata[branch_idx].phases;
 
-		//Check for no phase condition
-		if ((temp_branch.phases & 0x07) != 0x00)
+	if (reliability_search_mode == false)	//Meshed
+	{
+		//Are we a switch
+		if ((NR_branchdata[branch_idx].lnk_type == 2) || (NR_branchdata[branch_idx].lnk_type == 5) || (NR_branchdata[branch_idx].lnk_type == 6))
 		{
-			for (indexb=0; indexb<3; indexb++)	//Handle phases
+			if (*NR_branchdata[branch_idx].status == 1)
 			{
-				work_phases = 0x04 >> indexb;	//Pull off the phase reference
+				temp_phases |= NR_branchdata[branch_idx].origphases;
+			}
+		}
+		else
+		{
+			temp_phases |= NR_branchdata[branch_idx].origphases;
+		}
+	}
 
-				if ((temp_branch.phases & work_phases) == work_phases)	//We are of the proper phase
-				{
-					both_handled = false;	//Reset flag
+	return (temp_phases & 0x07);
+}
 
-					//See which end we are, and if the other end has been handled
-					if (temp_branch.from == node_int)	//We're the from
-					{
-						from_val = true;	//Flag us as the from end (so we don't have to check it again later)
-					}
-					else	//Must be the to
-					{
-						from_val = false;	//Flag us as the to end (so we don't have to check it again later)
-					}
+//Phases a node supplies on its own -- the swing, or any source when grids are associated
+unsigned char fault_check::support_source_mask(int node_int, int swing_node_int)
+{
+	if ((reliability_search_mode == false) && (grid_association_mode == true))
+	{
+		//See if we're a SWING node, of some form
+		if ((NR_busdata[node_int].type == 2) || ((NR_busdata[node_int].type == 3) && (NR_busdata[node_int].swing_functions_enabled == true)) || ((*NR_busdata[node_int].busflag & NF_ISSOURCE) == NF_ISSOURCE))
+			return (NR_busdata[node_int].phases & 0x07);
+		else
+			return 0x00;
+	}
+	else if (node_int == swing_node_int)
+	{
+		return (NR_busdata[node_int].phases & 0x07);
+	}
+	else
+	{
+		return 0x00;
+	}
+}
 
-					//See if both sides of this link are already set - if so, don't bother going back in
-					if ((Supported_Nodes[temp_branch.to][indexb]==1) && (Supported_Nodes[temp_branch.from][indexb]==1))
-						both_handled=true;
+//Compare one link against the forest, clearing what it no longer supplies and queueing what it can now pass on
+unsigned int fault_check::support_update_link(int branch_idx, unsigned int cleared_size)
+{
+	unsigned int indexb;
+	unsigned char new_phases, lost_phases, work_phases;
 
-					//If not handled, proceed with logic-ness
-					if (both_handled==false)
-					{
-						//Figure out the indexing so we can tell what we are
-						if (from_val)	//From end
-						{
-							branch_val = temp_branch.to;
+	new_phases = support_link_mask(branch_idx);
 
-							//See if our FROM end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.from][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
-						else	//To end
-						{
-							branch_val = temp_branch.from;
+	if (new_phases == support_link_phases[branch_idx])
+		return cleared_size;
 
-							//See if our TO end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.to][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
+	lost_phases = support_link_phases[branch_idx] & ~new_phases;
+	support_link_phases[branch_idx] = new_phases;
 
-						//Flag us as connected
-						Supported_Nodes[branch_val][indexb] = 1;
+	//Phases lost on a link the forest uses cut off everything below it
+	for (indexb=0; indexb<3; indexb++)
+	{
+		work_phases = 0x04 >> indexb;
 
-					}//End both not handled (work to be done)
-				}//End are a proper phase
-			}//End phase testloop
+		if ((lost_phases & work_phases) == work_phases)
+		{
+			if (((valid_phases[NR_branchdata[branch_idx].to] & work_phases) == work_phases) && (support_parent[3*NR_branchdata[branch_idx].to+indexb] == branch_idx))
+				cleared_size = support_clear_subtree(NR_branchdata[branch_idx].to,indexb,cleared_size);
+			else if (((valid_phases[NR_branchdata[branch_idx].from] & work_phases) == work_phases) && (support_parent[3*NR_branchdata[branch_idx].from+indexb] == branch_idx))
+				cleared_size = support_clear_subtree(NR_branchdata[branch_idx].from,indexb,cleared_size);
+			//Default else -- not a forest link, nothing depends on it
+		}
+	}
 
-			if (proceed_in)
-			{
-				//Recursion!!
-				search_links(branch_val);
-			}
-		}//End has phases test loop
-	}//End link table loop
+	//Phases gained can be passed on from either end
+	if ((new_phases & ~lost_phases) != 0x00)
+	{
+		support_push(NR_branchdata[branch_idx].from);
+		support_push(NR_branchdata[branch_idx].to);
+	}
+
+	return cleared_size;
 }
 
-//Mesh searching function -- checks to see how something was removed
-void fault_check::search_links_mesh(int node_int)
+//baselink_int is the link an alteration changed -- negative (swing faults, sync checks) scans every link and source instead
+void fault_check::update_support(int swing_node_int, int baselink_int)
 {
-	unsigned int index, device_value, node_value;
-	unsigned char temp_phases, temp_compare_phases;
+	unsigned int indexa, cleared_size, entry;
+	int node_value, device_value, phase_mode;
+	NR_GRAPH *graph;
 
-	//Check our entry mode -- if grid association mode, do this as a recursion
-	if (grid_association_mode == false)	//Nope, do "normally"
+	//Allocate the forest on first use
+	if (support_parent == NULL)
 	{
-		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+		support_link_phases = (unsigned char*)gl_malloc(NR_branch_count*sizeof(unsigned char));
+		support_source_phases = (unsigned char*)gl_malloc(NR_bus_count*sizeof(unsigned char));
+		support_parent = (int*)gl_malloc(3*NR_bus_count*sizeof(int));
+		support_stack = (int*)gl_malloc(NR_bus_count*sizeof(int));
+		support_cleared = (int*)gl_malloc(3*NR_bus_count*sizeof(int));
+		support_queued = (unsigned char*)gl_malloc(NR_bus_count*sizeof(unsigned char));
+
+		if (valid_phases == NULL)
 		{
-			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
+			valid_phases = (unsigned char*)gl_malloc(NR_bus_count*sizeof(unsigned char));
+		}
 
-			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].to;
-			}
-			else	//Must be the TO side, so check from
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].from;
-			}
+		if ((support_link_phases == NULL) || (support_source_phases == NULL) || (support_parent == NULL) || (support_stack == NULL) || (support_cleared == NULL) || (support_queued == NULL) || (valid_phases == NULL))
+		{
+			GL_THROW("fault_check: support forest allocation failure");
+			/*  TROUBLESHOOT
+			The fault_check object has failed to allocate the arrays used to track node support.  Please try
+			again and if the problem persists, submit your code and a bug report via the trac website.
+			*/
+		}
 
-			//Get initial phasing information - the ones that are available
-			temp_phases = NR_branchdata[device_value].phases;
+		support_forest_mode = -1;
+	}
 
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
-			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 2) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else
-				{
-					temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-				}
-			}
+	//See if the forest was built for a different search mode
+	phase_mode = (reliability_search_mode == true) ? 1 : 0;
+	if (support_forest_mode != phase_mode)
+	{
+		rebuild_support(swing_node_int);
+		return;
+	}
 
-			//Populate the phase information
-			valid_phases[node_value] |= (valid_phases[node_int] & temp_phases);
-		}//End of node link table traversion
-	}//End not grid association mode
-	else	//Grid association mode
+	//Any change in the sources means a rebuild -- these are rare
+	if ((baselink_int >= 0) && (grid_association_mode == false))
 	{
-		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+		//Only the swing can source anything, so it is the only one that can have changed
+		if (support_source_mask(swing_node_int,swing_node_int) != support_source_phases[swing_node_int])
 		{
-			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
-
-			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].to;
-			}
-			else	//Must be the TO side, so check from
+			rebuild_support(swing_node_int);
+			return;
+		}
+	}
+	else	//Unknown change, or any node may be a source -- check them all
+	{
+		for (indexa=0; indexa<NR_bus_count; indexa++)
+		{
+			if (support_source_mask(indexa,swing_node_int) != support_source_phases[indexa])
 			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].from;
+				rebuild_support(swing_node_int);
+				return;
 			}
+		}
+	}
 
-			//Get initial phasing information - the ones that are available
-			temp_phases = NR_branchdata[device_value].phases;
+	//Find the links that changed since the last update
+	if (baselink_int >= 0)
+	{
+		//Only the altered link
+		cleared_size = support_update_link(baselink_int,0);
+	}
+	else	//Fallback - check them all
+	{
+		cleared_size = 0;
+		for (indexa=0; indexa<NR_branch_count; indexa++)
+		{
+			cleared_size = support_update_link(indexa,cleared_size);
+		}
+	}
 
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
-			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 2) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else
-				{
-					temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-				}
-			}
+	//Anything still supported next to a cut-off part may be able to reach back in
+	graph = nr_graph_get();
+	for (indexa=0; indexa<cleared_size; indexa++)
+	{
+		node_value = support_cleared[indexa];
 
-			//Check our "contributions" against the other end - use this to determine recursion
-			temp_compare_phases = (valid_phases[node_value] | (valid_phases[node_int] & temp_phases));
+		for (entry=graph->start[node_value]; entry<graph->start[node_value+1]; entry++)
+		{
+			device_value = graph->link[entry];
 
-			//See if it is the same
-			if (valid_phases[node_value] != temp_compare_phases)
-			{
-				//Populate the phase information - store what we just did (no point doing twice)
-				valid_phases[node_value] = temp_compare_phases;
+			if ((valid_phases[NR_branchdata[device_value].from] & support_link_phases[device_value] & ~valid_phases[node_value]) != 0x00)
+				support_push(NR_branchdata[device_value].from);
+			if ((valid_phases[NR_branchdata[device_value].to] & support_link_phases[device_value] & ~valid_phases[node_value]) != 0x00)
+				support_push(NR_branchdata[device_value].to);
+		}
+	}
 
-				//Recurse in, do this node now
-				search_links_mesh(node_value);
-			}
-			//Default else -- they match, so don't bother
-		}//End of node link table traversion
-	}//End grid association mode
+	support_propagate();
 }
 
-void fault_check::support_check(int swing_node_int)
+void fault_check::rebuild_support(int swing_node_int)
 {
 	unsigned int index;
-	unsigned char phase_vals;
 
-	//Reset the node status list
-	reset_support_check();
+	support_stack_size = 0;
 
-	//Swing node has support - if the phase exists (changed for complete faults)
-	for (index=0; index<3; index++)
+	//Everything starts unsupported, apart from the sources
+	for (index=0; index<NR_bus_count; index++)
+	{
+		support_parent[3*index] = support_parent[3*index+1] = support_parent[3*index+2] = -1;
+		support_queued[index] = 0;
+		support_source_phases[index] = support_source_mask(index,swing_node_int);
+		valid_phases[index] = support_source_phases[index];
+
+		if (valid_phases[index] != 0x00)
+			support_push(index);
+	}
+
+	for (index=0; index<NR_branch_count; index++)
 	{
-		phase_vals = 0x04 >> index;	//Set up phase value
+		support_link_phases[index] = support_link_mask(index);
+	}
+
+	support_propagate();
 
-		if ((NR_busdata[swing_node_int].phases & phase_vals) == phase_vals)	//Has this phase
-			Supported_Nodes[swing_node_int][index] = 1;	//Flag it as supported
+	//Unreached nodes weren't touched by the propagation
+	for (index=0; index<NR_bus_count; index++)
+	{
+		support_flag_node(index);
 	}
 
-	//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
-	search_links(swing_node_int);
+	support_forest_mode = (reliability_search_mode == true) ? 1 : 0;
 }
 
-//Mesh-capable version of support check -- by default, it doesn't support restoration object
-void fault_check::support_check_mesh(int swing_node_int)
+//Remove one phase of support from a node and everything that got it through that node
+//Cleared nodes are appended to support_cleared, which doubles as the search queue
+unsigned int fault_check::support_clear_subtree(int node_int, int phase_idx, unsigned int cleared_size)
 {
-	unsigned int indexa, indexb;
+	unsigned int indexa, entry;
+	int node_value, device_value, other_value;
+	unsigned char work_phases;
+	NR_GRAPH *graph = nr_graph_get();
+
+	work_phases = 0x04 >> phase_idx;
 
-	//Reset the node status list
-	reset_support_check();
+	//Flag the top of the subtree
+	valid_phases[node_int] &= ~work_phases;
+	support_parent[3*node_int+phase_idx] = -1;
+	support_flag_node(node_int);
+	support_cleared[cleared_size++] = node_int;
 
-	if (grid_association_mode == false)	//Not needing to do grid association, use normal, inefficient method
+	for (indexa=cleared_size-1; indexa<cleared_size; indexa++)
 	{
-		//Swing node has support - if the phase exists (changed for complete faults)
-		valid_phases[swing_node_int] = NR_busdata[swing_node_int].phases & 0x07;
+		node_value = support_cleared[indexa];
 
-		//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
-		//Supports possibly meshed topology - brute force method
-		for (indexa=0; indexa<NR_bus_count; indexa++)
+		for (entry=graph->start[node_value]; entry<graph->start[node_value+1]; entry++)
 		{
-			for (indexb=0; indexb<NR_bus_count; indexb++)
+			device_value = graph->link[entry];
+			other_value = graph->other[entry];
+
+			//See if the other end got this phase from us
+			if (((valid_phases[other_value] & work_phases) == work_phases) && (support_parent[3*other_value+phase_idx] == device_value))
 			{
-				//Call the search link on individual nodes
-				search_links_mesh(indexb);
+				valid_phases[other_value] &= ~work_phases;
+				support_parent[3*other_value+phase_idx] = -1;
+				support_flag_node(other_value);
+				support_cleared[cleared_size++] = other_value;
 			}
 		}
 	}
-	else	//Grid association mode, do slightly different
+
+	return cleared_size;
+}
+
+void fault_check::support_push(int node_int)
+{
+	if (support_queued[node_int] == 0)
+	{
+		support_queued[node_int] = 1;
+		support_stack[support_stack_size++] = node_int;
+	}
+}
+
+//Pass support across links until nothing new is reached
+void fault_check::support_propagate(void)
+{
+	unsigned int entry, indexb;
+	int node_int, device_value, node_value;
+	unsigned char new_phases;
+	NR_GRAPH *graph = nr_graph_get();
+
+	while (support_stack_size > 0)
 	{
-		//Traverse the whole bus list, just in case (since may be altered in the future)
-		for (indexa=0; indexa<NR_bus_count; indexa++)
+		node_int = support_stack[--support_stack_size];
+		support_queued[node_int] = 0;
+
+		for (entry=graph->start[node_int]; entry<graph->start[node_int+1]; entry++)
 		{
-			//See if we're a SWING node
-			if ((NR_busdata[indexa].type == 2) || ((NR_busdata[indexa].type == 3) && (NR_busdata[indexa].swing_functions_enabled == true)) || ((*NR_busdata[indexa].busflag & NF_ISSOURCE) == NF_ISSOURCE))	//SWING node, of some form
+			//Pull link index and opposite end -- just for readabiiity
+			device_value = graph->link[entry];
+			node_value = graph->other[entry];
+
+			//See what we can give them that they don't have
+			new_phases = valid_phases[node_int] & support_link_phases[device_value] & ~valid_phases[node_value];
+
+			if (new_phases != 0x00)
 			{
-				//Check and see if we've apparently been "sourced" before
-				if ((NR_busdata[indexa].phases & 0x07) != valid_phases[indexa])	//We don't match, so something came to us, but not the other way
+				for (indexb=0; indexb<3; indexb++)
 				{
-					//Extract our phases
-					valid_phases[indexa] |= (NR_busdata[indexa].phases & 0x07);
-
-					//Call the support check
-					search_links_mesh(indexa);
+					if ((new_phases & (0x04 >> indexb)) != 0x00)
+						support_parent[3*node_value+indexb] = device_value;
 				}
-				//Default else -- we were already handled
+
+				valid_phases[node_value] |= new_phases;
+				support_flag_node(node_value);
+				support_push(node_value);
 			}
-			//Default else -- not a swing
 		}
 	}
 }
 
-void fault_check::reset_support_check(void)
+//Keep the radial support matrix in step -- 0 = unsupported, 1 = supported, 2 = N/A (no phase there)
+void fault_check::support_flag_node(int node_int)
 {
 	unsigned int index;
+	unsigned char work_phases;
 
-	//Reset the node - 0 = unsupported, 1 = supported (not populated here), 2 = N/A (no phase there)
-	for (index=0; index<NR_bus_count; index++)
-	{
-		if (reliability_search_mode == true)	//Strictly radial
-		{
-			if ((NR_busdata[index].origphases & 0x04) == 0x04)	//Phase A
-			{
-				Supported_Nodes[index][0] = 0;	//Flag as unsupported initially
-			}
-			else
-			{
-				Supported_Nodes[index][0] = 2;	//N/A phase
-			}
+	if (Supported_Nodes == NULL)
+		return;
 
-			if ((NR_busdata[index].origphases & 0x02) == 0x02)	//Phase B
-			{
-				Supported_Nodes[index][1] = 0;	//Flag as unsupported initially
-			}
-			else
-			{
-				Supported_Nodes[index][1] = 2;	//N/A phase
-			}
+	for (index=0; index<3; index++)
+	{
+		work_phases = 0x04 >> index;
 
-			if ((NR_busdata[index].origphases & 0x01) == 0x01)	//Phase C
-			{
-				Supported_Nodes[index][2] = 0;	//Flag as unsupported initially
-			}
-			else
-			{
-				Supported_Nodes[index][2] = 2;	//N/A phase
-			}
-		}
-		else	//Maybe-sort-not-really radial
-		{
-			//Set main variable
-			valid_phases[index] = 0x00;
-		}
+		if ((valid_phases[node_int] & work_phases) == work_phases)
+			Supported_Nodes[node_int][index] = 1;
+		else if ((NR_busdata[node_int].origphases & work_phases) == work_phases)
+			Supported_Nodes[node_int][index] = 0;
+		else
+			Supported_Nodes[node_int][index] = 2;
 	}
 }
 
@@ -947,7 +990,7 @@ void fault_check::write_output_file(TIMESTAMP tval, double tval_delta)
 //Function to traverse powerflow and remove/restore now unsupported objects' phases (so NR solves happy)
 void fault_check::support_check_alterations(int baselink_int, bool rest_mode)
 {
-	int base_bus_val, return_val;
+	int base_bus_val, return_val, support_link_int;
 	double delta_ts_value;
 	TIMESTAMP event_ts_value;
 
@@ -987,7 +1030,7 @@ void fault_check::support_check_alterations(int baselink_int, bool rest_mode)
 
 			if ((NR_busdata[base_bus_val].phases & 0x07) != 0x00)	//We have phase, means OK above us
 			{
-				//Recurse our way in - adjusted version of original search_links function above (but no storage, because we don't care now)
+				//Recurse our way in - radial walk from the altered bus (no storage, because we don't care now)
 				support_search_links(base_bus_val, base_bus_val, rest_mode);
 			}
 			else
@@ -997,12 +1040,15 @@ void fault_check::support_check_alterations(int baselink_int, bool rest_mode)
 		{
 			gl_verbose("Alterations support check called removal on bus %s",NR_busdata[base_bus_val].name);
 
-			//Recurse our way in - adjusted version of original search_links function above (but no storage, because we don't care now)
+			//Recurse our way in - radial walk from the altered bus (no storage, because we don't care now)
 			support_search_links(base_bus_val, base_bus_val, rest_mode);
 		}
 	}
 	else	//Not assumed to be strictly radial, or just being safe -- check EVERYTHING
 	{
+		//Link the support forest needs to recheck -- swing and initial faults check them all
+		support_link_int = (baselink_int < 0) ? -99 : baselink_int;
+
 		//See if we should even go in first
 		if (restoration_checks_active == false)
 		{
@@ -1012,6 +1058,9 @@ void fault_check::support_check_alterations(int baselink_int, bool rest_mode)
 				//Call restoration -- fault_checks will occur as part of this
 				return_val = ((int (*)(OBJECT *,int))(*restoration_fxn))(restoration_object,baselink_int);
 
+				//Any link may have been switched, so the support check can't just look at ours
+				support_link_int = -99;
+
 				//Make sure it worked
 				if (return_val != 1)
 				{
@@ -1037,7 +1086,11 @@ void fault_check::support_check_alterations(int baselink_int, bool rest_mode)
 
 		//Call a support check -- reset handled inside
 		//Always assumed to NOT be in "restoration object" mode
-		support_check_mesh(0);
+		//Only the altered link needs checking, unless restoration just reconfigured things on us
+		if (support_link_int == -99)
+			support_check_mesh(0);
+		else
+			update_support(0,support_link_int);
 
 		//Now loop through and remove those components that are not supported anymore -- start from SWING, just because we have to start somewhere
 		support_search_links_mesh(baselink_int,rest_mode);
@@ -1431,254 +1484,274 @@ void fault_check::special_object_alteration_handle(int branch_idx)
 	}//End "normal" reliability operations
 }
 
-//Recursive function to traverse powerflow and alter phases as necessary
-//Based on search_links code from above
+//Walks powerflow and alters phases as necessary
+//Radial walk from the altered bus, removing or restoring phases as it goes
 void fault_check::support_search_links(int node_int, int node_start, bool impact_mode)
 {
-	unsigned int index;
+	FCHECK_SEARCH search;
+	NR_GRAPH_STACK stack;
+	NR_GRAPH *graph = nr_graph_get();
+
+	search.fcheck = this;
+	search.graph = graph;
+	search.node_start = node_start;
+	search.impact_mode = impact_mode;
+
+	//Explicit stack - long feeders are too deep to recurse down
+	nr_graph_stack_init(graph,&stack);
+	nr_graph_depth_first(graph,node_int,support_search_visit,&search,0,&stack);
+	nr_graph_stack_free(&stack);
+}
+
+bool fault_check::support_search_visit(void *data, unsigned int root_idx, int bus, unsigned int entry)
+{
+	FCHECK_SEARCH *search = (FCHECK_SEARCH*)data;
+
+	return search->fcheck->support_search_link(bus,search->node_start,search->impact_mode,entry - search->graph->start[bus]);
+}
+
+//Removes or restores phases across one link of a node -- returns true if the other end needs to be walked
+bool fault_check::support_search_link(int node_int, int node_start, bool impact_mode, unsigned int index)
+{
 	bool both_handled, from_val;
 	int branch_val;
-	BRANCHDATA temp_branch;
+	BRANCHDATA *temp_branch;
 	unsigned char work_phases, phase_restrictions;
 
-	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
+	temp_branch = &NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
+
+	both_handled = false;	//Reset flag
+
+	//See which end we are, and if the other end has been handled
+	if (temp_branch->from == node_int)	//We're the from
+	{
+		from_val = true;	//Flag us as the from end (so we don't have to check it again later)
+	}
+	else	//Must be the to
 	{
-		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
+		from_val = false;	//Flag us as the to end (so we don't have to check it again later)
+	}
 
-		both_handled = false;	//Reset flag
+	if ((node_int == node_start) && (from_val == false))	//We're the TO side of the base node, Oh Noes!
+	{
+		Alteration_Nodes[temp_branch->from] = 1;	//Flag us to prevent future issues (not sure how they'd happen)
+		return false;	//Nothing to do with this link, so I hereby render this iteration useless and proceed to skip it
+	}
+	else	//FROM side of any, or not the TO side as the base node
+	{
+		//See if both sides of this link are already set - if so, don't bother going back in
+		if ((Alteration_Nodes[temp_branch->to]==1) && (Alteration_Nodes[temp_branch->from]==1))
+			both_handled=true;
+	}
 
-		//See which end we are, and if the other end has been handled
-		if (temp_branch.from == node_int)	//We're the from
-		{
-			from_val = true;	//Flag us as the from end (so we don't have to check it again later)
-		}
-		else	//Must be the to
-		{
-			from_val = false;	//Flag us as the to end (so we don't have to check it again later)
-		}
+	//Already handled - nothing to do with this link
+	if (both_handled==true)
+		return false;
 
-		if ((node_int == node_start) && (from_val == false))	//We're the TO side of the base node, Oh Noes!
-		{
-			Alteration_Nodes[temp_branch.from] = 1;	//Flag us to prevent future issues (not sure how they'd happen)
-			continue;	//Nothing to do with this link, so I hereby render this iteration useless and proceed to skip it
-		}
-		else	//FROM side of any, or not the TO side as the base node
-		{
-			//See if both sides of this link are already set - if so, don't bother going back in
-			if ((Alteration_Nodes[temp_branch.to]==1) && (Alteration_Nodes[temp_branch.from]==1))
-				both_handled=true;
-		}
+	//Figure out the indexing so we can tell what we are
+	if (from_val)	//From end
+	{
+		branch_val = temp_branch->to;
 
-		//If not handled, proceed with logic-ness
-		if (both_handled==false)
+		if (impact_mode == false)	//Removal time
 		{
-			//Figure out the indexing so we can tell what we are
-			if (from_val)	//From end
+			//Make sure our FROM end is valid first - just in case
+			if (Alteration_Nodes[temp_branch->from] == 1)
 			{
-				branch_val = temp_branch.to;
+				//Remove our phase portions - determine by our FROM end
+				work_phases = NR_busdata[temp_branch->from].phases & 0x07;
 
-				if (impact_mode == false)	//Removal time
+				//See if we are split-phase
+				if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
 				{
-					//Make sure our FROM end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.from] == 1)
+					//See if any support exists
+					if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & work_phases) == 0x00)	//no longer any support
 					{
-						//Remove our phase portions - determine by our FROM end
-						work_phases = NR_busdata[temp_branch.from].phases & 0x07;
-
-						//See if we are split-phase
-						if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
-						{
-							//See if any support exists
-							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & work_phases) == 0x00)	//no longer any support
-							{
-								//Just remove it all
-								NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases = 0x00;
-							}
-							//Defaulted else - do nothing
-						}
-						else	//Not split-phase, normal - continue
-						{
-							//Remove components - USBs are typically node oriented, so they aren't included here
-							NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases &= work_phases;
-						}
-
-						//Now apply the phases on the TO end of this branch - first off, get base phases - D is omitted (D unsupported for now)
-						work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+						//Just remove it all
+						NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases = 0x00;
+					}
+					//Defaulted else - do nothing
+				}
+				else	//Not split-phase, normal - continue
+				{
+					//Remove components - USBs are typically node oriented, so they aren't included here
+					NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases &= work_phases;
+				}
 
-						//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-						if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
-						{
-							work_phases |= 0xE0;	//SP, House?, To SPCT - flagged on
-						}
-						else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
-						{
-							work_phases |= 0x18;	//House?, D
-						}
+				//Now apply the phases on the TO end of this branch - first off, get base phases - D is omitted (D unsupported for now)
+				work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
 
-						//Apply the change to the TO node
-						NR_busdata[temp_branch.to].phases &= work_phases;
-					}//End FROM end is valid
-					else	//FROM end not valid - hope we get hit by something else later
-					{
-						continue;
-					}
-				}//end FROM removal
-				else	//Restoration time
+				//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
+				if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
 				{
-					//Make sure our FROM end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.from] == 1)
-					{
-						//Now see if we can even proceed - if we are a fault blocked area, then go no lower
-						phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
+					work_phases |= 0xE0;	//SP, House?, To SPCT - flagged on
+				}
+				else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
+				{
+					work_phases |= 0x18;	//House?, D
+				}
 
-						phase_restrictions &= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0x07);	//Mask this with what we used to be
+				//Apply the change to the TO node
+				NR_busdata[temp_branch->to].phases &= work_phases;
+			}//End FROM end is valid
+			else	//FROM end not valid - hope we get hit by something else later
+			{
+				return false;
+			}
+		}//end FROM removal
+		else	//Restoration time
+		{
+			//Make sure our FROM end is valid first - just in case
+			if (Alteration_Nodes[temp_branch->from] == 1)
+			{
+				//Now see if we can even proceed - if we are a fault blocked area, then go no lower
+				phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
 
-						if (phase_restrictions == 0x00)	//No phases are available below here, go to next
-						{
-							continue;
-						}
-						else	//At least one phase is valid, proceed
-						{
-							//Restore our phase portions - determine by our FROM end and restrictions
-							work_phases = NR_busdata[temp_branch.from].phases & phase_restrictions;
+				phase_restrictions &= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0x07);	//Mask this with what we used to be
 
-							if ((temp_branch.origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
-							{
-								if (work_phases != 0x00)
-									work_phases |= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0xE0);	//Mask in SPCT-type flags
-							}
+				if (phase_restrictions == 0x00)	//No phases are available below here, go to next
+				{
+					return false;
+				}
+				else	//At least one phase is valid, proceed
+				{
+					//Restore our phase portions - determine by our FROM end and restrictions
+					work_phases = NR_busdata[temp_branch->from].phases & phase_restrictions;
 
-							//Restore components - USBs are typically node oriented, so they aren't explicitly included here
-							NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases |= work_phases;
+					if ((temp_branch->origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
+					{
+						if (work_phases != 0x00)
+							work_phases |= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0xE0);	//Mask in SPCT-type flags
+					}
 
-							//Now apply the phases on the TO end of this branch - first off, get base phases
-							work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+					//Restore components - USBs are typically node oriented, so they aren't explicitly included here
+					NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases |= work_phases;
 
-							//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
-							{
-								work_phases |= (NR_busdata[temp_branch.to].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
-							}
-							else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
-							{
-								work_phases |= (NR_busdata[temp_branch.to].origphases & 0x18);	//D
-							}
+					//Now apply the phases on the TO end of this branch - first off, get base phases
+					work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
 
-							//Apply the change to the TO node
-							NR_busdata[temp_branch.to].phases |= work_phases;
-						}
-					}//End FROM end is valid
-					else	//FROM end not valid - hope we get hit by something else later
+					//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
+					if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
 					{
-						continue;
+						work_phases |= (NR_busdata[temp_branch->to].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
 					}
-				}//End TO end restoration
-			}//End FROM end
-			else	//To end
-			{
-				branch_val = temp_branch.from;
-
-				if (impact_mode == false)	//Removal time
-				{
-					//Make sure our TO end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.to] == 1)	//Implies TO is done, but not FROM.  Basically indicates reverse flow or a mesh - not necessarily good (solver won't care)
+					else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
 					{
-						//Remove our phase portions - determine by our TO end
-						work_phases = NR_busdata[temp_branch.to].phases & 0x07;
+						work_phases |= (NR_busdata[temp_branch->to].origphases & 0x18);	//D
+					}
 
-						if ((temp_branch.phases & 0x80) == 0x80)	//See if we are split phase - if so and no phases are present, remove that too for good measure
-						{
-							if (work_phases != 0x00)
-								work_phases |= 0xA0;	//Add in the split phase flag
-						}
+					//Apply the change to the TO node
+					NR_busdata[temp_branch->to].phases |= work_phases;
+				}
+			}//End FROM end is valid
+			else	//FROM end not valid - hope we get hit by something else later
+			{
+				return false;
+			}
+		}//End TO end restoration
+	}//End FROM end
+	else	//To end
+	{
+		branch_val = temp_branch->from;
+
+		if (impact_mode == false)	//Removal time
+		{
+			//Make sure our TO end is valid first - just in case
+			if (Alteration_Nodes[temp_branch->to] == 1)	//Implies TO is done, but not FROM.  Basically indicates reverse flow or a mesh - not necessarily good (solver won't care)
+			{
+				//Remove our phase portions - determine by our TO end
+				work_phases = NR_busdata[temp_branch->to].phases & 0x07;
 
-						//Remove components - USBs are typically node oriented, so they aren't included here
-						NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases &= work_phases;
+				if ((temp_branch->phases & 0x80) == 0x80)	//See if we are split phase - if so and no phases are present, remove that too for good measure
+				{
+					if (work_phases != 0x00)
+						work_phases |= 0xA0;	//Add in the split phase flag
+				}
 
-						//Now apply the phases on the FROM end of this branch - first off, get base phases - D is omitted (D unsupported for now)
-						work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+				//Remove components - USBs are typically node oriented, so they aren't included here
+				NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases &= work_phases;
 
-						//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-						if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
-						{
-							work_phases |= 0xE0;	//SP, House?, To SPCT - flagged on
-						}
-						else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
-						{
-							work_phases |= 0x18;	//House?, D
-						}
+				//Now apply the phases on the FROM end of this branch - first off, get base phases - D is omitted (D unsupported for now)
+				work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
 
-						//Apply the change to the FROM node
-						NR_busdata[temp_branch.from].phases &= work_phases;
-					}//End TO end is valid
-					else	//TO end not valid - hope we get hit by something else later
-					{
-						continue;
-					}
-				}//End removal - FROM end
-				else	//Restoration time
+				//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
+				if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
 				{
-					//Make sure our TO end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.to] == 1)
-					{
-						//Now see if we can even proceed - if we are a fault blocked area, then go no lower
-						phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
+					work_phases |= 0xE0;	//SP, House?, To SPCT - flagged on
+				}
+				else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
+				{
+					work_phases |= 0x18;	//House?, D
+				}
 
-						phase_restrictions &= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0x07);	//Mask this with what we used to be
+				//Apply the change to the FROM node
+				NR_busdata[temp_branch->from].phases &= work_phases;
+			}//End TO end is valid
+			else	//TO end not valid - hope we get hit by something else later
+			{
+				return false;
+			}
+		}//End removal - FROM end
+		else	//Restoration time
+		{
+			//Make sure our TO end is valid first - just in case
+			if (Alteration_Nodes[temp_branch->to] == 1)
+			{
+				//Now see if we can even proceed - if we are a fault blocked area, then go no lower
+				phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
 
-						if (phase_restrictions == 0x00)	//No phases are available below here, go to next
-						{
-							continue;
-						}
-						else	//At least one phase is valid, proceed
-						{
-							//Restore our phase portions - determine by our TO end and restrictions
-							work_phases = NR_busdata[temp_branch.to].phases & phase_restrictions;
+				phase_restrictions &= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0x07);	//Mask this with what we used to be
 
-							if ((temp_branch.origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
-							{
-								if (work_phases != 0x00)
-									work_phases |= 0x80;	//Add in the split phase flag
-							}
+				if (phase_restrictions == 0x00)	//No phases are available below here, go to next
+				{
+					return false;
+				}
+				else	//At least one phase is valid, proceed
+				{
+					//Restore our phase portions - determine by our TO end and restrictions
+					work_phases = NR_busdata[temp_branch->to].phases & phase_restrictions;
 
-							//Restore components - USBs are typically node oriented, so they aren't explicitly included here
-							NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases |= work_phases;
+					if ((temp_branch->origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
+					{
+						if (work_phases != 0x00)
+							work_phases |= 0x80;	//Add in the split phase flag
+					}
 
-							//Now apply the phases on the TO end of this branch - first off, get base phases
-							work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+					//Restore components - USBs are typically node oriented, so they aren't explicitly included here
+					NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases |= work_phases;
 
-							//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
-							{
-								work_phases |= (NR_busdata[temp_branch.from].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
-							}
-							else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
-							{
-								work_phases |= (NR_busdata[temp_branch.from].origphases & 0x18);	//House?, D
-							}
+					//Now apply the phases on the TO end of this branch - first off, get base phases
+					work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
 
-							//Apply the change to the TO node
-							NR_busdata[temp_branch.from].phases |= work_phases;
-						}
-					}//End TO end is valid
-					else	//TO end not valid - hope we get hit by something else later
+					//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
+					if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
 					{
-						continue;
+						work_phases |= (NR_busdata[temp_branch->from].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
+					}
+					else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
+					{
+						work_phases |= (NR_busdata[temp_branch->from].origphases & 0x18);	//House?, D
 					}
-				}//End restoration - FROM end
-			}//End TO end
 
-			//Functionalized version of modifier
-			special_object_alteration_handle(NR_busdata[node_int].Link_Table[index]);
+					//Apply the change to the TO node
+					NR_busdata[temp_branch->from].phases |= work_phases;
+				}
+			}//End TO end is valid
+			else	//TO end not valid - hope we get hit by something else later
+			{
+				return false;
+			}
+		}//End restoration - FROM end
+	}//End TO end
 
-			//Flag us as handled
-			Alteration_Nodes[branch_val] = 1;
+	//Functionalized version of modifier
+	special_object_alteration_handle(NR_busdata[node_int].Link_Table[index]);
 
-			//Recursion!!
-			support_search_links(branch_val,node_start,impact_mode);
-		}//End both not handled (work to be done)
-	}//End link table loop
+	//Flag us as handled
+	Alteration_Nodes[branch_val] = 1;
+
+	//Go down into the other end
+	return true;
 }
 
 //Function to reset "touched" alteration variable
@@ -1799,7 +1872,39 @@ void fault_check::allocate_alterations_values(bool reliability_mode_bool)
 //Function to progress downwards and flag momentary interruptions
 void fault_check::momentary_activation(int node_int)
 {
-	unsigned int index;
+	FCHECK_SEARCH search;
+	NR_GRAPH_STACK stack;
+	NR_GRAPH *graph = nr_graph_get();
+
+	search.fcheck = this;
+	search.graph = graph;
+
+	//Flag us, then everything downstream of us
+	momentary_flag_node(node_int);
+
+	nr_graph_stack_init(graph,&stack);
+	nr_graph_depth_first(graph,node_int,momentary_visit,&search,0,&stack);
+	nr_graph_stack_free(&stack);
+}
+
+bool fault_check::momentary_visit(void *data, unsigned int root_idx, int bus, unsigned int entry)
+{
+	FCHECK_SEARCH *search = (FCHECK_SEARCH*)data;
+
+	//See if we're the from end of this link - if so, proceed
+	if (search->graph->from_end[entry] == true)
+	{
+		search->fcheck->momentary_flag_node(search->graph->other[entry]);
+		return true;
+	}
+	//Defaulted else - must be the to end - we don't care
+
+	return false;
+}
+
+//Flags the momentary interruption of a node, if it is a meter
+void fault_check::momentary_flag_node(int node_int)
+{
 	OBJECT *tmp_obj;
 	bool *momentary_flag;
 	PROPERTY *pval;
@@ -1841,18 +1946,6 @@ void fault_check::momentary_activation(int node_int)
 		//Flag it
 		*momentary_flag = true;
 	}
-
-	//Loop through the link table
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
-	{
-		//See if we're the from end of this link - if so, proceed
-		if (NR_branchdata[NR_busdata[node_int].Link_Table[index]].from == node_int)
-		{
-			//Recurse our way in!
-			momentary_activation(NR_branchdata[NR_busdata[node_int].Link_Table[index]].to);
-		}
-		//Defaulted else - must be the to end - we don't care
-	}
 }
 
 //Function to see if an unsupported node exists, mainly for file output
@@ -1908,6 +2001,7 @@ void fault_check::associate_grids(void)
 {
 	unsigned int indexval;
 	int grid_counter;
+	bool swing_done;
 
 	//Call the reset/allocation routine
 	reset_associated_grid();
@@ -1915,9 +2009,16 @@ void fault_check::associate_grids(void)
 	//Set the counter
 	grid_counter = 0;
 
+	//Try the SWING grids all at once - falls back to the loop below if they touch
+	if (parallel_traversal == true)
+	{
+		grid_counter = associate_swing_grids_parallel();
+	}
+	swing_done = (grid_counter != 0);
+
 	//Parse the busdata list to find these - enter as we go
 	//Do a full traverse, since this may swap to "just has a source" later
-	for (indexval=0; indexval<NR_bus_count; indexval++)
+	for (indexval=0; (indexval<NR_bus_count) && (swing_done == false); indexval++)
 	{
 		//See if we're a SWING node
 		if (NR_busdata[indexval].type == 2)	//SWING bus
@@ -1988,53 +2089,133 @@ void fault_check::associate_grids(void)
 }
 
 //Multiple grid checking items - the actual crawler
-//This is recursively called
 void fault_check::search_associated_grids(unsigned int node_int, int grid_counter)
 {
-	unsigned int index;
-	int node_ref;
+	FCHECK_SEARCH search;
+	NR_GRAPH_STACK stack;
+	NR_GRAPH *graph = nr_graph_get();
+
+	search.fcheck = this;
+	search.graph = graph;
+	search.grid_counter = grid_counter;
+
+	nr_graph_stack_init(graph,&stack);
+	nr_graph_depth_first(graph,node_int,search_grid_visit,&search,0,&stack);
+	nr_graph_stack_free(&stack);
+}
+
+bool fault_check::search_grid_visit(void *data, unsigned int root_idx, int bus, unsigned int entry)
+{
+	FCHECK_SEARCH *search = (FCHECK_SEARCH*)data;
+	int *associated_grid = search->fcheck->associated_grid;
+	int node_ref = search->graph->other[entry];
 
-	//Loop through the connection table for this node
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+	//We're theoretically coming from a "powered node", so see if it has any phase alignment to proceed
+	//Only do "in service" items, so go on current phases, not original phases
+	if (((NR_busdata[bus].phases & 0x07) & (NR_branchdata[search->graph->link[entry]].phases & 0x07)) != 0x00)
 	{
-		//See which end of the link we are
-		if (NR_branchdata[NR_busdata[node_int].Link_Table[index]].from == node_int)	//From end
+		//See if the other side has been handled
+		if (associated_grid[node_ref] == -1)
 		{
-			//Set the node-ref - must be other end
-			node_ref = NR_branchdata[NR_busdata[node_int].Link_Table[index]].to;
+			//Set the appropriate side
+			associated_grid[node_ref] = search->grid_counter;
+
+			//Go in
+			return true;
 		}
-		else	//Must be the to-end
+		else if (associated_grid[node_ref] != search->grid_counter)
 		{
-			//Set the node-ref, it must be us
-			node_ref = NR_branchdata[NR_busdata[node_int].Link_Table[index]].from;
+			GL_THROW("fault_check: duplicate grid assignment on node %s!",NR_busdata[node_ref].name);
+			/*  TROUBLESHOOT
+			While mapping the associated grid/swing node for a system, a condition was encountered where
+			a node tried to belong to two different systems.  This should not have occurred.  Please submit
+			your code and a bug report via the ticketing system.
+			*/
 		}
+		//Default else -- already handled as this grid
+	}
+	//Default else, not a match, so next
+
+	return false;
+}
+
+//Parallel version of the first (SWING) pass of associate_grids - each SWING bus is searched on its own thread,
+//claiming nodes atomically.  If any two searches meet, the labels are cleared and 0 is returned so the serial
+//pass redoes it (and reports the duplicate assignment the same way).  Otherwise returns the number of grids found.
+int fault_check::associate_swing_grids_parallel(void)
+{
+	FCHECK_SEARCH search;
+	NR_GRAPH *graph = nr_graph_get();
+	int *roots;
+	unsigned int indexval, root_count;
+
+	roots = (int *)gl_malloc(NR_bus_count*sizeof(int));
 
-		//We're theoretically coming from a "powered node", so see if it has any phase alignment to proceed
-		//Only do "in service" items, so go on current phases, not original phases
-		if (((NR_busdata[node_int].phases & 0x07) & (NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07)) != 0x00)
+	if (roots == NULL)
+	{
+		return 0;	//Just let the serial pass do it
+	}
+
+	root_count = 0;
+	for (indexval=0; indexval<NR_bus_count; indexval++)
+	{
+		if (NR_busdata[indexval].type == 2)	//SWING bus
 		{
-			//See if the other side has been handled
-			if (associated_grid[node_ref] == -1)
-			{
-				//Set the appropriate side
-				associated_grid[node_ref] = grid_counter;
+			roots[root_count++] = indexval;
+		}
+	}
 
-				//Recurse in
-				search_associated_grids(node_ref,grid_counter);
-			}
-			else if (associated_grid[node_ref] != grid_counter)
-			{
-				GL_THROW("fault_check: duplicate grid assignment on node %s!",NR_busdata[node_ref].name);
-				/*  TROUBLESHOOT
-				While mapping the associated grid/swing node for a system, a condition was encountered where
-				a node tried to belong to two different systems.  This should not have occurred.  Please submit
-				your code and a bug report via the ticketing system.
-				*/
-			}
-			//Default else -- already handled as this grid
+	search.fcheck = this;
+	search.graph = graph;
+	search.conflict = false;
+
+	//Grid numbers are the position in the list, same as the serial pass hands out when nothing is shared
+	if (root_count > 1)
+	{
+		nr_graph_depth_first_parallel(graph,roots,root_count,search_grid_visit_parallel,&search);
+
+		//A SWING claimed by another SWING's search would have been skipped by the serial pass
+		for (indexval=0; (indexval<root_count) && (search.conflict == false); indexval++)
+		{
+			if ((associated_grid[roots[indexval]] != -1) && (associated_grid[roots[indexval]] != (int)indexval))
+				search.conflict = true;
 		}
-		//Default else, not a match, so next
 	}
+	else
+	{
+		search.conflict = true;	//Nothing to gain
+	}
+
+	gl_free(roots);
+
+	if (search.conflict == true)
+	{
+		reset_associated_grid();
+		return 0;
+	}
+
+	return root_count;
+}
+
+//Runs on the NR update threads - no GL_THROW in here, conflicts are only flagged
+bool fault_check::search_grid_visit_parallel(void *data, unsigned int root_idx, int bus, unsigned int entry)
+{
+	FCHECK_SEARCH *search = (FCHECK_SEARCH*)data;
+	int *associated_grid = search->fcheck->associated_grid;
+	int node_ref = search->graph->other[entry];
+
+	if (((NR_busdata[bus].phases & 0x07) & (NR_branchdata[search->graph->link[entry]].phases & 0x07)) != 0x00)
+	{
+		//Claim the other side
+		if (__sync_bool_compare_and_swap(&associated_grid[node_ref],-1,(int)root_idx))
+			return true;
+
+		//Someone else's grid - stop here, the serial pass will sort it out
+		if (associated_grid[node_ref] != (int)root_idx)
+			search->conflict = true;
+	}
+
+	return false;
 }
 
 //////////////////////////////////////////////////////////////////////////
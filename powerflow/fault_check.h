@@ -5,6 +5,19 @@
 #define _FAULT_CHECK_H
 
 #include "powerflow.h"
+#include "nr_graph.h"
+
+class fault_check;
+
+//State shared with the topology search callbacks
+typedef struct {
+	fault_check *fcheck;	//Object doing the search
+	NR_GRAPH *graph;		//Adjacency being searched
+	int node_start;			//Bus the alteration started from (support_search_links)
+	bool impact_mode;		//Restoring or removing (support_search_links)
+	int grid_counter;		//Grid being labeled (search_associated_grids)
+	bool conflict;			//Two grids met (parallel grid association)
+} FCHECK_SEARCH;
 
 class fault_check : public powerflow_object
 {
@@ -30,6 +43,7 @@ public:
 	bool reliability_search_mode;	//Flag for how the object removal search occurs - basically assuming radial versus not
 	bool grid_association_mode;		//Flag to see if fault_check should be checking for multiple grids, or just go on the "master swing" idea
 	bool full_print_output;			//Flag to determine if both supported and unsupported nodes get written to the output file
+	bool parallel_traversal;		//Flag to search the grids of different SWING buses in parallel (grid_association)
 	OBJECT *rel_eventgen;			//Eventgen object in reliability - allows "unscheduled" faults
 
 	fault_check(MODULE *mod);
@@ -37,11 +51,10 @@ public:
 	int create(void);
 	int init(OBJECT *parent=NULL);
 	int isa(char *classname);
-	void search_links(int node_int);							//Function to check connectivity and support of nodes
-	void search_links_mesh(int node_int);						//Function to check connectivity and support of nodes, but more in the "mesh" sense
 	void support_check(int swing_node_int);						//Function that performs the connectivity check - this way so can be easily externally accessed
 	void support_check_mesh(int swing_node_int);				//Function that performs the connectivity check for not-so-radial systems
-	void reset_support_check(void);								//Function to re-init the support matrix
+	void update_support(int swing_node_int, int baselink_int);	//Function to bring the support forest up to date with link and source changes (one link, or all if negative)
+	void rebuild_support(int swing_node_int);					//Function to rebuild the support forest from the sources
 	void write_output_file(TIMESTAMP tval, double tval_delta);	//Function to write out "unsupported" items
 
 	void support_check_alterations(int baselink_int, bool rest_mode);	//Function to update powerflow for "no longer supported" devices
@@ -52,6 +65,7 @@ public:
 	void support_search_links(int node_int, int node_start, bool impact_mode);	//Function to check connectivity and support of nodes and remove/restore components as necessary
 	void support_search_links_mesh(int baselink_int, bool impact_mode);			//Function to parse bus list and remove anything that isn't supported (mesh systems)
 	void momentary_activation(int node_int);									//Function to progress down a branch and flag momentary outages
+	void momentary_flag_node(int node_int);										//Function to flag the momentary outage of a meter
 	void special_object_alteration_handle(int branch_idx);						//Functionalized special device alteration code
 
 	void reset_associated_grid(void);										//Function to reset/allocate "grid association" array
@@ -64,6 +78,34 @@ private:
 	TIMESTAMP prev_time;	//Previous timestamp - mainly for intialization
 	FUNCTIONADDR restoration_fxn;	// Function address for restoration object reconfiguration call
 	int *associated_grid;	//Array for assignment of nodes to different "main connection" points
+
+	//Support forest -- each supported phase of a node remembers the link it was reached through, so a link
+	//change only re-traverses the part of the system below it
+	unsigned char *support_link_phases;		//Phases each link could pass at the last support update
+	unsigned char *support_source_phases;	//Phases each node sourced itself at the last support update
+	int *support_parent;					//Link supplying each phase of a node (3 per node, -1 for source or unsupported)
+	int *support_stack;						//Nodes waiting to pass their support on
+	int *support_cleared;					//Nodes that lost support during an update (up to once per phase)
+	unsigned char *support_queued;			//Flag for nodes already on the support stack
+	unsigned int support_stack_size;		//Current size of the support stack
+	int support_forest_mode;				//Search mode the forest was built for (-1 if not built yet)
+
+	unsigned char support_link_mask(int branch_idx);						//Phases a link can currently pass support on
+	unsigned char support_source_mask(int node_int, int swing_node_int);	//Phases a node currently sources itself
+	unsigned int support_update_link(int branch_idx, unsigned int cleared_size);				//Bring one link's phases in the forest up to date
+	unsigned int support_clear_subtree(int node_int, int phase_idx, unsigned int cleared_size);	//Remove one phase of support below a node
+	void support_push(int node_int);										//Queue a node to pass its support on
+	void support_propagate(void);											//Pass support on from the queued nodes
+	void support_flag_node(int node_int);									//Update Supported_Nodes for a node
+
+	bool support_search_link(int node_int, int node_start, bool impact_mode, unsigned int index);	//One link of support_search_links - true to walk the other end
+	int associate_swing_grids_parallel(void);								//Parallel SWING pass of associate_grids - 0 if the serial pass has to do it
+
+	//Topology search callbacks (nr_graph_depth_first)
+	static bool support_search_visit(void *data, unsigned int root_idx, int bus, unsigned int entry);
+	static bool momentary_visit(void *data, unsigned int root_idx, int bus, unsigned int entry);
+	static bool search_grid_visit(void *data, unsigned int root_idx, int bus, unsigned int entry);
+	static bool search_grid_visit_parallel(void *data, unsigned int root_idx, int bus, unsigned int entry);
 };
 
 EXPORT int powerflow_alterations(OBJECT *thisobj, int baselink,bool rest_mode);
@@ -12,6 +12,7 @@
 #include "powerflow.h"
 #undef  _POWERFLOW_CPP
 
+#include "solver_klu.h"
 #include "triplex_meter.h"
 #include "capacitor.h"
 #include "fuse.h"
@@ -79,12 +80,23 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 		PT_KEYWORD,"ALL",MD_ALL,
 		NULL);
 	gl_global_create("powerflow::NR_matrix_output_references",PT_bool,&NRMatReferences,NULL);
+	gl_global_create("powerflow::NR_matrix_assembly",PT_enumeration,&NRMatAssemblyMethod,PT_DESCRIPTION,"Method used to build the sparse matrix for the NR solver",
+		PT_KEYWORD,"LINKED_LIST",MA_LINKEDLIST,
+		PT_KEYWORD,"SORTED",MA_SORTED,
+		NULL);
+	gl_global_create("powerflow::NR_pattern_cache",PT_bool,&NR_pattern_cache,PT_DESCRIPTION,"Reuse the sparsity pattern and column ordering of the NR matrix while the topology is unchanged",NULL);
+	gl_global_create("powerflow::NR_matrix_assembly_time",PT_double,&NR_matrix_assembly_time,PT_UNITS,"s",PT_DESCRIPTION,"Accumulated processor time spent building the sparse matrix for the NR solver",NULL);
 	gl_global_create("powerflow::line_capacitance",PT_bool,&use_line_cap,NULL);
 	gl_global_create("powerflow::line_limits",PT_bool,&use_link_limits,NULL);
-	gl_global_create("powerflow::lu_solver",PT_char256,&LUSolverName,NULL);
+	gl_global_create("powerflow::lu_solver",PT_char256,&LUSolverName,PT_DESCRIPTION,"LU solver used by NR - empty for superLU, the name of a built-in solver (KLU), or an external solver_<name> library",NULL);
+
+	//Built-in LU solvers - an external library of the same name takes precedence
+	lu_solver_register("KLU",klu_init,klu_alloc,klu_solve,klu_destroy);
+
 	gl_global_create("powerflow::NR_iteration_limit",PT_int64,&NR_iteration_limit,NULL);
 	gl_global_create("powerflow::NR_deltamode_iteration_limit",PT_int64,&NR_delta_iteration_limit,NULL);
 	gl_global_create("powerflow::NR_superLU_procs",PT_int32,&NR_superLU_procs,NULL);
+	gl_global_create("powerflow::NR_stamp_procs",PT_int32,&NR_stamp_procs,PT_DESCRIPTION,"Number of threads used for the per-bus load and Jacobian updates of the NR solver (0 uses the core thread count)",NULL);
 	gl_global_create("powerflow::default_maximum_voltage_error",PT_double,&default_maximum_voltage_error,NULL);
 	gl_global_create("powerflow::default_maximum_power_error",PT_double,&default_maximum_power_error,NULL);
 	gl_global_create("powerflow::NR_admit_change",PT_bool,&NR_admit_change,NULL);
@@ -242,6 +254,198 @@ EXPORT unsigned long preupdate(MODULE *module, TIMESTAMP t0, unsigned int64 dt)
 	}
 }
 
+//Deltamode object updates - split across the NR solver's update threads when it has more than one
+//Objects run in batches of the same rank, highest first like postsync, so parents still update before their children.
+//Child nodes only post into their parent from NR_node_sync_fxn, which locks it (LOCK_OBJECT(SubNodeParent)) since the
+//core's sync passes run a rank concurrently too - NR_node_presync_fxn and BOTH_node_postsync_fxn only touch the node itself.
+#define DELTA_MIN_OBJECTS 16	//Fewest objects worth handing to another thread
+
+typedef struct {
+	unsigned int64 delta_time;
+	unsigned long dt;
+	unsigned int iteration_count_val;
+	bool interupdate_pos;
+	int first;	//First entry of delta_order in the batch being run
+} DELTA_PASS_DATA;
+
+static int delta_order_count = -1;			//Objects delta_order was built for - -1 until set up
+static int *delta_order = NULL;				//Object indices sorted by rank (descending), then by index
+static int *delta_batch = NULL;				//Start of each batch of the same rank in delta_order - n_delta_batches+1 entries
+static int n_delta_batches = 0;
+static SIMULATIONMODE *delta_status = NULL;	//Result of each object's last update
+
+static int delta_order_cmp(const void *a, const void *b)
+{
+	int ia = *(const int*)a, ib = *(const int*)b;
+
+	if (delta_objects[ia]->rank != delta_objects[ib]->rank)
+		return (delta_objects[ia]->rank > delta_objects[ib]->rank) ? -1 : 1;
+	return ia - ib;
+}
+
+//Sort the deltamode objects into rank batches
+static void delta_schedule_setup(void)
+{
+	int n;
+
+	gl_free(delta_status);
+	gl_free(delta_order);
+	gl_free(delta_batch);
+
+	delta_status = (SIMULATIONMODE*)gl_malloc((pwr_object_count+1)*sizeof(SIMULATIONMODE));
+	delta_order = (int*)gl_malloc((pwr_object_count+1)*sizeof(int));
+	delta_batch = (int*)gl_malloc((pwr_object_count+1)*sizeof(int));
+
+	if ((delta_status == NULL) || (delta_order == NULL) || (delta_batch == NULL))
+	{
+		GL_THROW("powerflow:interupdate - failed to allocate memory for the deltamode update batches");
+		/*  TROUBLESHOOT
+		While setting up the deltamode object updates, memory for the update order and results could not be allocated.
+		Please try again.  If the error persists, please submit your code and a bug report via the ticketing system.
+		*/
+	}
+
+	for (n=0; n<pwr_object_count; n++)
+		delta_order[n] = n;
+
+	qsort(delta_order,pwr_object_count,sizeof(int),delta_order_cmp);
+
+	n_delta_batches = 0;
+	for (n=0; n<pwr_object_count; n++)
+	{
+		if ((n == 0) || (delta_objects[delta_order[n]]->rank != delta_objects[delta_order[n-1]]->rank))
+			delta_batch[n_delta_batches++] = n;
+	}
+	delta_batch[n_delta_batches] = pwr_object_count;
+
+	delta_order_count = pwr_object_count;
+}
+
+//Update one deltamode object - exceptions are turned into SM_ERROR, since this may run on one of the update threads
+static SIMULATIONMODE delta_update_object(int index, DELTA_PASS_DATA *pass, NR_STAMP_STATUS *status)
+{
+	OBJECT *obj = delta_objects[index];
+
+	//See if we're in service or not
+	if ((obj->in_svc_double > gl_globaldeltaclock) || (obj->out_svc_double < gl_globaldeltaclock))
+	{
+		return (pass->interupdate_pos == false) ? SM_DELTA : SM_EVENT;	//Not in service - just pass
+	}
+
+	if (delta_functions[index] == NULL)
+	{
+		return SM_EVENT;	//No function present, just assume we only like events
+	}
+
+	try {
+		//Call the actual function
+		return ((SIMULATIONMODE (*)(OBJECT *, unsigned int64, unsigned long, unsigned int, bool))(*delta_functions[index]))(obj,pass->delta_time,pass->dt,pass->iteration_count_val,pass->interupdate_pos);
+	}
+	catch (const char *msg)
+	{
+		nr_stamp_fail(status,"%s",msg);
+	}
+	catch (...)
+	{
+		nr_stamp_fail(status,"unknown exception");
+	}
+	return SM_ERROR;
+}
+
+static void delta_update_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status)
+{
+	DELTA_PASS_DATA *pass = (DELTA_PASS_DATA*)data;
+	unsigned int n;
+
+	for (n=start; n<stop; n++)
+	{
+		delta_status[delta_order[pass->first+n]] = delta_update_object(delta_order[pass->first+n],pass,status);
+	}
+}
+
+//Run the pre- or post-pass updates of all the objects into delta_status
+//Stops after the first batch with an error - the objects after it keep SM_EVENT, like the serial loop never reaching them
+//The first exception caught is rethrown here, on the calling thread, once its batch is done
+static void delta_update_all(unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val, bool interupdate_pos)
+{
+	DELTA_PASS_DATA pass;
+	NR_STAMP_STATUS status;
+	int n, b;
+
+	if (delta_order_count != pwr_object_count)
+		delta_schedule_setup();
+
+	for (n=0; n<pwr_object_count; n++)
+		delta_status[n] = SM_EVENT;
+
+	pass.delta_time = delta_time;
+	pass.dt = dt;
+	pass.iteration_count_val = iteration_count_val;
+	pass.interupdate_pos = interupdate_pos;
+
+	if (nr_stamp_threads() < 2)
+	{
+		//Loop forward, otherwise parent/child code doesn't work right
+		status.failed = 0;
+		for (n=0; n<pwr_object_count; n++)
+		{
+			delta_status[n] = delta_update_object(n,&pass,&status);
+			if (delta_status[n] == SM_ERROR)
+				break;
+		}
+		if (status.failed != 0)
+		{
+			GL_THROW("%s",status.error);
+		}
+		return;
+	}
+
+	for (b=0; b<n_delta_batches; b++)
+	{
+		pass.first = delta_batch[b];
+		nr_stamp_run(delta_batch[b+1]-delta_batch[b],DELTA_MIN_OBJECTS,delta_update_range,&pass);
+
+		//No sense running the children of an object that failed
+		for (n=delta_batch[b]; n<delta_batch[b+1]; n++)
+		{
+			if (delta_status[delta_order[n]] == SM_ERROR)
+				return;
+		}
+	}
+}
+
+//Update threads for the deltamode object updates of other modules - generators finds these in the powerflow library
+typedef void (*DELTARANGEFCN)(void *data, unsigned int start, unsigned int stop);
+
+typedef struct {
+	DELTARANGEFCN fcn;
+	void *data;
+} DELTA_SHARED_RUN;
+
+static void delta_shared_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status)
+{
+	DELTA_SHARED_RUN *run = (DELTA_SHARED_RUN*)data;
+
+	run->fcn(run->data,start,stop);
+}
+
+//Number of update threads (powerflow::NR_stamp_procs)
+EXPORT unsigned int delta_update_threads(void)
+{
+	return nr_stamp_threads();
+}
+
+//Run fcn over items 0 to count-1, split across the update threads if there are at least min_count items for each thread
+//fcn runs on the update threads, so it has to catch its own exceptions
+EXPORT void delta_update_run(unsigned int count, unsigned int min_count, DELTARANGEFCN fcn, void *data)
+{
+	DELTA_SHARED_RUN run;
+
+	run.fcn = fcn;
+	run.data = data;
+	nr_stamp_run(count,min_count,delta_shared_range,&run);
+}
+
 //interupdate function of deltamode
 //Module-level call for each timestep of deltamode
 //Ideally, all deltamode objects coordinate through their module call, not their individual "update" call
@@ -276,39 +480,19 @@ EXPORT SIMULATIONMODE interupdate(MODULE *module, TIMESTAMP t0, unsigned int64 d
 		while (simple_iter_test < NR_delta_iteration_limit)	//Simple iteration capability
 		{
 			//Do the preliminary pass, in case we're needed
-			//Loop through the object list and call the updates - loop forward, otherwise parent/child code doesn't work right
+			try {
+				delta_update_all(delta_time,dt,iteration_count_val,false);
+			}
+			catch (const char *msg)
+			{
+				gl_error("powerflow:interupdate - pre-pass function call: %s", msg);
+				error_state = true;
+			}
+
+			//Check the objects in order
 			for (curr_object_number=0; curr_object_number<pwr_object_count; curr_object_number++)
 			{
-				//See if we're in service or not
-				if ((delta_objects[curr_object_number]->in_svc_double <= gl_globaldeltaclock) && (delta_objects[curr_object_number]->out_svc_double >= gl_globaldeltaclock))
-				{
-					if (delta_functions[curr_object_number] != NULL)
-					{
-						//Try/catch for any GL_THROWs that may be called
-						try {
-							//Call the actual function
-							function_status = ((SIMULATIONMODE (*)(OBJECT *, unsigned int64, unsigned long, unsigned int, bool))(*delta_functions[curr_object_number]))(delta_objects[curr_object_number],delta_time,dt,iteration_count_val,false);
-						}
-						catch (const char *msg)
-						{
-							gl_error("powerflow:interupdate - pre-pass function call: %s", msg);
-							error_state = true;
-							function_status = SM_ERROR;	//Flag as an error too
-						}
-						catch (...)
-						{
-							gl_error("powerflow:interupdate - pre-pass function call: unknown exception");
-							error_state = true;
-							function_status = SM_ERROR;	//Flag as an error too
-						}
-					}
-					else	//No functional call for this, skip it
-					{
-						function_status = SM_EVENT;	//Just put something here, mainly for error checks
-					}
-				}
-				else //Not in service - just pass
-					function_status = SM_DELTA;
+				function_status = delta_status[curr_object_number];
 
 				//Just make sure we didn't error 
 				if (function_status == SM_ERROR)
@@ -380,39 +564,20 @@ EXPORT SIMULATIONMODE interupdate(MODULE *module, TIMESTAMP t0, unsigned int64 d
 				break;	//Get out of the while loop
 			}
 
-			//Loop through the object list and call the updates - loop forward for SWING first, to replicate "postsync"-like order
+			//Call the updates - SWING first, to replicate "postsync"-like order
+			try {
+				delta_update_all(delta_time,dt,iteration_count_val,true);
+			}
+			catch (const char *msg)
+			{
+				gl_error("powerflow:interupdate - post-pass function call: %s", msg);
+				error_state = true;
+			}
+
+			//Combine the results in object order
 			for (curr_object_number=0; curr_object_number<pwr_object_count; curr_object_number++)
 			{
-				//See if we're in service or not
-				if ((delta_objects[curr_object_number]->in_svc_double <= gl_globaldeltaclock) && (delta_objects[curr_object_number]->out_svc_double >= gl_globaldeltaclock))
-				{
-					if (delta_functions[curr_object_number] != NULL)
-					{
-						//Try/catch for any GL_THROWs that may be called
-						try {
-							//Call the actual function
-							function_status = ((SIMULATIONMODE (*)(OBJECT *, unsigned int64, unsigned long, unsigned int, bool))(*delta_functions[curr_object_number]))(delta_objects[curr_object_number],delta_time,dt,iteration_count_val,true);
-						}
-						catch (const char *msg)
-						{
-							gl_error("powerflow:interupdate - post-pass function call: %s", msg);
-							error_state = true;
-							function_status = SM_ERROR;	//Flag as an error too
-						}
-						catch (...)
-						{
-							gl_error("powerflow:interupdate - post-pass function call: unknown exception");
-							error_state = true;
-							function_status = SM_ERROR;	//Flag as an error too
-						}
-					}
-					else	//Doesn't have a function, either intentionally, or "lack of supportly"
-					{
-						function_status = SM_EVENT;	//No function present, just assume we only like events
-					}
-				}
-				else //Not in service - just pass
-					function_status = SM_EVENT;
+				function_status = delta_status[curr_object_number];
 
 				//Determine what our return is
 				if (function_status == SM_DELTA)
@@ -481,6 +646,70 @@ EXPORT SIMULATIONMODE interupdate(MODULE *module, TIMESTAMP t0, unsigned int64 d
 	}
 }
 
+//deltamode_error function
+//Module-level call after each converged deltamode timestep when the core is adapting its timestep
+//Returns the largest per-unit change of any bus voltage over the timestep just taken,
+//or a negative value if the module timestep must be kept (in-rush integration or step-counting objects)
+static complex *delta_error_voltage = NULL;	//Bus voltages at the end of the previous timestep
+static unsigned int delta_error_count = 0;
+static bool delta_error_valid = false;
+
+EXPORT double deltamode_error(MODULE *module, unsigned long dt)
+{
+	unsigned int indexval, phaseval;
+	double change_val, max_change;
+
+	if (enable_subsecond_models == false)
+	{
+		return 0.0;	//Nothing changes in here
+	}
+
+	if ((enable_inrush_calculations == true) || (deltamode_fixed_step == true))
+	{
+		return -1.0;	//Integration terms were formed with the module timestep
+	}
+
+	//Size the history to the current bus list
+	if (delta_error_count != NR_bus_count)
+	{
+		gl_free(delta_error_voltage);
+		delta_error_voltage = (complex *)gl_malloc(NR_bus_count*3*sizeof(complex));
+		if (delta_error_voltage == NULL)
+		{
+			delta_error_count = 0;
+			return -1.0;	//No history, so no estimate
+		}
+		delta_error_count = NR_bus_count;
+		delta_error_valid = false;
+	}
+
+	max_change = 0.0;
+	for (indexval=0; indexval<NR_bus_count; indexval++)
+	{
+		for (phaseval=0; phaseval<3; phaseval++)
+		{
+			if ((delta_error_valid == true) && (NR_busdata[indexval].volt_base > 0.0))
+			{
+				change_val = (NR_busdata[indexval].V[phaseval] - delta_error_voltage[indexval*3+phaseval]).Mag()/NR_busdata[indexval].volt_base;
+
+				if (change_val > max_change)
+					max_change = change_val;
+			}
+
+			delta_error_voltage[indexval*3+phaseval] = NR_busdata[indexval].V[phaseval];
+		}
+	}
+
+	//First timestep of this deltamode run has nothing to compare against
+	if (delta_error_valid == false)
+	{
+		delta_error_valid = true;
+		return -1.0;
+	}
+
+	return max_change;
+}
+
 //postupdate function of deltamode
 //Executes after all objects in the simulation agree to go back to event-driven mode
 //Return value is a SUCCESS/FAILURE
@@ -498,6 +727,10 @@ EXPORT STATUS postupdate(MODULE *module, TIMESTAMP t0, unsigned int64 dt)
 		//Deflag the timestep variable as well
 		deltatimestep_running = -1.0;
 
+		//Adaptive timestep history starts over with the next deltamode run
+		delta_error_valid = false;
+		deltamode_fixed_step = false;
+
 		//See how far we progressed - cast just in case (code pulled from core - so should align)
 		seconds_advance = (unsigned int64)(dt/DT_SECOND);
 
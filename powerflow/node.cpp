@@ -371,6 +371,7 @@ int node::init(OBJECT *parent)
 		char extpath[1024];
 		CALLBACKS **cbackval = NULL;
 		bool ExtLinkFailure;
+		LU_SOLVER_BACKEND *lu_backend;
 
 		// Store the topological parent before anyone overwrites it
 		TopologicalParent = obj->parent;
@@ -879,6 +880,23 @@ int node::init(OBJECT *parent)
 						}
 					}//End found proper DLL
 				}//end found external and linked
+				else if ((lu_backend = lu_solver_find(LUSolverName.get_string())) != NULL)	//Built-in solver
+				{
+					//Link up the functions - same calling convention as the external libraries
+					LUSolverFcns.ext_init = (void *)lu_backend->init;
+					LUSolverFcns.ext_alloc = (void *)lu_backend->alloc;
+					LUSolverFcns.ext_solve = (void *)lu_backend->solve;
+					LUSolverFcns.ext_destroy = (void *)lu_backend->destroy;
+
+					gl_verbose("Built-in solver %s found, utilizing for NR",LUSolverName.get_string());
+					/*  TROUBLESHOOT
+					A built-in LU matrix solver was specified, so NR will be calculated using that instead of
+					superLU.
+					*/
+
+					//Flag as a pluggable solver
+					matrix_solver_method=MM_EXTERN;
+				}
 				else	//Not found, just default to superLU
 				{
 					gl_warning("The external solver solver_%s could not be found, defaulting to superLU",LUSolverName.get_string());
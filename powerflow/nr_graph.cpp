@@ -0,0 +1,239 @@
+/* $Id
+ * CSR adjacency of the NR bus/branch topology and explicit-stack traversals over it
+ *
+ * The topology searches (fault_check support, momentary devices, grid association)
+ * used to recurse once per bus along a feeder and walk NR_busdata[].Link_Table,
+ * looking up each branch's from/to end as they went.  On long radial feeders the
+ * recursion depth is the feeder length, which can overflow the thread stack.  Here
+ * the adjacency is flattened once into a compressed (CSR) layout with the far bus of
+ * each entry resolved, and the depth-first walk keeps its path in an explicit stack.
+ * Entries keep Link_Table order, so a walk visits buses in the same order the
+ * recursion did.
+ */
+
+#include "powerflow.h"
+#include "nr_graph.h"
+
+static NR_GRAPH nr_graph_shared = {0,0,NULL,NULL,NULL,NULL};
+
+//Releases the arrays of a graph
+static void nr_graph_free(NR_GRAPH *graph)
+{
+	if (graph->start != NULL)
+	{
+		gl_free(graph->start);
+		gl_free(graph->link);
+		gl_free(graph->other);
+		gl_free(graph->from_end);
+	}
+
+	graph->start = NULL;
+	graph->link = NULL;
+	graph->other = NULL;
+	graph->from_end = NULL;
+	graph->bus_count = 0;
+	graph->branch_count = 0;
+}
+
+//Flattens NR_busdata[].Link_Table into the graph
+static void nr_graph_build(NR_GRAPH *graph)
+{
+	unsigned int index, indexb, entry, entry_count;
+	int branch_val;
+
+	nr_graph_free(graph);
+
+	entry_count = 0;
+	for (index=0; index<NR_bus_count; index++)
+	{
+		entry_count += NR_busdata[index].Link_Table_Size;
+	}
+
+	graph->start = (unsigned int*)gl_malloc((NR_bus_count+1)*sizeof(unsigned int));
+	graph->link = (int*)gl_malloc((entry_count+1)*sizeof(int));
+	graph->other = (int*)gl_malloc((entry_count+1)*sizeof(int));
+	graph->from_end = (bool*)gl_malloc((entry_count+1)*sizeof(bool));
+
+	if ((graph->start == NULL) || (graph->link == NULL) || (graph->other == NULL) || (graph->from_end == NULL))
+	{
+		GL_THROW("NR: Failed to allocate memory for the topology adjacency");
+		/*  TROUBLESHOOT
+		While flattening the bus/branch connections of the Newton-Raphson topology for the
+		topology searches, memory could not be allocated.  Please try again.  If the error persists,
+		please submit your code and a bug report via the ticketing system.
+		*/
+	}
+
+	entry = 0;
+	for (index=0; index<NR_bus_count; index++)
+	{
+		graph->start[index] = entry;
+
+		for (indexb=0; indexb<NR_busdata[index].Link_Table_Size; indexb++)
+		{
+			branch_val = NR_busdata[index].Link_Table[indexb];
+
+			graph->link[entry] = branch_val;
+			graph->from_end[entry] = (NR_branchdata[branch_val].from == (int)index);
+			graph->other[entry] = graph->from_end[entry] ? NR_branchdata[branch_val].to : NR_branchdata[branch_val].from;
+			entry++;
+		}
+	}
+	graph->start[NR_bus_count] = entry;
+
+	graph->bus_count = NR_bus_count;
+	graph->branch_count = NR_branch_count;
+}
+
+//Adjacency of the NR topology - built on first use and rebuilt if buses or branches were added since
+NR_GRAPH *nr_graph_get(void)
+{
+	if ((nr_graph_shared.start == NULL) || (nr_graph_shared.bus_count != NR_bus_count) || (nr_graph_shared.branch_count != NR_branch_count))
+	{
+		nr_graph_build(&nr_graph_shared);
+	}
+
+	return &nr_graph_shared;
+}
+
+//Sizes a traversal stack for graph - a path can not hold more buses than the graph has without repeating one
+//Returns false if it couldn't be allocated
+static bool nr_graph_stack_alloc(NR_GRAPH *graph, NR_GRAPH_STACK *stack)
+{
+	stack->size = 0;
+	stack->max_size = graph->bus_count + 1;
+	stack->frames = (NR_GRAPH_FRAME*)gl_malloc(stack->max_size*sizeof(NR_GRAPH_FRAME));
+
+	return (stack->frames != NULL);
+}
+
+void nr_graph_stack_init(NR_GRAPH *graph, NR_GRAPH_STACK *stack)
+{
+	if (nr_graph_stack_alloc(graph,stack) == false)
+	{
+		GL_THROW("NR: Failed to allocate memory for a topology search");
+		/*  TROUBLESHOOT
+		While allocating the working stack of a topology search (fault_check support, momentary
+		devices or grid association), memory could not be allocated.  Please try again.  If the error persists,
+		please submit your code and a bug report via the ticketing system.
+		*/
+	}
+}
+
+void nr_graph_stack_free(NR_GRAPH_STACK *stack)
+{
+	if (stack->frames != NULL)
+	{
+		gl_free(stack->frames);
+	}
+
+	stack->frames = NULL;
+	stack->size = 0;
+	stack->max_size = 0;
+}
+
+//Depth-first walk from root - visit is called for every adjacency entry of each bus on the path, and the walk
+//goes into the far bus whenever it returns true.  Equivalent to a recursion that calls itself in the middle of its link loop.
+//Returns false if the walk went deeper than the number of buses (it is going around a loop)
+static bool nr_graph_walk(NR_GRAPH *graph, int root, NRGRAPHVISIT visit, void *data, unsigned int root_idx, NR_GRAPH_STACK *stack)
+{
+	NR_GRAPH_FRAME *top;
+	unsigned int entry;
+	int next_bus;
+
+	stack->size = 1;
+	stack->frames[0].bus = root;
+	stack->frames[0].entry = graph->start[root];
+
+	while (stack->size > 0)
+	{
+		top = &stack->frames[stack->size-1];
+
+		//Out of links - back up a level
+		if (top->entry >= graph->start[top->bus+1])
+		{
+			stack->size--;
+			continue;
+		}
+
+		entry = top->entry++;
+
+		if (visit(data,root_idx,top->bus,entry) == true)
+		{
+			if (stack->size >= stack->max_size)
+			{
+				return false;
+			}
+
+			next_bus = graph->other[entry];
+			stack->frames[stack->size].bus = next_bus;
+			stack->frames[stack->size].entry = graph->start[next_bus];
+			stack->size++;
+		}
+	}
+
+	return true;
+}
+
+void nr_graph_depth_first(NR_GRAPH *graph, int root, NRGRAPHVISIT visit, void *data, unsigned int root_idx, NR_GRAPH_STACK *stack)
+{
+	if (nr_graph_walk(graph,root,visit,data,root_idx,stack) == false)
+	{
+		GL_THROW("NR: topology search from bus %d looped back on itself",root);
+		/*  TROUBLESHOOT
+		A depth-first search of the system topology (fault_check support, momentary devices or grid
+		association) went deeper than the number of buses in the system, so it is going around a loop.
+		Check that the mesh/radial settings of fault_check match the system.  If the error persists,
+		please submit your code and a bug report via the ticketing system.
+		*/
+	}
+}
+
+typedef struct {
+	NR_GRAPH *graph;
+	int *roots;
+	NRGRAPHVISIT visit;
+	void *data;
+} NR_GRAPH_PARALLEL;
+
+//Walks the roots of one thread's range, with its own stack - runs on the pool threads, so failures go in the status
+static void nr_graph_parallel_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status)
+{
+	NR_GRAPH_PARALLEL *vals = (NR_GRAPH_PARALLEL*)data;
+	NR_GRAPH_STACK stack;
+	unsigned int index;
+
+	if (nr_graph_stack_alloc(vals->graph,&stack) == false)
+	{
+		nr_stamp_fail(status,"NR: Failed to allocate memory for a topology search");
+		//Defined above
+		return;
+	}
+
+	for (index=start; index<stop; index++)
+	{
+		if (nr_graph_walk(vals->graph,vals->roots[index],vals->visit,vals->data,index,&stack) == false)
+		{
+			nr_stamp_fail(status,"NR: topology search from bus %d looped back on itself",vals->roots[index]);
+			//Defined above
+			break;
+		}
+	}
+
+	nr_graph_stack_free(&stack);
+}
+
+//Depth-first walks from each of roots, split across the NR update threads (powerflow::NR_stamp_procs)
+//visit is called concurrently for different roots, so anything it writes that two walks can reach must be claimed atomically,
+//and it must not GL_THROW - errors are thrown here once every walk has finished
+void nr_graph_depth_first_parallel(NR_GRAPH *graph, int *roots, unsigned int count, NRGRAPHVISIT visit, void *data)
+{
+	NR_GRAPH_PARALLEL vals;
+
+	vals.graph = graph;
+	vals.roots = roots;
+	vals.visit = visit;
+	vals.data = data;
+
+	nr_stamp_run(count,1,nr_graph_parallel_range,&vals);
+}
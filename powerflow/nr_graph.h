@@ -0,0 +1,40 @@
+/* $Id
+ * CSR adjacency of the NR bus/branch topology and explicit-stack traversals over it
+ */
+
+#ifndef _NR_GRAPH
+#define _NR_GRAPH
+
+#include "solver_nr.h"
+
+typedef struct {
+	unsigned int bus_count;		///< number of buses the graph was built for
+	unsigned int branch_count;	///< number of branches the graph was built for
+	unsigned int *start;		///< adjacency of bus n is entries start[n] to start[n+1]-1, in Link_Table order (bus_count+1)
+	int *link;					///< branch of each adjacency entry
+	int *other;					///< bus at the other end of each adjacency entry's branch
+	bool *from_end;				///< flag indicating the bus owning the entry is the FROM end of its branch
+} NR_GRAPH;
+
+typedef struct {
+	int bus;				///< bus being explored
+	unsigned int entry;		///< next adjacency entry of bus to look at
+} NR_GRAPH_FRAME;
+
+typedef struct {
+	NR_GRAPH_FRAME *frames;	///< explicit traversal stack - one frame per bus on the current path
+	unsigned int size;		///< current depth
+	unsigned int max_size;	///< allocated depth (bus_count+1 - a deeper path must revisit a bus)
+} NR_GRAPH_STACK;
+
+/// Called for each adjacency entry of a bus on the traversal path, in Link_Table order - return true to go into the bus at the other end
+/// root_idx is the position of the traversal's root in the list given to nr_graph_depth_first_parallel (0 otherwise)
+typedef bool (*NRGRAPHVISIT)(void *data, unsigned int root_idx, int bus, unsigned int entry);
+
+NR_GRAPH *nr_graph_get(void);
+void nr_graph_stack_init(NR_GRAPH *graph, NR_GRAPH_STACK *stack);
+void nr_graph_stack_free(NR_GRAPH_STACK *stack);
+void nr_graph_depth_first(NR_GRAPH *graph, int root, NRGRAPHVISIT visit, void *data, unsigned int root_idx, NR_GRAPH_STACK *stack);
+void nr_graph_depth_first_parallel(NR_GRAPH *graph, int *roots, unsigned int count, NRGRAPHVISIT visit, void *data);
+
+#endif
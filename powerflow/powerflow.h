@@ -32,13 +32,17 @@ void print_matrix(complex mat[3][3]);
 #define TSNVRDBL 9223372036854775808.0
 
 typedef enum {SM_FBS=0, SM_GS=1, SM_NR=2} SOLVERMETHOD;		/**< powerflow solver methodology */
-typedef enum {MM_SUPERLU=0, MM_EXTERN=1} MATRIXSOLVERMETHOD;	/**< NR matrix solver methodlogy */
+typedef enum {MM_SUPERLU=0, MM_EXTERN=1} MATRIXSOLVERMETHOD;	/**< NR matrix solver methodlogy - MM_EXTERN covers external libraries and built-in backends, both called through LUSolverFcns */
 typedef enum {
 	MD_NONE=0,			///< No matrix dump desired
 	MD_ONCE=1,			///< Single matrix dump desired
 	MD_PERCALL=2,		///< Matrix dump every call desired
 	MD_ALL=3			///< Matrix dump on every iteration desired
 } MATRIXDUMPMETHOD;
+typedef enum {
+	MA_LINKEDLIST=0,	///< Ordered linked-list insertion of each element
+	MA_SORTED=1			///< Flat triplet list, counting-sorted into column order in one pass
+} MATRIXASSEMBLYMETHOD;
 
 typedef enum {
 	LS_OPEN=0,			///< defines that that link is open
@@ -60,6 +64,9 @@ GLOBAL SOLVERMETHOD solver_method INIT(SM_FBS);		/**< powerflow solver methodolo
 GLOBAL char256 MDFileName INIT("");					/**< filename for matrix dump */
 GLOBAL MATRIXDUMPMETHOD NRMatDumpMethod INIT(MD_NONE);	/**< NR-based matrix output method */
 GLOBAL bool NRMatReferences INIT(false);			/**< Flag to indicate if the decoding information for the matrix is dumped - row/col to bus */
+GLOBAL MATRIXASSEMBLYMETHOD NRMatAssemblyMethod INIT(MA_SORTED);	/**< NR-based sparse matrix assembly method */
+GLOBAL bool NR_pattern_cache INIT(true);			/**< Flag to reuse the NR sparsity pattern and column ordering while the topology is unchanged */
+GLOBAL double NR_matrix_assembly_time INIT(0.0);	/**< Accumulated processor time spent building the NR sparse matrix, in seconds */
 GLOBAL bool use_line_cap INIT(false);				/**< Flag to include line capacitance quantities */
 GLOBAL bool use_link_limits INIT(true);				/**< Flag to include line/transformer ratings and provide a warning if exceeded */
 GLOBAL MATRIXSOLVERMETHOD matrix_solver_method INIT(MM_SUPERLU);	/**< Newton-Raphson uses superLU as the default solver */
@@ -74,6 +81,7 @@ GLOBAL int64 NR_iteration_limit INIT(500);			/**< Newton-Raphson iteration limit
 GLOBAL bool NR_dyn_first_run INIT(true);			/**< Newton-Raphson first run indicator - used by deltamode functionality for initialization powerflow */
 GLOBAL bool NR_admit_change INIT(true);				/**< Newton-Raphson admittance matrix change detector - used to prevent complete recalculation of admittance at every timestep */
 GLOBAL int NR_superLU_procs INIT(1);				/**< Newton-Raphson related - superLU MT processor count to request - separate from thread_count */
+GLOBAL int NR_stamp_procs INIT(0);				/**< Newton-Raphson related - threads used for the per-bus load and matrix updates - 0 uses thread_count */
 GLOBAL TIMESTAMP NR_retval INIT(TS_NEVER);			/**< Newton-Raphson current return value - if t0 objects know we aren't going anywhere */
 GLOBAL OBJECT *NR_swing_bus INIT(NULL);				/**< Newton-Raphson swing bus */
 GLOBAL int NR_swing_bus_reference INIT(-1);			/**< Newton-Raphson swing bus index reference in NR_busdata */
@@ -120,6 +128,7 @@ GLOBAL double default_resistance INIT(1e-4);		/**< sets the default resistance f
 GLOBAL bool enable_inrush_calculations INIT(false);	/**< Flag to enable in-rush calculations in deltamode */
 GLOBAL double impedance_conversion_low_pu INIT(0.7);	/** Lower PU voltage level to convert all loads to impedance */
 GLOBAL double deltatimestep_running INIT(-1.0);			/** Value of the current deltamode simulation - used for integration method in in-rush */
+GLOBAL bool deltamode_fixed_step INIT(false);		/** Set by objects whose deltamode models count timesteps, so adaptive deltamode keeps the module timestep */
 
 //Mesh fault current stuff
 GLOBAL bool enable_mesh_fault_current INIT(false);	/** Flag to enable mesh-based fault current calculations */
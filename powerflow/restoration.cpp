@@ -4752,9 +4752,27 @@ void LinkedBase::DFS2(int s)
 }
 
 //visits vertices in depth first search and marks them as visited; u is a vertex
+//Keeps the path in an explicit stack (vertex and the next vertex to explore from it), since a
+//long feeder is too deep to recurse down.  Each vertex's own iterator holds its place in the adjacency list.
 void LinkedBase::DFSVisit(int u)
 {
-	int v;
+	int *stack_vertex, *stack_next;
+	int v, top;
+
+	//A path never holds more than every vertex
+	stack_vertex = (int *)gl_malloc(numVertices*sizeof(int));
+	stack_next = (int *)gl_malloc(numVertices*sizeof(int));
+
+	//Make sure it worked
+	if ((stack_vertex == NULL) || (stack_next == NULL))
+	{
+		GL_THROW("Restoration:Failed to allocate depth-first search stack");
+		/*  TROUBLESHOOT
+		While allocating the working stack for a depth-first search of the restoration graph, memory
+		could not be allocated.  Please try again.  If the error persists, please submit your code and
+		a bug report via the ticketing system.
+		*/
+	}
 
 	status_value[u] = 1;
 
@@ -4762,22 +4780,46 @@ void LinkedBase::DFSVisit(int u)
 
 	dTime[u] = dfs_time;
 
-	v = beginVertex(u);
-    
-	while (v != -1) // Explore eage (u, v)
+	stack_vertex[0] = u;
+	stack_next[0] = beginVertex(u);
+	top = 0;
+
+	while (top >= 0)
 	{
-        if (status_value[v] == 0)
+		u = stack_vertex[top];
+		v = stack_next[top];
+
+		if (v == -1)	//Out of edges
 		{
-			parent_value[v] = u;
-			DFSVisit(v);
+			status_value[u] = 2;	//Finished
+			dfs_time = dfs_time + 1;
+			fTime[u] = dfs_time;
+
+			top--;
+			continue;
 		}
 
-		v = nextVertex(u);
+		//Move on for when we get back to u
+		stack_next[top] = nextVertex(u);
+
+		if (status_value[v] == 0)	// Explore eage (u, v)
+		{
+			parent_value[v] = u;
+
+			status_value[v] = 1;
+
+			dfs_time = dfs_time + 1;
+
+			dTime[v] = dfs_time;
+
+			top++;
+			stack_vertex[top] = v;
+			stack_next[top] = beginVertex(v);
+		}
 	}
 
-	status_value[u] = 2;	//Finished
-	dfs_time = dfs_time + 1;
-	fTime[u] = dfs_time;
+	gl_free(stack_vertex);
+	gl_free(stack_next);
 }
 
 // Copy graph: make graph2 a copy of graph1 
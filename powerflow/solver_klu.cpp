@@ -0,0 +1,866 @@
+/* $Id
+ * Built-in sparse LU solver for Newton-Raphson (KLU-style)
+ *
+ * Circuit matrices are very sparse, nearly structurally symmetric and keep the
+ * same pattern from one NR iteration to the next.  This solver follows the
+ * approach of KLU (Davis & Palamadai Natarajan):
+ *   - a maximum transversal and Tarjan's algorithm permute the matrix to block
+ *     upper triangular form (BTF), so only the diagonal blocks are factored
+ *   - each diagonal block is ordered with minimum degree on A+A' (the same
+ *     ordering code superLU uses, get_perm_c)
+ *   - each block is factored with a left-looking (Gilbert-Peierls) LU with
+ *     threshold partial pivoting that prefers the diagonal
+ *   - when the pattern has not changed, the pivot sequence and the L/U patterns
+ *     are reused and only the numeric values are recomputed (refactor)
+ *
+ * It is registered with the NR solver as lu_solver "KLU" and is called through
+ * the same init/alloc/solve/destroy interface as the external solver libraries.
+ */
+
+#include "solver_klu.h"
+
+#include <pdsp_defs.h>	//superLU_MT - minimum degree ordering (get_perm_c)
+
+/* access to module global variables */
+#include "powerflow.h"
+
+#define KLU_PIVOT_TOL 0.001	//Diagonal preference - the diagonal is kept as pivot if it is at least this fraction of the column maximum
+
+//Grows one of the factor arrays (index and value pair) to hold at least needed entries
+static void klu_grow(int **ind, double **val, unsigned int *max_size, unsigned int needed)
+{
+	unsigned int new_size;
+	int *new_ind;
+	double *new_val;
+
+	if (needed <= *max_size)
+		return;
+
+	new_size = (*max_size)*2;
+	if (new_size < needed)
+		new_size = needed;
+
+	new_ind = (int *)realloc(*ind,new_size*sizeof(int));
+	new_val = (double *)realloc(*val,new_size*sizeof(double));
+
+	if ((new_ind == NULL) || (new_val == NULL))
+	{
+		GL_THROW("KLU: failed to allocate memory for the LU factors");
+		/*  TROUBLESHOOT
+		While growing the storage for the L or U factors of the built-in KLU solver, a memory
+		allocation failed.  The system may be too large for the available memory.  Please try again,
+		or use the default superLU solver.
+		*/
+	}
+
+	*ind = new_ind;
+	*val = new_val;
+	*max_size = new_size;
+}
+
+//Frees the n-sized arrays of the solver
+static void klu_free_arrays(KLU_SOLVER *S)
+{
+	free(S->P);
+	free(S->Pinv);
+	free(S->Q);
+	free(S->R);
+	free(S->piv);
+	free(S->pinv);
+	free(S->Lp);
+	free(S->Up);
+	free(S->Fp);
+	free(S->Udiag);
+	free(S->X);
+	free(S->work);
+	free(S->pat_cols);
+
+	S->P = S->Pinv = S->Q = S->R = S->piv = S->pinv = NULL;
+	S->Lp = S->Up = S->Fp = S->pat_cols = S->work = NULL;
+	S->Udiag = S->X = NULL;
+}
+
+//Maximum transversal - finds a row for every column so the permuted matrix has a zero-free diagonal
+//Returns the number of matched columns (n if structurally nonsingular)
+static int klu_maxtrans(int n, int *Ap, int *Ai, int *jmatch, int *imatch, int *work)
+{
+	int *cheap, *visited, *js, *is, *ps;
+	int i, j, k, p, head, matched;
+	bool found;
+
+	cheap = work;
+	visited = work + n;
+	js = work + 2*n;
+	is = work + 3*n;
+	ps = (int *)malloc(n*sizeof(int));
+	if (ps == NULL)
+		GL_THROW("KLU: failed to allocate memory for the matrix analysis");
+
+	for (k=0; k<n; k++)
+	{
+		jmatch[k] = -1;
+		imatch[k] = -1;
+		cheap[k] = Ap[k];
+		visited[k] = -1;
+	}
+
+	//Keep the natural diagonal wherever it exists - this is almost every column of the NR matrix
+	for (j=0; j<n; j++)
+	{
+		for (p=Ap[j]; p<Ap[j+1]; p++)
+		{
+			if (Ai[p] == j)
+			{
+				jmatch[j] = j;
+				imatch[j] = j;
+				break;
+			}
+		}
+	}
+
+	//Augmenting path search for the rest (iterative depth-first search)
+	for (k=0; k<n; k++)
+	{
+		if (imatch[k] != -1)
+			continue;
+
+		found = false;
+		head = 0;
+		js[0] = k;
+
+		while (head >= 0)
+		{
+			j = js[head];
+
+			if (visited[j] != k)	//First visit - look for an unmatched row first
+			{
+				visited[j] = k;
+
+				for (p=cheap[j]; p<Ap[j+1] && !found; p++)
+				{
+					i = Ai[p];
+					found = (jmatch[i] == -1);
+				}
+				cheap[j] = p;
+
+				if (found)
+				{
+					is[head] = i;
+					break;
+				}
+
+				ps[head] = Ap[j];
+			}
+
+			//Continue the search through matched rows
+			for (p=ps[head]; p<Ap[j+1]; p++)
+			{
+				i = Ai[p];
+
+				if (visited[jmatch[i]] == k)
+					continue;
+
+				ps[head] = p + 1;
+				is[head] = i;
+				js[++head] = jmatch[i];
+				break;
+			}
+
+			if (p == Ap[j+1])
+				head--;
+		}
+
+		if (found)	//Flip the path
+		{
+			for (p=head; p>=0; p--)
+			{
+				jmatch[is[p]] = js[p];
+				imatch[js[p]] = is[p];
+			}
+		}
+	}
+
+	free(ps);
+
+	matched = 0;
+	for (j=0; j<n; j++)
+	{
+		if (imatch[j] != -1)
+			matched++;
+	}
+
+	return matched;
+}
+
+//Strongly connected components of the column graph of the matched matrix (iterative Tarjan)
+//Components come out in an order that makes the permuted matrix block upper triangular
+static int klu_scc(int n, int *Ap, int *Ai, int *jmatch, int *block, int *work)
+{
+	int *index, *low, *cstack, *sstack, *cptr;
+	int v, w, s, top, stop, counter, nblocks;
+
+	index = work;
+	low = work + n;
+	cstack = work + 2*n;
+	sstack = work + 3*n;
+	cptr = (int *)malloc(n*sizeof(int));
+	if (cptr == NULL)
+		GL_THROW("KLU: failed to allocate memory for the matrix analysis");
+
+	for (v=0; v<n; v++)
+	{
+		index[v] = -1;
+		block[v] = -1;
+	}
+
+	counter = 0;
+	nblocks = 0;
+	stop = -1;
+
+	for (s=0; s<n; s++)
+	{
+		if (index[s] != -1)
+			continue;
+
+		top = 0;
+		cstack[0] = s;
+		index[s] = low[s] = counter++;
+		cptr[s] = Ap[s];
+		sstack[++stop] = s;
+
+		while (top >= 0)
+		{
+			v = cstack[top];
+
+			if (cptr[v] < Ap[v+1])
+			{
+				w = jmatch[Ai[cptr[v]++]];
+
+				if (index[w] == -1)	//Descend
+				{
+					index[w] = low[w] = counter++;
+					cptr[w] = Ap[w];
+					sstack[++stop] = w;
+					cstack[++top] = w;
+				}
+				else if ((block[w] == -1) && (index[w] < low[v]))	//Still on the component stack
+				{
+					low[v] = index[w];
+				}
+			}
+			else
+			{
+				if (low[v] == index[v])	//Root of a component - pop it off
+				{
+					do {
+						w = sstack[stop--];
+						block[w] = nblocks;
+					} while (w != v);
+
+					nblocks++;
+				}
+
+				top--;
+
+				if ((top >= 0) && (low[v] < low[cstack[top]]))
+					low[cstack[top]] = low[v];
+			}
+		}
+	}
+
+	free(cptr);
+
+	return nblocks;
+}
+
+//Symbolic analysis - block triangular form and fill-reducing ordering of each block
+//Returns 0 on success, or the (1-based) column that could not be matched
+static int klu_analyze(KLU_SOLVER *S, int *Ap, int *Ai)
+{
+	int n = S->n;
+	int *jmatch, *imatch, *block, *bstart, *local, *colptr, *rowind, *perm, *order;
+	int b, j, k, k1, nk, p, r, nz;
+	SuperMatrix B_block;
+	NCformat B_store;
+
+	jmatch = (int *)malloc(n*sizeof(int));
+	imatch = (int *)malloc(n*sizeof(int));
+	block = (int *)malloc(n*sizeof(int));
+	bstart = (int *)malloc((n+1)*sizeof(int));
+	local = (int *)malloc(n*sizeof(int));
+
+	if ((jmatch == NULL) || (imatch == NULL) || (block == NULL) || (bstart == NULL) || (local == NULL))
+		GL_THROW("KLU: failed to allocate memory for the matrix analysis");
+		/*  TROUBLESHOOT
+		While performing the ordering of the NR matrix in the built-in KLU solver, a memory allocation
+		failed.  The system may be too large for the available memory.  Please try again, or use the
+		default superLU solver.
+		*/
+
+	S->symbolic_valid = false;
+	S->numeric_valid = false;
+
+	//Zero-free diagonal
+	if (klu_maxtrans(n,Ap,Ai,jmatch,imatch,S->work) != n)
+	{
+		for (j=0; j<n; j++)
+		{
+			if (imatch[j] == -1)
+				break;
+		}
+
+		free(jmatch);
+		free(imatch);
+		free(block);
+		free(bstart);
+		free(local);
+
+		return j + 1;	//Structurally singular
+	}
+
+	//Block triangular form
+	S->nblocks = klu_scc(n,Ap,Ai,jmatch,block,S->work);
+
+	for (b=0; b<=S->nblocks; b++)
+		bstart[b] = 0;
+
+	for (j=0; j<n; j++)
+		bstart[block[j]+1]++;
+
+	for (b=0; b<S->nblocks; b++)
+		bstart[b+1] += bstart[b];
+
+	for (b=0; b<=S->nblocks; b++)
+		S->R[b] = bstart[b];
+
+	//Initial column order - grouped by block
+	for (j=0; j<n; j++)
+	{
+		k = bstart[block[j]]++;
+		S->Q[k] = j;
+		local[j] = k - S->R[block[j]];
+	}
+
+	//Minimum degree ordering of each non-trivial block, on the pattern of the block (rows mapped to their matched column)
+	for (b=0; b<S->nblocks; b++)
+	{
+		k1 = S->R[b];
+		nk = S->R[b+1] - k1;
+
+		if (nk < 3)
+			continue;
+
+		colptr = (int *)malloc((nk+1)*sizeof(int));
+		perm = (int *)malloc(nk*sizeof(int));
+		order = (int *)malloc(nk*sizeof(int));
+
+		nz = 0;
+		for (k=0; k<nk; k++)
+		{
+			j = S->Q[k1+k];
+			for (p=Ap[j]; p<Ap[j+1]; p++)
+			{
+				if (block[jmatch[Ai[p]]] == b)
+					nz++;
+			}
+		}
+
+		rowind = (int *)malloc((nz > 0 ? nz : 1)*sizeof(int));
+
+		if ((colptr == NULL) || (perm == NULL) || (order == NULL) || (rowind == NULL))
+			GL_THROW("KLU: failed to allocate memory for the matrix analysis");
+			//Defined above
+
+		nz = 0;
+		for (k=0; k<nk; k++)
+		{
+			colptr[k] = nz;
+			j = S->Q[k1+k];
+			for (p=Ap[j]; p<Ap[j+1]; p++)
+			{
+				r = jmatch[Ai[p]];
+				if (block[r] == b)
+					rowind[nz++] = local[r];
+			}
+		}
+		colptr[nk] = nz;
+
+		B_store.nnz = nz;
+		B_store.nzval = NULL;
+		B_store.rowind = rowind;
+		B_store.colptr = colptr;
+
+		B_block.Stype = SLU_NC;
+		B_block.Dtype = SLU_D;
+		B_block.Mtype = SLU_GE;
+		B_block.nrow = nk;
+		B_block.ncol = nk;
+		B_block.Store = &B_store;
+
+		get_perm_c(2,&B_block,perm);	//perm[old] = new
+
+		for (k=0; k<nk; k++)
+			order[perm[k]] = S->Q[k1+k];
+
+		for (k=0; k<nk; k++)
+			S->Q[k1+k] = order[k];
+
+		free(colptr);
+		free(rowind);
+		free(perm);
+		free(order);
+	}
+
+	//Rows follow their matched columns
+	for (k=0; k<n; k++)
+	{
+		S->P[k] = imatch[S->Q[k]];
+		S->Pinv[S->P[k]] = k;
+	}
+
+	free(jmatch);
+	free(imatch);
+	free(block);
+	free(bstart);
+	free(local);
+
+	S->symbolic_valid = true;
+
+	return 0;
+}
+
+//Reach of the column pattern through the graph of L (iterative depth-first search)
+//Pattern is returned in xi[top..n-1], in topological order
+static int klu_reach(KLU_SOLVER *S, int start, int top, int *xi, int *stack, int *pstack, int *mark, int stamp)
+{
+	int head, v, c, p, pend;
+	bool done;
+
+	head = 0;
+	stack[0] = start;
+
+	while (head >= 0)
+	{
+		v = stack[head];
+		c = S->pinv[v];
+
+		if (mark[v] != stamp)
+		{
+			mark[v] = stamp;
+			pstack[head] = (c < 0) ? 0 : S->Lp[c];
+		}
+
+		done = true;
+		pend = (c < 0) ? 0 : S->Lp[c+1];
+
+		for (p=pstack[head]; p<pend; p++)
+		{
+			if (mark[S->Li[p]] == stamp)
+				continue;
+
+			pstack[head] = p + 1;
+			stack[++head] = S->Li[p];
+			done = false;
+			break;
+		}
+
+		if (done)
+		{
+			head--;
+			xi[--top] = v;
+		}
+	}
+
+	return top;
+}
+
+//Full numeric factorization with pivoting
+//Returns 0 on success, or the (1-based) column that was numerically singular
+static int klu_factor(KLU_SOLVER *S, int *Ap, int *Ai, double *Ax)
+{
+	int n = S->n;
+	int *xi, *stack, *pstack, *mark;
+	int b, j, k1, k2, col, p, px, r, c, top, ipiv;
+	unsigned int lnz, unz, fnz;
+	double xr, amax, pivot;
+	double *X = S->X;
+
+	xi = S->work;
+	stack = S->work + n;
+	pstack = S->work + 2*n;
+	mark = S->work + 3*n;
+
+	S->numeric_valid = false;
+
+	for (r=0; r<n; r++)
+	{
+		S->pinv[r] = -1;
+		mark[r] = -1;
+	}
+
+	lnz = unz = fnz = 0;
+	S->Lp[0] = S->Up[0] = S->Fp[0] = 0;
+
+	for (b=0; b<S->nblocks; b++)
+	{
+		k1 = S->R[b];
+		k2 = S->R[b+1];
+
+		for (j=k1; j<k2; j++)
+		{
+			col = S->Q[j];
+
+			klu_grow(&S->Li,&S->Lx,&S->max_L,lnz + (k2-k1));
+			klu_grow(&S->Ui,&S->Ux,&S->max_U,unz + (k2-k1));
+			klu_grow(&S->Fi,&S->Fx,&S->max_F,fnz + (Ap[col+1]-Ap[col]));
+
+			//Scatter the column - entries above the block go to the off-diagonal part
+			top = n;
+			for (p=Ap[col]; p<Ap[col+1]; p++)
+			{
+				r = S->Pinv[Ai[p]];
+
+				if (r < k1)
+				{
+					S->Fi[fnz] = r;
+					S->Fx[fnz++] = Ax[p];
+				}
+				else
+				{
+					X[r] = Ax[p];
+
+					if (mark[r] != j)
+						top = klu_reach(S,r,top,xi,stack,pstack,mark,j);
+				}
+			}
+
+			//Sparse triangular solve with the L columns already computed
+			for (px=top; px<n; px++)
+			{
+				r = xi[px];
+				c = S->pinv[r];
+
+				if (c < 0)
+					continue;
+
+				xr = X[r];
+				for (p=S->Lp[c]; p<S->Lp[c+1]; p++)
+					X[S->Li[p]] -= S->Lx[p] * xr;
+			}
+
+			//Pick the pivot - U is stored in the topological order so a refactor can replay it
+			ipiv = -1;
+			amax = -1.0;
+			for (px=top; px<n; px++)
+			{
+				r = xi[px];
+
+				if (S->pinv[r] < 0)
+				{
+					if (fabs(X[r]) > amax)
+					{
+						amax = fabs(X[r]);
+						ipiv = r;
+					}
+				}
+				else
+				{
+					S->Ui[unz] = r;
+					S->Ux[unz++] = X[r];
+				}
+			}
+
+			if ((ipiv == -1) || (amax <= 0.0))
+			{
+				for (px=top; px<n; px++)
+					X[xi[px]] = 0.0;
+
+				return j + 1;
+			}
+
+			if ((S->pinv[j] < 0) && (fabs(X[j]) >= KLU_PIVOT_TOL*amax))
+				ipiv = j;
+
+			pivot = X[ipiv];
+			S->Udiag[j] = pivot;
+			S->piv[j] = ipiv;
+			S->pinv[ipiv] = j;
+
+			for (px=top; px<n; px++)
+			{
+				r = xi[px];
+
+				if (S->pinv[r] < 0)
+				{
+					S->Li[lnz] = r;
+					S->Lx[lnz++] = X[r] / pivot;
+				}
+
+				X[r] = 0.0;
+			}
+
+			S->Lp[j+1] = lnz;
+			S->Up[j+1] = unz;
+			S->Fp[j+1] = fnz;
+		}
+	}
+
+	S->numeric_valid = true;
+	S->factor_count++;
+
+	return 0;
+}
+
+//Numeric refactorization - same pattern, same pivot sequence
+//Returns false if a pivot became too small and a full factorization is needed
+static bool klu_refactor(KLU_SOLVER *S, int *Ap, int *Ai, double *Ax)
+{
+	int b, j, k1, col, p, q, r, c;
+	unsigned int fnz;
+	double xr, amax, pivot;
+	double *X = S->X;
+
+	fnz = 0;
+
+	for (b=0; b<S->nblocks; b++)
+	{
+		k1 = S->R[b];
+
+		for (j=k1; j<S->R[b+1]; j++)
+		{
+			col = S->Q[j];
+
+			for (p=Ap[col]; p<Ap[col+1]; p++)
+			{
+				r = S->Pinv[Ai[p]];
+
+				if (r < k1)
+					S->Fx[fnz++] = Ax[p];
+				else
+					X[r] = Ax[p];
+			}
+
+			for (p=S->Up[j]; p<S->Up[j+1]; p++)
+			{
+				r = S->Ui[p];
+				c = S->pinv[r];
+				xr = X[r];
+				S->Ux[p] = xr;
+				X[r] = 0.0;
+
+				for (q=S->Lp[c]; q<S->Lp[c+1]; q++)
+					X[S->Li[q]] -= S->Lx[q] * xr;
+			}
+
+			pivot = X[S->piv[j]];
+			X[S->piv[j]] = 0.0;
+
+			amax = fabs(pivot);
+			for (p=S->Lp[j]; p<S->Lp[j+1]; p++)
+			{
+				if (fabs(X[S->Li[p]]) > amax)
+					amax = fabs(X[S->Li[p]]);
+			}
+
+			if ((pivot == 0.0) || (fabs(pivot) < KLU_PIVOT_TOL*amax))
+			{
+				for (p=S->Lp[j]; p<S->Lp[j+1]; p++)
+					X[S->Li[p]] = 0.0;
+
+				S->numeric_valid = false;
+				return false;
+			}
+
+			S->Udiag[j] = pivot;
+
+			for (p=S->Lp[j]; p<S->Lp[j+1]; p++)
+			{
+				S->Lx[p] = X[S->Li[p]] / pivot;
+				X[S->Li[p]] = 0.0;
+			}
+		}
+	}
+
+	S->refactor_count++;
+
+	return true;
+}
+
+//Solves in place using the current factorization
+static void klu_lsolve(KLU_SOLVER *S, double *rhs)
+{
+	int n = S->n;
+	int b, j, k1, k2, p;
+	double xj;
+	double *X = S->X;
+
+	for (j=0; j<n; j++)
+		X[j] = rhs[S->P[j]];
+
+	for (b=S->nblocks-1; b>=0; b--)
+	{
+		k1 = S->R[b];
+		k2 = S->R[b+1];
+
+		//Forward substitution with L
+		for (j=k1; j<k2; j++)
+		{
+			xj = X[S->piv[j]];
+			if (xj != 0.0)
+			{
+				for (p=S->Lp[j]; p<S->Lp[j+1]; p++)
+					X[S->Li[p]] -= S->Lx[p] * xj;
+			}
+		}
+
+		//Back substitution with U, then remove the block from the rows above it
+		for (j=k2-1; j>=k1; j--)
+		{
+			xj = X[S->piv[j]] / S->Udiag[j];
+			X[S->piv[j]] = xj;
+
+			if (xj != 0.0)
+			{
+				for (p=S->Up[j]; p<S->Up[j+1]; p++)
+					X[S->Ui[p]] -= S->Ux[p] * xj;
+
+				for (p=S->Fp[j]; p<S->Fp[j+1]; p++)
+					X[S->Fi[p]] -= S->Fx[p] * xj;
+			}
+		}
+	}
+
+	for (j=0; j<n; j++)
+	{
+		rhs[S->Q[j]] = X[S->piv[j]];
+		X[S->piv[j]] = 0.0;
+	}
+}
+
+//Initialization - called at the start of every NR solution with the previous state
+void *klu_init(void *ext_array)
+{
+	KLU_SOLVER *S;
+
+	if (ext_array != NULL)
+		return ext_array;
+
+	S = (KLU_SOLVER *)gl_malloc(sizeof(KLU_SOLVER));
+
+	if (S != NULL)
+		memset(S,0,sizeof(KLU_SOLVER));
+
+	return (void *)S;
+}
+
+//Allocation - called when the NR matrices are (re)allocated or change size
+void klu_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change)
+{
+	KLU_SOLVER *S = (KLU_SOLVER *)ext_array;
+	unsigned int n = rowcount;
+
+	if ((S->n == n) && (S->P != NULL))
+		return;	//Same size - an unchanged pattern is detected by the solve itself
+
+	klu_free_arrays(S);
+
+	S->n = n;
+	S->symbolic_valid = false;
+	S->numeric_valid = false;
+
+	S->P = (int *)malloc(n*sizeof(int));
+	S->Pinv = (int *)malloc(n*sizeof(int));
+	S->Q = (int *)malloc(n*sizeof(int));
+	S->R = (int *)malloc((n+1)*sizeof(int));
+	S->piv = (int *)malloc(n*sizeof(int));
+	S->pinv = (int *)malloc(n*sizeof(int));
+	S->Lp = (int *)malloc((n+1)*sizeof(int));
+	S->Up = (int *)malloc((n+1)*sizeof(int));
+	S->Fp = (int *)malloc((n+1)*sizeof(int));
+	S->Udiag = (double *)malloc(n*sizeof(double));
+	S->X = (double *)malloc(n*sizeof(double));
+	S->work = (int *)malloc(4*n*sizeof(int));
+	S->pat_cols = (int *)malloc((n+1)*sizeof(int));
+
+	if ((S->P == NULL) || (S->Pinv == NULL) || (S->Q == NULL) || (S->R == NULL) || (S->piv == NULL) || (S->pinv == NULL) ||
+		(S->Lp == NULL) || (S->Up == NULL) || (S->Fp == NULL) || (S->Udiag == NULL) || (S->X == NULL) || (S->work == NULL) ||
+		(S->pat_cols == NULL))
+	{
+		GL_THROW("KLU: failed to allocate memory for the solver");
+		/*  TROUBLESHOOT
+		While allocating the working arrays of the built-in KLU solver, a memory allocation failed.
+		The system may be too large for the available memory.  Please try again, or use the default
+		superLU solver.
+		*/
+	}
+
+	memset(S->X,0,n*sizeof(double));
+}
+
+//Solution - factors (or refactors) the matrix and overwrites rhs_LU with the solution
+int klu_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount)
+{
+	KLU_SOLVER *S = (KLU_SOLVER *)ext_array;
+	int *Ap = system_info_vars->cols_LU;
+	int *Ai = system_info_vars->rows_LU;
+	unsigned int n = rowcount;
+	unsigned int nnz, k;
+	bool same_pattern;
+	int info;
+
+	if ((S == NULL) || (S->n != n) || (S->P == NULL))
+		return -1;
+
+	nnz = Ap[n];
+
+	//See if the symbolic analysis still applies - either the caller knows the pattern is unchanged, or it compares equal
+	same_pattern = (S->symbolic_valid == true) && (S->nnz == nnz);
+
+	if ((same_pattern == true) && (system_info_vars->same_pattern == false))
+	{
+		same_pattern = (memcmp(S->pat_cols,Ap,(n+1)*sizeof(int)) == 0) && (memcmp(S->pat_rows,Ai,nnz*sizeof(int)) == 0);
+	}
+
+	if (same_pattern == false)
+	{
+		if (S->max_pat < nnz)
+		{
+			free(S->pat_rows);
+			S->pat_rows = (int *)malloc(nnz*sizeof(int));
+
+			if (S->pat_rows == NULL)
+				GL_THROW("KLU: failed to allocate memory for the solver");
+				//Defined above
+
+			S->max_pat = nnz;
+		}
+
+		memcpy(S->pat_cols,Ap,(n+1)*sizeof(int));
+		memcpy(S->pat_rows,Ai,nnz*sizeof(int));
+		S->nnz = nnz;
+
+		info = klu_analyze(S,Ap,Ai);
+
+		if (info != 0)
+			return info;
+	}
+
+	//Refactor when possible, otherwise full factorization with pivoting
+	if ((same_pattern == false) || (S->numeric_valid == false) || (klu_refactor(S,Ap,Ai,system_info_vars->a_LU) == false))
+	{
+		info = klu_factor(S,Ap,Ai,system_info_vars->a_LU);
+
+		if (info != 0)
+			return info;
+	}
+
+	for (k=0; k<colcount; k++)
+		klu_lsolve(S,&system_info_vars->rhs_LU[k*n]);
+
+	return 0;
+}
+
+//End of iteration - the factors are kept so the next iteration can refactor
+void klu_destroy(void *ext_array, bool new_iteration)
+{
+}
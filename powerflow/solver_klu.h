@@ -0,0 +1,46 @@
+/* $Id
+ * Built-in sparse LU solver for Newton-Raphson (KLU-style)
+ */
+
+#ifndef _SOLVER_KLU
+#define _SOLVER_KLU
+
+#include "solver_nr.h"
+
+typedef struct {
+	unsigned int n;			///< size of the matrix the solver is allocated for
+	unsigned int nnz;		///< number of non-zero elements in the analyzed pattern
+	bool symbolic_valid;	///< flag indicating the ordering below describes the current pattern
+	bool numeric_valid;		///< flag indicating L, U and F hold a factorization that can be refactored
+	int *pat_cols;			///< column pointers of the analyzed pattern (n+1) - used to detect unchanged patterns
+	int *pat_rows;			///< row indices of the analyzed pattern (nnz)
+	int *P;					///< row permutation from matching/ordering - row k of B is row P[k] of A
+	int *Pinv;				///< inverse of P
+	int *Q;					///< column permutation - column k of B is column Q[k] of A
+	int *R;					///< block boundaries of the block triangular form (nblocks+1)
+	int nblocks;			///< number of diagonal blocks
+	int *piv;				///< pivot row (in B) of each column
+	int *pinv;				///< pivot column of each row of B (-1 while unpivoted)
+	int *Lp, *Li;			///< unit lower triangular factor - column pointers and rows in B (pivot row omitted)
+	double *Lx;				///< values of L
+	int *Up, *Ui;			///< upper triangular factor - column pointers and rows in B (diagonal held in Udiag)
+	double *Ux;				///< values of U
+	double *Udiag;			///< diagonal of U
+	int *Fp, *Fi;			///< off-diagonal blocks of the block triangular form - column pointers and rows in B
+	double *Fx;				///< values of F
+	unsigned int max_L;		///< allocated size of Li/Lx
+	unsigned int max_U;		///< allocated size of Ui/Ux
+	unsigned int max_F;		///< allocated size of Fi/Fx
+	unsigned int max_pat;	///< allocated size of pat_rows
+	double *X;				///< dense work vector (n)
+	int *work;				///< integer work space (4n)
+	unsigned int factor_count;		///< number of full factorizations performed
+	unsigned int refactor_count;	///< number of numeric-only refactorizations performed
+} KLU_SOLVER;
+
+void *klu_init(void *ext_array);
+void klu_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change);
+int klu_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount);
+void klu_destroy(void *ext_array, bool new_iteration);
+
+#endif
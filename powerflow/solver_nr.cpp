@@ -46,6 +46,8 @@ Initialization after returning to service?
 /* access to module global variables */
 #include "powerflow.h"
 
+#include <pthread.h>
+
 //Generic solver variables
 NR_SOLVER_VARS matrices_LU;
 
@@ -56,6 +58,41 @@ SuperMatrix A_LU,B_LU;
 //External solver global
 void *ext_solver_glob_vars;
 
+//Built-in LU solver backends
+#define NR_LU_BACKEND_MAX 8
+static LU_SOLVER_BACKEND lu_backends[NR_LU_BACKEND_MAX];
+static unsigned int lu_backend_count = 0;
+
+//Adds a built-in LU solver backend - returns 1 on success, 0 if the name is taken or the table is full
+int lu_solver_register(const char *name, LUINITFCN init, LUALLOCFCN alloc, LUSOLVEFCN solve, LUDESTROYFCN destroy)
+{
+	if ((lu_solver_find(name) != NULL) || (lu_backend_count >= NR_LU_BACKEND_MAX))
+		return 0;
+
+	lu_backends[lu_backend_count].name = name;
+	lu_backends[lu_backend_count].init = init;
+	lu_backends[lu_backend_count].alloc = alloc;
+	lu_backends[lu_backend_count].solve = solve;
+	lu_backends[lu_backend_count].destroy = destroy;
+	lu_backend_count++;
+
+	return 1;
+}
+
+//Looks up a built-in LU solver backend by name - NULL if there isn't one
+LU_SOLVER_BACKEND *lu_solver_find(const char *name)
+{
+	unsigned int index;
+
+	for (index=0; index<lu_backend_count; index++)
+	{
+		if (strcmp(lu_backends[index].name,name) == 0)
+			return &lu_backends[index];
+	}
+
+	return NULL;
+}
+
 //Initialize the sparse notation
 void sparse_init(SPARSE* sm, int nels, int ncols)
 {
@@ -194,7 +231,135 @@ inline void sparse_add(SPARSE* sm, int row, int col, double value)
 		sm->cols[col] = new_list_element;
 }
 
-void sparse_tonr(SPARSE* sm, NR_SOLVER_VARS *matrices_LU)
+//Initialize the triplet sparse notation
+void sparse_coo_init(SPARSE_COO* sm, int nels, int ncols)
+{
+	//Allocate the element arrays on the GLD heap
+	sm->row_ind = (int*)gl_malloc(nels*sizeof(int));
+	sm->col_ind = (int*)gl_malloc(nels*sizeof(int));
+	sm->value = (double*)gl_malloc(nels*sizeof(double));
+	sm->order = (unsigned int*)gl_malloc(nels*sizeof(unsigned int));
+	sm->work = (unsigned int*)gl_malloc(nels*sizeof(unsigned int));
+
+	//Bucket offsets - one extra so each bucket has an end
+	sm->count = (unsigned int*)gl_malloc((ncols+1)*sizeof(unsigned int));
+
+	//Check them
+	if ((sm->row_ind == NULL) || (sm->col_ind == NULL) || (sm->value == NULL) || (sm->order == NULL) || (sm->work == NULL) || (sm->count == NULL))
+	{
+		GL_THROW("NR: Sparse matrix allocation failed");
+		//Defined above
+	}
+
+	//Init others
+	sm->nels = 0;
+	sm->max_nels = nels;
+	sm->ncols = ncols;
+}
+
+//Free up/clear the triplet sparse allocations
+void sparse_coo_clear(SPARSE_COO* sm)
+{
+	//Clear them up
+	gl_free(sm->row_ind);
+	gl_free(sm->col_ind);
+	gl_free(sm->value);
+	gl_free(sm->order);
+	gl_free(sm->work);
+	gl_free(sm->count);
+
+	//Null them, because I'm paranoid
+	sm->row_ind = NULL;
+	sm->col_ind = NULL;
+	sm->value = NULL;
+	sm->order = NULL;
+	sm->work = NULL;
+	sm->count = NULL;
+
+	//Zero the sizes
+	sm->nels = 0;
+	sm->max_nels = 0;
+	sm->ncols = 0;
+}
+
+//Empty the triplet list - reallocates if the new matrix won't fit
+void sparse_coo_reset(SPARSE_COO* sm, int nels, int ncols)
+{
+	if ((sm->max_nels < (unsigned int)nels) || (sm->ncols != (unsigned int)ncols))
+	{
+		sparse_coo_clear(sm);
+		sparse_coo_init(sm, nels, ncols);
+	}
+	else
+	{
+		sm->nels = 0;
+	}
+}
+
+//Add in new elements to the triplet notation - ordering and duplicate checks are deferred to sparse_coo_sort
+inline void sparse_coo_add(SPARSE_COO* sm, int row, int col, double value)
+{
+	sm->row_ind[sm->nels] = row;
+	sm->col_ind[sm->nels] = col;
+	sm->value[sm->nels] = value;
+	sm->nels++;
+}
+
+//Order the triplets by column, then row - a counting sort on the row, followed by a stable counting sort on the column
+void sparse_coo_sort(SPARSE_COO* sm)
+{
+	unsigned int indexval, location;
+
+	//Row pass - bucket sizes
+	memset(sm->count, 0, (sm->ncols+1)*sizeof(unsigned int));
+	for (indexval=0; indexval<sm->nels; indexval++)
+	{
+		sm->count[sm->row_ind[indexval]+1]++;
+	}
+
+	//Convert to bucket starting points
+	for (indexval=0; indexval<sm->ncols; indexval++)
+	{
+		sm->count[indexval+1] += sm->count[indexval];
+	}
+
+	//Distribute
+	for (indexval=0; indexval<sm->nels; indexval++)
+	{
+		sm->work[sm->count[sm->row_ind[indexval]]++] = indexval;
+	}
+
+	//Column pass - same thing, but walking the row-sorted order so rows stay sorted within each column
+	memset(sm->count, 0, (sm->ncols+1)*sizeof(unsigned int));
+	for (indexval=0; indexval<sm->nels; indexval++)
+	{
+		sm->count[sm->col_ind[indexval]+1]++;
+	}
+
+	for (indexval=0; indexval<sm->ncols; indexval++)
+	{
+		sm->count[indexval+1] += sm->count[indexval];
+	}
+
+	for (indexval=0; indexval<sm->nels; indexval++)
+	{
+		location = sm->work[indexval];
+		sm->order[sm->count[sm->col_ind[location]]++] = location;
+	}
+
+	//Duplicate check -- duplicates are now adjacent
+	for (indexval=1; indexval<sm->nels; indexval++)
+	{
+		if ((sm->col_ind[sm->order[indexval]] == sm->col_ind[sm->order[indexval-1]]) && (sm->row_ind[sm->order[indexval]] == sm->row_ind[sm->order[indexval-1]]))
+		{
+			GL_THROW("NR: duplicate admittance entry found - check for parallel circuits between common nodes!");
+			//Defined above
+		}
+	}
+}
+
+//Convert the sparse notation to compressed column form - slot (if not NULL) records where each heap element landed
+void sparse_tonr(SPARSE* sm, NR_SOLVER_VARS *matrices_LU, int *slot)
 {
 	//traverse each linked list, which are in order, and copy values into new array
 	unsigned int rowidx = 0;
@@ -215,12 +380,427 @@ void sparse_tonr(SPARSE* sm, NR_SOLVER_VARS *matrices_LU)
 		{
 			matrices_LU->rows_LU[rowidx] = LL_pointer->row_ind; // row pointers of non zero values
 			matrices_LU->a_LU[rowidx] = LL_pointer->value;
+			if (slot != NULL)
+			{
+				slot[LL_pointer - sm->llheap] = rowidx;	//Heap elements are handed out in assembly order
+			}
 			++rowidx;
 			LL_pointer = LL_pointer->next;
 		}		
 	}
 }
 
+//Convert the sorted triplet notation to compressed column form - slot (if not NULL) records where each element landed
+void sparse_coo_tonr(SPARSE_COO* sm, NR_SOLVER_VARS *matrices_LU, int *slot)
+{
+	unsigned int colidx = 0;
+	unsigned int i, location;
+
+	matrices_LU->cols_LU[0] = 0;
+	for (i = 0; i < sm->nels; i++)
+	{
+		location = sm->order[i];
+
+		//New column - mark its start (empty columns are skipped, same as the linked-list version)
+		if ((i == 0) || (sm->col_ind[location] != sm->col_ind[sm->order[i-1]]))
+		{
+			matrices_LU->cols_LU[colidx++] = i;
+		}
+
+		matrices_LU->rows_LU[i] = sm->row_ind[location];
+		matrices_LU->a_LU[i] = sm->value[location];
+		if (slot != NULL)
+		{
+			slot[location] = i;	//Elements are indexed in assembly order
+		}
+	}
+}
+
+//Scatter element values into the cached compressed column pattern
+//Returns false if an element is not where the pattern expects it (structure changed)
+bool sparse_scatter(Y_NR *elements, unsigned int count, int *slot, NR_SOLVER_VARS *matrices_LU)
+{
+	unsigned int indexval;
+	int location;
+
+	for (indexval=0; indexval<count; indexval++)
+	{
+		location = slot[indexval];
+
+		//Make sure the element still belongs to this row and column
+		if ((matrices_LU->rows_LU[location] != elements[indexval].row_ind) || (location < matrices_LU->cols_LU[elements[indexval].col_ind]) || (location >= matrices_LU->cols_LU[elements[indexval].col_ind+1]))
+		{
+			return false;
+		}
+
+		matrices_LU->a_LU[location] = elements[indexval].Y_value;
+	}
+
+	return true;
+}
+
+static void compute_load_values_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status);
+
+//Per-bus update threading - a persistent pool that splits a bus loop into contiguous ranges
+#define NR_STAMP_MIN_BUSES 256	//Fewest buses worth handing to another thread
+
+typedef struct {
+	pthread_t pt;
+	unsigned int n;		//Range this worker handles - the calling thread does range 0
+	unsigned int ran;	//Last job this worker picked up
+} NR_STAMP_THREAD;
+
+//Loop information handed to the range functions
+typedef struct {
+	BUSDATA *bus;
+	NR_SOLVER_STRUCT *powerflow_values;
+	bool jacobian_pass;
+} NR_STAMP_DATA;
+
+static NR_STAMP_THREAD *stamp_thread = NULL;
+static unsigned int n_stamp_threads = 0;		//Includes the calling thread - 0 until set up
+static pthread_mutex_t stamp_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t stamp_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t stamp_done = PTHREAD_COND_INITIALIZER;
+static unsigned int stamp_run = 0;			//Job counter
+static unsigned int stamp_donecount = 0;	//Workers still on the current job
+static bool stamp_busy = false;				//Job in progress - nested or concurrent callers run serially
+static NRSTAMPFCN stamp_fcn;
+static void *stamp_data;
+static unsigned int stamp_count, stamp_nchunks;
+static NR_STAMP_STATUS *stamp_status;
+
+//Run one range of the current job
+static void nr_stamp_chunk(unsigned int chunk)
+{
+	unsigned int start = (unsigned int)(((unsigned long long)stamp_count*chunk)/stamp_nchunks);
+	unsigned int stop = (unsigned int)(((unsigned long long)stamp_count*(chunk+1))/stamp_nchunks);
+
+	stamp_fcn(stamp_data,start,stop,stamp_status);
+}
+
+//Record a range failure - only the first message is kept
+void nr_stamp_fail(NR_STAMP_STATUS *status, const char *format, ...)
+{
+	va_list ptr;
+
+	if (__sync_bool_compare_and_swap(&status->failed,0,1))
+	{
+		va_start(ptr,format);
+		vsnprintf(status->error,sizeof(status->error),format,ptr);
+		va_end(ptr);
+	}
+}
+
+static void *nr_stamp_proc(void *ptr)
+{
+	NR_STAMP_THREAD *data = (NR_STAMP_THREAD*)ptr;
+
+	while (true)
+	{
+		//Wait for a new job
+		pthread_mutex_lock(&stamp_lock);
+		while (data->ran == stamp_run)
+			pthread_cond_wait(&stamp_start,&stamp_lock);
+		data->ran = stamp_run;
+		pthread_mutex_unlock(&stamp_lock);
+
+		//Not every job needs every thread
+		if (data->n < stamp_nchunks)
+			nr_stamp_chunk(data->n);
+
+		//Check in
+		pthread_mutex_lock(&stamp_lock);
+		stamp_donecount--;
+		if (stamp_donecount == 0)
+			pthread_cond_signal(&stamp_done);
+		pthread_mutex_unlock(&stamp_lock);
+	}
+
+	return NULL;
+}
+
+//Start the workers - NR_stamp_procs, or the core thread count if that is 0
+static void nr_stamp_setup(void)
+{
+	char temp_buff[128];
+	int threads;
+	int n;
+
+	if (NR_stamp_procs > 0)
+	{
+		threads = NR_stamp_procs;
+	}
+	else
+	{
+		gl_global_getvar("threadcount",temp_buff,sizeof(temp_buff));
+		threads = atoi(temp_buff);
+	}
+
+	n_stamp_threads = 1;
+
+	if (threads > 1)
+	{
+		stamp_thread = (NR_STAMP_THREAD*)gl_malloc(threads*sizeof(NR_STAMP_THREAD));
+
+		if (stamp_thread == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for the update threads");
+			/*  TROUBLESHOOT
+			While setting up the threads used for the per-bus load and Jacobian updates of the Newton-Raphson
+			solver, memory could not be allocated.  Please try again.  If the error persists, set powerflow::NR_stamp_procs
+			to 1 and submit your code and a bug report via the ticketing system.
+			*/
+		}
+
+		for (n=1; n<threads; n++)
+		{
+			stamp_thread[n].n = n;
+			stamp_thread[n].ran = stamp_run;
+
+			if (pthread_create(&(stamp_thread[n].pt),NULL,nr_stamp_proc,&(stamp_thread[n])) != 0)
+			{
+				gl_warning("NR: only %d of %d update threads could be started",n,threads);
+				/*  TROUBLESHOOT
+				The Newton-Raphson solver was unable to start all of the threads requested for the per-bus load and
+				Jacobian updates.  The updates will continue with the threads that did start.  Reduce powerflow::NR_stamp_procs
+				or the thread count to remove this warning.
+				*/
+				break;
+			}
+
+			n_stamp_threads++;
+		}
+	}
+}
+
+//Number of threads the update loops can be split across (including the calling thread)
+unsigned int nr_stamp_threads(void)
+{
+	if (n_stamp_threads == 0)
+		nr_stamp_setup();
+
+	return n_stamp_threads;
+}
+
+//Run fcn over items 0 to count-1, split across the update threads if there are at least min_count items for each thread
+void nr_stamp_run(unsigned int count, unsigned int min_count, NRSTAMPFCN fcn, void *data)
+{
+	NR_STAMP_STATUS status;
+	unsigned int nchunks;
+
+	status.failed = 0;
+	status.error[0] = '\0';
+
+	if (n_stamp_threads == 0)
+		nr_stamp_setup();
+
+	nchunks = count / min_count;
+	if (nchunks > n_stamp_threads)
+		nchunks = n_stamp_threads;
+
+	pthread_mutex_lock(&stamp_lock);
+	if ((nchunks < 2) || (stamp_busy == true))
+	{
+		pthread_mutex_unlock(&stamp_lock);
+		fcn(data,0,count,&status);
+
+		if (status.failed != 0)
+		{
+			GL_THROW("%s",status.error);
+		}
+		return;
+	}
+
+	//Post the job
+	stamp_busy = true;
+	stamp_fcn = fcn;
+	stamp_data = data;
+	stamp_count = count;
+	stamp_nchunks = nchunks;
+	stamp_status = &status;
+	stamp_donecount = n_stamp_threads - 1;
+	stamp_run++;
+	pthread_cond_broadcast(&stamp_start);
+	pthread_mutex_unlock(&stamp_lock);
+
+	//Do our share
+	nr_stamp_chunk(0);
+
+	//Wait for the rest
+	pthread_mutex_lock(&stamp_lock);
+	while (stamp_donecount > 0)
+		pthread_cond_wait(&stamp_done,&stamp_lock);
+	stamp_busy = false;
+	pthread_mutex_unlock(&stamp_lock);
+
+	if (status.failed != 0)
+	{
+		GL_THROW("%s",status.error);
+	}
+}
+
+//Sizes the contiguous per-phase bus arrays - only ever grows
+static void nr_bus_soa_alloc(NR_BUS_SOA *bus_soa, unsigned int bus_count)
+{
+	double *values;
+
+	if (bus_soa->max_buses >= bus_count)
+		return;
+
+	if (bus_soa->V != NULL)
+	{
+		gl_free(bus_soa->V);
+		gl_free(bus_soa->PL);	//Start of the shared block
+	}
+
+	bus_soa->V = (complex *)gl_malloc(3*bus_count*sizeof(complex));
+	values = (double *)gl_malloc(18*bus_count*sizeof(double));
+
+	if ((bus_soa->V == NULL) || (values == NULL))
+		GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+
+	memset(values,0,18*bus_count*sizeof(double));
+
+	//Loads and Jacobian terms share one block
+	bus_soa->PL = values;
+	bus_soa->QL = &values[3*bus_count];
+	bus_soa->Jacob_A = &values[6*bus_count];
+	bus_soa->Jacob_B = &values[9*bus_count];
+	bus_soa->Jacob_C = &values[12*bus_count];
+	bus_soa->Jacob_D = &values[15*bus_count];
+
+	bus_soa->max_buses = bus_count;
+}
+
+//Copy this range of buses' voltages from the node objects into the contiguous array
+static void bus_soa_gather_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status)
+{
+	BUSDATA *bus = ((NR_STAMP_DATA*)data)->bus;
+	NR_BUS_SOA *bus_soa = &((NR_STAMP_DATA*)data)->powerflow_values->bus_soa;
+	unsigned int indexer;
+
+	for (indexer=start; indexer<stop; indexer++)
+	{
+		bus_soa->V[3*indexer] = bus[indexer].V[0];
+		bus_soa->V[3*indexer+1] = bus[indexer].V[1];
+		bus_soa->V[3*indexer+2] = bus[indexer].V[2];
+	}
+}
+
+//Fill this range of buses' fixed diagonal elements into their preassigned slots of Y_diag_fixed
+static void diag_fixed_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status)
+{
+	BUSDATA *bus = ((NR_STAMP_DATA*)data)->bus;
+	NR_SOLVER_STRUCT *powerflow_values = ((NR_STAMP_DATA*)data)->powerflow_values;
+	unsigned int indexer, jindexer;
+	char jindex, kindex;
+
+	for (jindexer=start; jindexer<stop; jindexer++)	//Parse through bus list
+	{
+		indexer = powerflow_values->BA_diag[jindexer].fixed_loc;
+
+		for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
+		{
+			for (kindex=0; kindex<powerflow_values->BA_diag[jindexer].size; kindex++)
+			{
+				if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
+				{
+					powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
+					powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
+					powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
+					indexer += 1;
+
+					powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
+					powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
+					powerflow_values->Y_diag_fixed[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
+					indexer += 1;
+				}
+
+				if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
+				{
+					powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
+					powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
+					powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
+					indexer += 1;
+					
+					powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
+					powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
+					powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
+					indexer += 1;
+				}
+			}
+		}
+	}
+}
+
+//Fill this range of buses' updated diagonal elements into their preassigned slots of Y_diag_update
+static void diag_update_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status)
+{
+	BUSDATA *bus = ((NR_STAMP_DATA*)data)->bus;
+	NR_SOLVER_STRUCT *powerflow_values = ((NR_STAMP_DATA*)data)->powerflow_values;
+	NR_BUS_SOA *bus_soa = &powerflow_values->bus_soa;
+	unsigned int indexer, jindexer;
+	char jindex;
+
+	for (jindexer=start; jindexer<stop; jindexer++)	//Parse through bus list
+	{
+		indexer = powerflow_values->BA_diag[jindexer].update_loc;
+
+		if ((bus[jindexer].type > 1) && (bus[jindexer].swing_functions_enabled == true))	//Swing bus - and we aren't ignoring it
+		{
+			for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
+			{
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
+				indexer += 1;
+
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
+				indexer += 1;
+
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind - powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
+				indexer += 1;
+
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
+				indexer += 1;
+			}//End swing bus traversion
+		}//End swing bus
+
+		if ((bus[jindexer].type == 0) || ((bus[jindexer].type > 1) && bus[jindexer].swing_functions_enabled == false))	//Only do on PQ (or SWING masquerading as PQ)
+		{
+			for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
+			{
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus_soa->Jacob_A[3*jindexer+jindex]; // Equation(14)
+				indexer += 1;
+				
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus_soa->Jacob_B[3*jindexer+jindex]; // Equation(15)
+				indexer += 1;
+				
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus_soa->Jacob_C[3*jindexer+jindex]; // Equation(16)
+				indexer += 1;
+				
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus_soa->Jacob_D[3*jindexer+jindex]; // Equation(17)
+				indexer += 1;
+			}//end PQ phase traversion
+		}//End PQ bus
+	}
+}
+
 /** Newton-Raphson solver
 	Solves a power flow problem using the Newton-Raphson method
 	
@@ -319,6 +899,18 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	SP_E *temp_element;
 	int row, col;
 	double value;
+
+	//Sparsity pattern reuse flag
+	bool use_cached_pattern;
+
+	//Matrix assembly timing
+	clock_t assembly_start;
+
+	//Per-bus update loop information
+	NR_STAMP_DATA stamp_data_vals;
+
+	//Contiguous per-phase bus values
+	NR_BUS_SOA *bus_soa;
 	
 #ifndef MT
 	superlu_options_t options;	//Additional variables for sequential superLU
@@ -328,6 +920,15 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	//Random init
 	index_count = 0;
 
+	//Loop information for the threaded per-bus updates
+	stamp_data_vals.bus = bus;
+	stamp_data_vals.powerflow_values = powerflow_values;
+	stamp_data_vals.jacobian_pass = false;
+
+	//Make sure the contiguous bus arrays can hold every bus
+	nr_bus_soa_alloc(&powerflow_values->bus_soa,bus_count);
+	bus_soa = &powerflow_values->bus_soa;
+
 	//Ensure bad computations flag is set first
 	*bad_computations = false;
 
@@ -398,6 +999,10 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 
 	if (NR_admit_change)	//If an admittance update was detected, fix it
 	{
+		//Topology may change, so the cached sparsity pattern and its column ordering can't be trusted
+		powerflow_values->Y_pattern.valid = false;
+		powerflow_values->Y_pattern.perm_c_valid = false;
+
 		//Build the diagonal elements of the bus admittance matrix - this should only happen once no matter what
 		if (powerflow_values->BA_diag == NULL)
 		{
@@ -2085,6 +2690,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 		powerflow_values->size_diag_fixed = 0;
 		for (jindexer=0; jindexer<bus_count;jindexer++) 
 		{
+			//Each bus's elements start where the previous bus's end (two entries per count)
+			powerflow_values->BA_diag[jindexer].fixed_loc = powerflow_values->size_diag_fixed*2;
+
 			for (jindex=0; jindex<3; jindex++)
 			{
 				for (kindex=0; kindex<3; kindex++)
@@ -2127,41 +2735,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			powerflow_values->NR_realloc_needed = true;
 		}
 
-		indexer = 0;
-		for (jindexer=0; jindexer<bus_count;jindexer++)	//Parse through bus list
-		{ 
-			for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
-			{
-				for (kindex=0; kindex<powerflow_values->BA_diag[jindexer].size; kindex++)
-				{					
-					if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
-					{
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
-						indexer += 1;
-
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
-						indexer += 1;
-					}
-
-					if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
-					{
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
-						indexer += 1;
-						
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
-						indexer += 1;
-					}
-				}
-			}
-		}//End bus parse for fixed diagonal
+		//Fill each bus's elements into the slots assigned above
+		nr_stamp_run(bus_count,NR_STAMP_MIN_BUSES,diag_fixed_range,&stamp_data_vals);
 	}//End admittance update
 
 	//Reset saturation checks
@@ -2170,6 +2745,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	//Calculate the system load - this is the specified power of the system
 	for (Iteration=0; Iteration<NR_iteration_limit; Iteration++)
 	{
+		//Bring the voltages into the contiguous array - they only change at the end of each iteration
+		nr_stamp_run(bus_count,NR_STAMP_MIN_BUSES,bus_soa_gather_range,&stamp_data_vals);
+
 		//Call the load subfunction
 		compute_load_values(bus_count,bus,powerflow_values,false);
 	
@@ -2219,41 +2797,41 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
 				{
 					//Form denominator term of Ii, since it won't change
-					temp_complex_1 = (~bus[indexer].V[0]) + (~bus[indexer].V[1])*avalsq + (~bus[indexer].V[2])*aval;
+					temp_complex_1 = (~bus_soa->V[3*indexer+0]) + (~bus_soa->V[3*indexer+1])*avalsq + (~bus_soa->V[3*indexer+2])*aval;
 					
 					//Form up numerator portion that doesn't change (Q and admittance)
 					//Do in parts, just for readability
-					temp_complex_2 = ~bus[indexer].V[0];	//conj(Va)
+					temp_complex_2 = ~bus_soa->V[3*indexer+0];	//conj(Va)
 					
 					//Row 1 of admittance mult
-					temp_complex_0 = temp_complex_2*(bus[indexer].full_Y[0]*bus[indexer].V[0] + bus[indexer].full_Y[1]*bus[indexer].V[1] + bus[indexer].full_Y[2]*bus[indexer].V[2]);
+					temp_complex_0 = temp_complex_2*(bus[indexer].full_Y[0]*bus_soa->V[3*indexer+0] + bus[indexer].full_Y[1]*bus_soa->V[3*indexer+1] + bus[indexer].full_Y[2]*bus_soa->V[3*indexer+2]);
 
 					// Row 1 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus 
-					temp_complex_5 = bus[indexer].full_Y[0]*bus[indexer].V[0] + bus[indexer].full_Y[1]*bus[indexer].V[1] + bus[indexer].full_Y[2]*bus[indexer].V[2];
+					temp_complex_5 = bus[indexer].full_Y[0]*bus_soa->V[3*indexer+0] + bus[indexer].full_Y[1]*bus_soa->V[3*indexer+1] + bus[indexer].full_Y[2]*bus_soa->V[3*indexer+2];
 					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 = bus[indexer].V[0]*temp_complex_4;
+					temp_complex_3 = bus_soa->V[3*indexer+0]*temp_complex_4;
 
 					//conj(Vb)
-					temp_complex_2 = ~bus[indexer].V[1];
+					temp_complex_2 = ~bus_soa->V[3*indexer+1];
 
 					//Row 2 of admittance
-					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[3]*bus[indexer].V[0] + bus[indexer].full_Y[4]*bus[indexer].V[1] + bus[indexer].full_Y[5]*bus[indexer].V[2]);
+					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[3]*bus_soa->V[3*indexer+0] + bus[indexer].full_Y[4]*bus_soa->V[3*indexer+1] + bus[indexer].full_Y[5]*bus_soa->V[3*indexer+2]);
 					
 					// Row 2 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
-					temp_complex_5 = bus[indexer].full_Y[3]*bus[indexer].V[0] + bus[indexer].full_Y[4]*bus[indexer].V[1] + bus[indexer].full_Y[5]*bus[indexer].V[2];
+					temp_complex_5 = bus[indexer].full_Y[3]*bus_soa->V[3*indexer+0] + bus[indexer].full_Y[4]*bus_soa->V[3*indexer+1] + bus[indexer].full_Y[5]*bus_soa->V[3*indexer+2];
 					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 += bus[indexer].V[1]*temp_complex_4;
+					temp_complex_3 += bus_soa->V[3*indexer+1]*temp_complex_4;
 
 					//conj(Vc)
-					temp_complex_2 = ~bus[indexer].V[2];
+					temp_complex_2 = ~bus_soa->V[3*indexer+2];
 
 					//Row 3 of admittance
-					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[6]*bus[indexer].V[0] + bus[indexer].full_Y[7]*bus[indexer].V[1] + bus[indexer].full_Y[8]*bus[indexer].V[2]);
+					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[6]*bus_soa->V[3*indexer+0] + bus[indexer].full_Y[7]*bus_soa->V[3*indexer+1] + bus[indexer].full_Y[8]*bus_soa->V[3*indexer+2]);
 
 					// Row 3 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
-					temp_complex_5 = bus[indexer].full_Y[6]*bus[indexer].V[0] + bus[indexer].full_Y[7]*bus[indexer].V[1] + bus[indexer].full_Y[8]*bus[indexer].V[2];
+					temp_complex_5 = bus[indexer].full_Y[6]*bus_soa->V[3*indexer+0] + bus[indexer].full_Y[7]*bus_soa->V[3*indexer+1] + bus[indexer].full_Y[8]*bus_soa->V[3*indexer+2];
 					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 += bus[indexer].V[2]*temp_complex_4;					
+					temp_complex_3 += bus_soa->V[3*indexer+2]*temp_complex_4;					
 
 					//numerator done, except PT portion (add in below - SWING bus is different
 
@@ -2281,24 +2859,24 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 					if ((bus[indexer].phases & 0x20) == 0x20)	//We're the To bus
 					{
 						//Pre-negated due to the nature of how it's calculated (V1 compared to I1)
-						tempPbus =  bus[indexer].PL[jindex];	//Copy load amounts in
-						tempQbus =  bus[indexer].QL[jindex];	
+						tempPbus =  bus_soa->PL[3*indexer+jindex];	//Copy load amounts in
+						tempQbus =  bus_soa->QL[3*indexer+jindex];	
 					}
 					else	//We're just a normal triplex bus
 					{
 						//This one isn't negated (normal operations)
-						tempPbus =  -bus[indexer].PL[jindex];	//Copy load amounts in
-						tempQbus =  -bus[indexer].QL[jindex];	
+						tempPbus =  -bus_soa->PL[3*indexer+jindex];	//Copy load amounts in
+						tempQbus =  -bus_soa->QL[3*indexer+jindex];	
 					}//end normal triplex bus
 
 					//Get diagonal contributions - only (& always) 2
 					//Column 1
-					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus[indexer].V[0]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus[indexer].V[0]).Im();// equation (7), the diag elements of bus admittance matrix 
-					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus[indexer].V[0]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus[indexer].V[0]).Re();// equation (8), the diag elements of bus admittance matrix 
+					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus_soa->V[3*indexer+0]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus_soa->V[3*indexer+0]).Im();// equation (7), the diag elements of bus admittance matrix 
+					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus_soa->V[3*indexer+0]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus_soa->V[3*indexer+0]).Re();// equation (8), the diag elements of bus admittance matrix 
 
 					//Column 2
-					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus[indexer].V[1]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus[indexer].V[1]).Im();// equation (7), the diag elements of bus admittance matrix 
-					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus[indexer].V[1]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus[indexer].V[1]).Re();// equation (8), the diag elements of bus admittance matrix 
+					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus_soa->V[3*indexer+1]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus_soa->V[3*indexer+1]).Im();// equation (7), the diag elements of bus admittance matrix 
+					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus_soa->V[3*indexer+1]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus_soa->V[3*indexer+1]).Re();// equation (8), the diag elements of bus admittance matrix 
 
 					//Now off diagonals
 					for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size); kindexer++)
@@ -2315,12 +2893,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								//This situation can only be a normal line (triplex will never be the from for another type)
 								//Again only, & always 2 columns (just do them explicitly)
 								//Column 1
-								tempIcalcReal += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].to+0]).Re() - ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].to+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].to+0]).Im() + ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].to+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 								//Column2
-								tempIcalcReal += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus_soa->V[3*branch[jindexer].to+1]).Re() - ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus_soa->V[3*branch[jindexer].to+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus_soa->V[3*branch[jindexer].to+1]).Im() + ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus_soa->V[3*branch[jindexer].to+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 							}//End SPCT To bus - from diagonal contributions
 							else		//Normal line connection to normal triplex
@@ -2329,12 +2907,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								//This situation can only be a normal line (triplex will never be the from for another type)
 								//Again only, & always 2 columns (just do them explicitly)
 								//Column 1
-								tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].to+0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].to+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].to+0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].to+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 								//Column2
-								tempIcalcReal += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus_soa->V[3*branch[jindexer].to+1]).Re() - (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus_soa->V[3*branch[jindexer].to+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus_soa->V[3*branch[jindexer].to+1]).Im() + (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus_soa->V[3*branch[jindexer].to+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 							}//end normal triplex from
 						}//end from bus
@@ -2363,8 +2941,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								work_vals_char_0 = jindex*3+temp_index;
 
 								//Perform the update, it only happens for one column (nature of the transformer)
-								tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[temp_index]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[temp_index]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[temp_index]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[temp_index]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].from+temp_index]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].from+temp_index]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].from+temp_index]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].from+temp_index]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 							}//end transformer
 							else									//Must be a normal line then
@@ -2375,24 +2953,24 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 									//This case should never really exist, but if someone reverses a secondary or is doing meshed secondaries, it might
 									//Again only, & always 2 columns (just do them explicitly)
 									//Column 1
-									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Re() - ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Im() + ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].from+0]).Re() - ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].from+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].from+0]).Im() + ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].from+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 									//Column2
-									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Re() - ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Im() + ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus_soa->V[3*branch[jindexer].from+1]).Re() - ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus_soa->V[3*branch[jindexer].from+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus_soa->V[3*branch[jindexer].from+1]).Im() + ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus_soa->V[3*branch[jindexer].from+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 								}//End SPCT To bus - from diagonal contributions
 								else		//Normal line connection to normal triplex
 								{
 									work_vals_char_0 = jindex*3;
 									//Again only, & always 2 columns (just do them explicitly)
 									//Column 1
-									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].from+0]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].from+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].from+0]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].from+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 									//Column2
-									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Re() - (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Im() + (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus_soa->V[3*branch[jindexer].from+1]).Re() - (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus_soa->V[3*branch[jindexer].from+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus_soa->V[3*branch[jindexer].from+1]).Im() + (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus_soa->V[3*branch[jindexer].from+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 								}//End normal triplex connection
 							}//end normal line
 						}//end to bus
@@ -2433,8 +3011,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				}//End split-phase present
 				else	//Three phase or some variant thereof
 				{
-					tempPbus =  - bus[indexer].PL[jindex];	//Copy load amounts in
-					tempQbus =  - bus[indexer].QL[jindex];	
+					tempPbus =  - bus_soa->PL[3*indexer+jindex];	//Copy load amounts in
+					tempQbus =  - bus_soa->QL[3*indexer+jindex];	
 
 					for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)		//cols - Still only for specified phases
 					{
@@ -2497,14 +3075,14 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 						}
 
 						//Normal diagonal contributions
-						tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus[indexer].V[temp_index]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus[indexer].V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
-						tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus[indexer].V[temp_index]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus[indexer].V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
+						tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus_soa->V[3*indexer+temp_index]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus_soa->V[3*indexer+temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
+						tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus_soa->V[3*indexer+temp_index]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus_soa->V[3*indexer+temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
 
 						//In-rush load contributions (if any) - only along explicit diagonal
 						if ((bus[indexer].full_Y_load != NULL) && (jindex==kindex))
 						{
-							tempIcalcReal += (bus[indexer].full_Y_load[temp_index]).Re() * (bus[indexer].V[temp_index]).Re() - (bus[indexer].full_Y_load[temp_index]).Im() * (bus[indexer].V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
-							tempIcalcImag += (bus[indexer].full_Y_load[temp_index]).Re() * (bus[indexer].V[temp_index]).Im() + (bus[indexer].full_Y_load[temp_index]).Im() * (bus[indexer].V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
+							tempIcalcReal += (bus[indexer].full_Y_load[temp_index]).Re() * (bus_soa->V[3*indexer+temp_index]).Re() - (bus[indexer].full_Y_load[temp_index]).Im() * (bus_soa->V[3*indexer+temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
+							tempIcalcImag += (bus[indexer].full_Y_load[temp_index]).Re() * (bus_soa->V[3*indexer+temp_index]).Im() + (bus[indexer].full_Y_load[temp_index]).Im() * (bus_soa->V[3*indexer+temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
 						}
 
 						//Off diagonal contributions
@@ -2636,12 +3214,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 										work_vals_char_0 = temp_index_b*3;
 										//Do columns individually
 										//1
-										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].to+0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].to+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus_soa->V[3*branch[jindexer].to+0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus_soa->V[3*branch[jindexer].to+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 										//2
-										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus_soa->V[3*branch[jindexer].to+1]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus_soa->V[3*branch[jindexer].to+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus_soa->V[3*branch[jindexer].to+1]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus_soa->V[3*branch[jindexer].to+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 									}
 								}//end SPCT transformer
@@ -2650,8 +3228,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 									work_vals_char_0 = temp_index_b*3+temp_index;
 									work_vals_double_0 = (-branch[jindexer].Yfrom[work_vals_char_0]).Re();
 									work_vals_double_1 = (-branch[jindexer].Yfrom[work_vals_char_0]).Im();
-									work_vals_double_2 = (bus[branch[jindexer].to].V[temp_index]).Re();
-									work_vals_double_3 = (bus[branch[jindexer].to].V[temp_index]).Im();
+									work_vals_double_2 = (bus_soa->V[3*branch[jindexer].to+temp_index]).Re();
+									work_vals_double_3 = (bus_soa->V[3*branch[jindexer].to+temp_index]).Im();
 
 									tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 									tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
@@ -2663,8 +3241,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								work_vals_char_0 = temp_index_b*3+temp_index;
 								work_vals_double_0 = (-branch[jindexer].Yto[work_vals_char_0]).Re();
 								work_vals_double_1 = (-branch[jindexer].Yto[work_vals_char_0]).Im();
-								work_vals_double_2 = (bus[branch[jindexer].from].V[temp_index]).Re();
-								work_vals_double_3 = (bus[branch[jindexer].from].V[temp_index]).Im();
+								work_vals_double_2 = (bus_soa->V[3*branch[jindexer].from+temp_index]).Re();
+								work_vals_double_3 = (bus_soa->V[3*branch[jindexer].from+temp_index]).Im();
 
 								tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 								tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
@@ -2682,7 +3260,7 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 							if (bus[indexer].full_Y != NULL)
 							{
 								//Compute our "power generated" value for this phase - conjugated in formation
-								temp_complex_2 = bus[indexer].V[jindex] * complex(tempIcalcReal,-tempIcalcImag);
+								temp_complex_2 = bus_soa->V[3*indexer+jindex] * complex(tempIcalcReal,-tempIcalcImag);
 
 								if (Iteration>0)	//Only update SWING on subsequent passes
 								{
@@ -2691,12 +3269,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								}
 
 								//Compute the delta_I, just like below - but don't post it (still zero in calcs)
-								work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+								work_vals_double_0 = (bus_soa->V[3*indexer+temp_index_b]).Mag()*(bus_soa->V[3*indexer+temp_index_b]).Mag();
 
 								if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
 								{
-									work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-									work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
+									work_vals_double_1 = (bus_soa->V[3*indexer+temp_index_b]).Re();
+									work_vals_double_2 = (bus_soa->V[3*indexer+temp_index_b]).Im();
 									work_vals_double_3 = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal; // equation(7), Real part of deltaI, left hand side of equation (11)
 									work_vals_double_4 = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
 
@@ -2716,12 +3294,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 							else	//Other generator types
 							{
 								//Compute the delta_I, just like below - but don't post it (still zero in calcs)
-								work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+								work_vals_double_0 = (bus_soa->V[3*indexer+temp_index_b]).Mag()*(bus_soa->V[3*indexer+temp_index_b]).Mag();
 
 								if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
 								{
-									work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-									work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
+									work_vals_double_1 = (bus_soa->V[3*indexer+temp_index_b]).Re();
+									work_vals_double_2 = (bus_soa->V[3*indexer+temp_index_b]).Im();
 									work_vals_double_3 = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal; // equation(7), Real part of deltaI, left hand side of equation (11)
 									work_vals_double_4 = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
 
@@ -2760,12 +3338,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 					}//End SWING bus cases
 					else	//PQ bus or SWING masquerading as a PQ
 					{
-						work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+						work_vals_double_0 = (bus_soa->V[3*indexer+temp_index_b]).Mag()*(bus_soa->V[3*indexer+temp_index_b]).Mag();
 
 						if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
 						{
-							work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-							work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
+							work_vals_double_1 = (bus_soa->V[3*indexer+temp_index_b]).Re();
+							work_vals_double_2 = (bus_soa->V[3*indexer+temp_index_b]).Im();
 
 							//See if deltamode needs to include extra term
 							if (NR_busdata[indexer].BusHistTerm != NULL)
@@ -2912,6 +3490,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 		//Adjust it
 		for (jindexer=0; jindexer<bus_count;jindexer++) 
 		{
+			//Each bus's elements start where the previous bus's end (four entries per phase)
+			powerflow_values->BA_diag[jindexer].update_loc = 4*size_diag_update;
+
 			if  (bus[jindexer].type != 1)	//PV bus ignored (for now?)
 				size_diag_update += powerflow_values->BA_diag[jindexer].size; 
 			//Defaulted else - PV bus ignored
@@ -2947,62 +3528,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			powerflow_values->NR_realloc_needed = true;
 		}
 
-		indexer = 0;	//Rest positional counter
-
-		for (jindexer=0; jindexer<bus_count; jindexer++)	//Parse through bus list
-		{
-			if ((bus[jindexer].type > 1) && (bus[jindexer].swing_functions_enabled == true))	//Swing bus - and we aren't ignoring it
-			{
-				for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
-				{
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
-					indexer += 1;
-
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
-					indexer += 1;
-
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind - powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
-					indexer += 1;
-
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
-					indexer += 1;
-				}//End swing bus traversion
-			}//End swing bus
-
-			if ((bus[jindexer].type == 0) || ((bus[jindexer].type > 1) && bus[jindexer].swing_functions_enabled == false))	//Only do on PQ (or SWING masquerading as PQ)
-			{
-				for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
-				{
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_A[jindex]; // Equation(14)
-					indexer += 1;
-					
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_B[jindex]; // Equation(15)
-					indexer += 1;
-					
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_C[jindex]; // Equation(16)
-					indexer += 1;
-					
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_D[jindex]; // Equation(17)
-					indexer += 1;
-				}//end PQ phase traversion
-			}//End PQ bus
-		}//End bus parse list
+		//Fill each bus's elements into the slots assigned above
+		nr_stamp_run(bus_count,NR_STAMP_MIN_BUSES,diag_update_range,&stamp_data_vals);
 
 		// Build the Amatrix, Amatrix includes all the elements of Y_offdiag_PQ, Y_diag_fixed and Y_diag_update.
 		size_Amatrix = powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2 + 4*size_diag_update;
@@ -3021,141 +3548,214 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			return 0;					//Just return some arbitrary value - not technically bad
 		}
 
-		if (powerflow_values->Y_Amatrix == NULL)
+		//See if the sparsity pattern from the last build still applies - if so, just drop the new values in place
+		use_cached_pattern = ((powerflow_values->Y_pattern.valid == true) && (powerflow_values->NR_realloc_needed == false) && (powerflow_values->Y_pattern.nnz == size_Amatrix) && (powerflow_values->prev_m == 2*powerflow_values->total_variables) && (NRMatDumpMethod == MD_NONE) && (NR_pattern_cache == true));
+
+		if (use_cached_pattern == true)
 		{
-			powerflow_values->Y_Amatrix = (SPARSE*) gl_malloc(sizeof(SPARSE));
+			use_cached_pattern = sparse_scatter(powerflow_values->Y_offdiag_PQ,powerflow_values->size_offdiag_PQ*2,powerflow_values->Y_pattern.slot,&matrices_LU);
 
-			//Make sure it worked
-			if (powerflow_values->Y_Amatrix == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			if (use_cached_pattern == true)
+				use_cached_pattern = sparse_scatter(powerflow_values->Y_diag_fixed,powerflow_values->size_diag_fixed*2,&powerflow_values->Y_pattern.slot[powerflow_values->size_offdiag_PQ*2],&matrices_LU);
 
-			//Initiliaze it
-			sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
-		}
-		else if (powerflow_values->NR_realloc_needed)	//If one of the above changed, we changed too
-		{
-			//Destroy the old version
-			sparse_clear(powerflow_values->Y_Amatrix);
+			if (use_cached_pattern == true)
+				use_cached_pattern = sparse_scatter(powerflow_values->Y_diag_update,4*size_diag_update,&powerflow_values->Y_pattern.slot[powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2],&matrices_LU);
 
-			//Create a new 
-			sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
-		}
-		else
-		{
-			//Just clear it out
-			sparse_reset(powerflow_values->Y_Amatrix, 6*NR_bus_count);
+			//If it didn't match, the structure changed under us - rebuild the pattern
+			if (use_cached_pattern == false)
+				powerflow_values->Y_pattern.valid = false;
 		}
 
-		//integrate off diagonal components
-		for (indexer=0; indexer<powerflow_values->size_offdiag_PQ*2; indexer++)
+		if (use_cached_pattern == false)
 		{
-			row = powerflow_values->Y_offdiag_PQ[indexer].row_ind;
-			col = powerflow_values->Y_offdiag_PQ[indexer].col_ind;
-			value = powerflow_values->Y_offdiag_PQ[indexer].Y_value;
-			sparse_add(powerflow_values->Y_Amatrix, row, col, value);
-		}
+			//Start the assembly timer
+			assembly_start = clock();
 
-		//Integrate fixed portions of diagonal components
-		for (indexer=powerflow_values->size_offdiag_PQ*2; indexer< (powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2); indexer++)
-		{
-			row = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].row_ind;
-			col = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].col_ind;
-			value = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].Y_value;
-			sparse_add(powerflow_values->Y_Amatrix, row, col, value);
-		}
+			if (NRMatAssemblyMethod == MA_SORTED)
+			{
+				if (powerflow_values->Y_Acoo == NULL)
+				{
+					powerflow_values->Y_Acoo = (SPARSE_COO*) gl_malloc(sizeof(SPARSE_COO));
 
-		//Integrate the variable portions of the diagonal components
-		for (indexer=powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2; indexer< size_Amatrix; indexer++)
-		{
-			row = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].row_ind;
-			col = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].col_ind;
-			value = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].Y_value;
-			sparse_add(powerflow_values->Y_Amatrix, row, col, value);
-		}
+					//Make sure it worked
+					if (powerflow_values->Y_Acoo == NULL)
+						GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-		//See if we want to dump out the matrix values
-		if (NRMatDumpMethod != MD_NONE)
-		{
-			//Code to export the sparse matrix values - useful for debugging issues
+					//Initialize it
+					sparse_coo_init(powerflow_values->Y_Acoo, size_Amatrix, 6*NR_bus_count);
+				}
+				else	//Reset it - reallocates itself if the matrix grew
+				{
+					sparse_coo_reset(powerflow_values->Y_Acoo, size_Amatrix, 6*NR_bus_count);
+				}
+			}
+			else if (powerflow_values->Y_Amatrix == NULL)
+			{
+				powerflow_values->Y_Amatrix = (SPARSE*) gl_malloc(sizeof(SPARSE));
+
+				//Make sure it worked
+				if (powerflow_values->Y_Amatrix == NULL)
+					GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-			//Check our frequency
-			if ((NRMatDumpMethod == MD_ALL) || ((NRMatDumpMethod != MD_ALL) && (Iteration == 0)))
+				//Initiliaze it
+				sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
+			}
+			else if (powerflow_values->NR_realloc_needed)	//If one of the above changed, we changed too
 			{
-				//Open the text file - append now
-				FPoutVal=fopen(MDFileName,"at");
+				//Destroy the old version
+				sparse_clear(powerflow_values->Y_Amatrix);
 
-				//See if we wanted references - Only do this once per call, regardless (keeps file size down)
-				if ((NRMatReferences == true) && (Iteration == 0))
-				{
-					//Print the index information
-					fprintf(FPoutVal,"Matrix Index information for this call - start,stop,name\n");
+				//Create a new 
+				sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
+			}
+			else
+			{
+				//Just clear it out
+				sparse_reset(powerflow_values->Y_Amatrix, 6*NR_bus_count);
+			}
 
-					for (indexer=0; indexer<bus_count; indexer++)
-					{
-						//Extract the start/stop indices
-						jindexer = 2*bus[indexer].Matrix_Loc;
-						kindexer = jindexer + 2*powerflow_values->BA_diag[indexer].size - 1;
+			//integrate off diagonal components
+			for (indexer=0; indexer<powerflow_values->size_offdiag_PQ*2; indexer++)
+			{
+				row = powerflow_values->Y_offdiag_PQ[indexer].row_ind;
+				col = powerflow_values->Y_offdiag_PQ[indexer].col_ind;
+				value = powerflow_values->Y_offdiag_PQ[indexer].Y_value;
 
-						//Print them out
-						fprintf(FPoutVal,"%d,%d,%s\n",jindexer,kindexer,bus[indexer].name);
-					}
+				if (NRMatAssemblyMethod == MA_SORTED)
+					sparse_coo_add(powerflow_values->Y_Acoo, row, col, value);
+				else
+					sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+			}
 
-					//Add in a blank line so it looks pretty
-					fprintf(FPoutVal,"\n");
-				}//End print the references
+			//Integrate fixed portions of diagonal components
+			for (indexer=powerflow_values->size_offdiag_PQ*2; indexer< (powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2); indexer++)
+			{
+				row = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].row_ind;
+				col = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].col_ind;
+				value = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].Y_value;
 
-				//Print the simulation time and iteration number
-				fprintf(FPoutVal,"Timestamp: %lld - Iteration %lld\n",gl_globalclock,Iteration);
+				if (NRMatAssemblyMethod == MA_SORTED)
+					sparse_coo_add(powerflow_values->Y_Acoo, row, col, value);
+				else
+					sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+			}
 
-				//Print size - for parsing ease
-				fprintf(FPoutVal,"Matrix Information - non-zero element count = %d\n",size_Amatrix);
-				
-				//Print the values - printed as "row index, column index, value"
-				//This particular output is after they have been column sorted for the algorithm
-				//Header
-				fprintf(FPoutVal,"Matrix Information - row, column, value\n");
+			//Integrate the variable portions of the diagonal components
+			for (indexer=powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2; indexer< size_Amatrix; indexer++)
+			{
+				row = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].row_ind;
+				col = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].col_ind;
+				value = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].Y_value;
+
+				if (NRMatAssemblyMethod == MA_SORTED)
+					sparse_coo_add(powerflow_values->Y_Acoo, row, col, value);
+				else
+					sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+			}
+
+			//Put the triplets in column order - duplicates are caught here
+			if (NRMatAssemblyMethod == MA_SORTED)
+				sparse_coo_sort(powerflow_values->Y_Acoo);
+
+			//Stop the assembly timer - the compressed column conversion is timed below
+			NR_matrix_assembly_time += (double)(clock() - assembly_start)/CLOCKS_PER_SEC;
 
-				//Null temp variable
-				temp_element = NULL;
+			//See if we want to dump out the matrix values
+			if (NRMatDumpMethod != MD_NONE)
+			{
+				//Code to export the sparse matrix values - useful for debugging issues
 
-				//Loop through the columns, extracting starting point each time
-				for (jindexer=0; jindexer<powerflow_values->Y_Amatrix->ncols; jindexer++)
+				//Check our frequency
+				if ((NRMatDumpMethod == MD_ALL) || ((NRMatDumpMethod != MD_ALL) && (Iteration == 0)))
 				{
-					//Extract the column starting point
-					temp_element = powerflow_values->Y_Amatrix->cols[jindexer];
+					//Open the text file - append now
+					FPoutVal=fopen(MDFileName,"at");
 
-					//Check for nulling
-					if (temp_element != NULL)
+					//See if we wanted references - Only do this once per call, regardless (keeps file size down)
+					if ((NRMatReferences == true) && (Iteration == 0))
 					{
-						//Print this value
-						fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
+						//Print the index information
+						fprintf(FPoutVal,"Matrix Index information for this call - start,stop,name\n");
 
-						//Loop
-						while (temp_element->next != NULL)
+						for (indexer=0; indexer<bus_count; indexer++)
 						{
-							//Get next element
-							temp_element = temp_element->next;
+							//Extract the start/stop indices
+							jindexer = 2*bus[indexer].Matrix_Loc;
+							kindexer = jindexer + 2*powerflow_values->BA_diag[indexer].size - 1;
+
+							//Print them out
+							fprintf(FPoutVal,"%d,%d,%s\n",jindexer,kindexer,bus[indexer].name);
+						}
+
+						//Add in a blank line so it looks pretty
+						fprintf(FPoutVal,"\n");
+					}//End print the references
+
+					//Print the simulation time and iteration number
+					fprintf(FPoutVal,"Timestamp: %lld - Iteration %lld\n",gl_globalclock,Iteration);
 
-							//Repeat the print
-							fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
+					//Print size - for parsing ease
+					fprintf(FPoutVal,"Matrix Information - non-zero element count = %d\n",size_Amatrix);
+				
+					//Print the values - printed as "row index, column index, value"
+					//This particular output is after they have been column sorted for the algorithm
+					//Header
+					fprintf(FPoutVal,"Matrix Information - row, column, value\n");
+
+					//Null temp variable
+					temp_element = NULL;
+
+					//Sorted triplets are already in column order - just print them in that order
+					if (NRMatAssemblyMethod == MA_SORTED)
+					{
+						for (jindexer=0; jindexer<powerflow_values->Y_Acoo->nels; jindexer++)
+						{
+							kindexer = powerflow_values->Y_Acoo->order[jindexer];
+							fprintf(FPoutVal,"%d,%d,%f\n",powerflow_values->Y_Acoo->row_ind[kindexer],powerflow_values->Y_Acoo->col_ind[kindexer],powerflow_values->Y_Acoo->value[kindexer]);
 						}
 					}
-					//If it is null, go next.  Implies we have an invalid matrix size, but that may be what we're looking for
-				}//End sparse matrix traversion for dump
+					else	//Linked list - loop through the columns, extracting starting point each time
+					{
+						for (jindexer=0; jindexer<powerflow_values->Y_Amatrix->ncols; jindexer++)
+						{
+							//Extract the column starting point
+							temp_element = powerflow_values->Y_Amatrix->cols[jindexer];
 
-				//Print an extra line, so it looks nice for ALL/PERCALL
-				fprintf(FPoutVal,"\n");
+							//Check for nulling
+							if (temp_element != NULL)
+							{
+								//Print this value
+								fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
 
-				//Close the file, we're done with it
-				fclose(FPoutVal);
+								//Loop
+								while (temp_element->next != NULL)
+								{
+									//Get next element
+									temp_element = temp_element->next;
 
-				//See if we were a "ONCE" - if so, deflag us
-				if (NRMatDumpMethod == MD_ONCE)
-				{
-					NRMatDumpMethod = MD_NONE;	//Flag to do no more
-				}
-			}//End Actual output
-		}//End matrix dump desired
+									//Repeat the print
+									fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
+								}
+							}
+							//If it is null, go next.  Implies we have an invalid matrix size, but that may be what we're looking for
+						}//End sparse matrix traversion for dump
+					}
+
+					//Print an extra line, so it looks nice for ALL/PERCALL
+					fprintf(FPoutVal,"\n");
+
+					//Close the file, we're done with it
+					fclose(FPoutVal);
+
+					//See if we were a "ONCE" - if so, deflag us
+					if (NRMatDumpMethod == MD_ONCE)
+					{
+						NRMatDumpMethod = MD_NONE;	//Flag to do no more
+					}
+				}//End Actual output
+			}//End matrix dump desired
+
+		}//End sparse matrix build
 
 		///* Initialize parameters. */
 		m = 2*powerflow_values->total_variables;
@@ -3200,6 +3800,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				if (perm_c == NULL)
 					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
+				powerflow_values->Y_pattern.perm_c_valid = false;
+
 				//Set up storage pointers - single element, but need to be malloced for some reason
 				A_LU.Store = (void *)gl_malloc(sizeof(NCformat));
 				if (A_LU.Store == NULL)
@@ -3250,6 +3852,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				//Free up superLU matrices
 				gl_free(perm_r);
 				gl_free(perm_c);
+
+				//The new perm_c holds no ordering yet
+				powerflow_values->Y_pattern.perm_c_valid = false;
 			}
 			//Default else - don't care - destructions are presumed to be handled inside external LU's alloc function
 
@@ -3344,8 +3949,43 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 		//Default else - not superLU
 #endif
 		
-		sparse_tonr(powerflow_values->Y_Amatrix, &matrices_LU);
-		matrices_LU.cols_LU[n] = nnz ;// number of non-zeros;
+		if (use_cached_pattern == false)
+		{
+			//Make sure the slot map is big enough
+			if (powerflow_values->Y_pattern.max_nnz < size_Amatrix)
+			{
+				if (powerflow_values->Y_pattern.slot != NULL)
+					gl_free(powerflow_values->Y_pattern.slot);
+
+				powerflow_values->Y_pattern.slot = (int *)gl_malloc(size_Amatrix*sizeof(int));
+
+				if (powerflow_values->Y_pattern.slot == NULL)
+					GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+
+				powerflow_values->Y_pattern.max_nnz = size_Amatrix;
+			}
+
+			assembly_start = clock();
+
+			if (NRMatAssemblyMethod == MA_SORTED)
+				sparse_coo_tonr(powerflow_values->Y_Acoo, &matrices_LU, powerflow_values->Y_pattern.slot);
+			else
+				sparse_tonr(powerflow_values->Y_Amatrix, &matrices_LU, powerflow_values->Y_pattern.slot);
+			matrices_LU.cols_LU[n] = nnz ;// number of non-zeros;
+
+			NR_matrix_assembly_time += (double)(clock() - assembly_start)/CLOCKS_PER_SEC;
+
+			//Pattern is now current - the column ordering needs to be redone though
+			powerflow_values->Y_pattern.nnz = size_Amatrix;
+			powerflow_values->Y_pattern.valid = true;
+			powerflow_values->Y_pattern.perm_c_valid = false;
+		}
+
+#ifndef MT
+		//Reuse the column ordering of an unchanged pattern - decided after the rebuild, which may have cleared it
+		if ((matrix_solver_method==MM_SUPERLU) && (powerflow_values->Y_pattern.perm_c_valid == true))
+			options.ColPerm = MY_PERMC;
+#endif
 
 		//Determine how to populate the rhs vector
 		if (mesh_imped_vals == NULL)	//Normal powerflow, copy in the values
@@ -3456,8 +4096,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 #ifdef MT
 					//superLU_MT commands
 
-					//Populate perm_c
-					get_perm_c(1, &A_LU, perm_c);
+					//Populate perm_c - only needed when the pattern changed
+					if (powerflow_values->Y_pattern.perm_c_valid == false)
+					{
+						get_perm_c(1, &A_LU, perm_c);
+						powerflow_values->Y_pattern.perm_c_valid = true;
+					}
 
 					//Solve the system 
 					pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
@@ -3473,6 +4117,7 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 
 					// solve the system
 					dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
+					powerflow_values->Y_pattern.perm_c_valid = true;
 
 					/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
 					//sequential superLU commands
@@ -3603,8 +4248,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 #ifdef MT
 				//superLU_MT commands
 
-				//Populate perm_c
-				get_perm_c(1, &A_LU, perm_c);
+				//Populate perm_c - only needed when the pattern changed
+				if (powerflow_values->Y_pattern.perm_c_valid == false)
+				{
+					get_perm_c(1, &A_LU, perm_c);
+					powerflow_values->Y_pattern.perm_c_valid = true;
+				}
 
 				//Solve the system
 				pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
@@ -3615,6 +4264,7 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 
 				// solve the system
 				dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
+				powerflow_values->Y_pattern.perm_c_valid = true;
 #endif
 
 				sol_LU = (double*) ((DNformat*) B_LU.Store)->nzval;
@@ -3646,6 +4296,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			}
 			//Default else -- not mesh fault mode, so go like normal
 
+			//Let the solver know if it can reuse its analysis of the pattern
+			matrices_LU.same_pattern = use_cached_pattern;
+
 			//Call the solver
 			info = ((int (*)(void *,NR_SOLVER_VARS *, unsigned int, unsigned int))(LUSolverFcns.ext_solve))(ext_solver_glob_vars,&matrices_LU,n,1);
 
@@ -3959,6 +4612,23 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 // For the second approach, calculate the elements of a,b,c,d in equations(14),(15),(16),(17).
 void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, bool jacobian_pass)
 {
+	NR_STAMP_DATA stamp_data_vals;
+
+	stamp_data_vals.bus = bus;
+	stamp_data_vals.powerflow_values = powerflow_values;
+	stamp_data_vals.jacobian_pass = jacobian_pass;
+
+	//Each bus only touches its own values, so ranges of buses can be done in parallel
+	nr_stamp_run(bus_count,NR_STAMP_MIN_BUSES,compute_load_values_range,&stamp_data_vals);
+}
+
+//Load calculations for buses start through stop-1
+static void compute_load_values_range(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status)
+{
+	BUSDATA *bus = ((NR_STAMP_DATA*)data)->bus;
+	NR_SOLVER_STRUCT *powerflow_values = ((NR_STAMP_DATA*)data)->powerflow_values;
+	NR_BUS_SOA *bus_soa = &powerflow_values->bus_soa;
+	bool jacobian_pass = ((NR_STAMP_DATA*)data)->jacobian_pass;
 	unsigned int indexer;
 	double adjust_nominal_voltage_val, adjust_nominal_voltaged_val;
 	double tempPbus, tempQbus;
@@ -3969,7 +4639,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 	char jindex, temp_index, temp_index_b;
 
 	//Loop through the buses
-	for (indexer=0; indexer<bus_count; indexer++)
+	for (indexer=start; indexer<stop; indexer++)
 	{
 		if ((bus[indexer].phases & 0x08) == 0x08)	//Delta connected node
 		{
@@ -3985,9 +4655,9 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
 
 				//Compute delta voltages
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+				voltageDel[0] = bus_soa->V[3*indexer+0] - bus_soa->V[3*indexer+1];
+				voltageDel[1] = bus_soa->V[3*indexer+1] - bus_soa->V[3*indexer+2];
+				voltageDel[2] = bus_soa->V[3*indexer+2] - bus_soa->V[3*indexer+0];
 
 				//Get magnitudes of all
 				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
@@ -4039,15 +4709,15 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 					adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
 
 					//Get magnitudes of all
-					adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-					adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-					adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+					adjust_temp_voltage_mag[3] = bus_soa->V[3*indexer+0].Mag();
+					adjust_temp_voltage_mag[4] = bus_soa->V[3*indexer+1].Mag();
+					adjust_temp_voltage_mag[5] = bus_soa->V[3*indexer+2].Mag();
 
 					//Start adjustments - A
 					if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
 					{
 						//calculate new value
-						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
+						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus_soa->V[3*indexer+0] * adjust_nominal_voltage_val));
 					}
 					else
 					{
@@ -4058,7 +4728,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 					if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
 					{
 						//calculate new value
-						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
+						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus_soa->V[3*indexer+1] * adjust_nominal_voltage_val));
 					}
 					else
 					{
@@ -4069,7 +4739,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 					if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
 					{
 						//calculate new value
-						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
+						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus_soa->V[3*indexer+2] * adjust_nominal_voltage_val));
 					}
 					else
 					{
@@ -4110,7 +4780,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
 			{
 				//Voltage calculations
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+				voltageDel[0] = bus_soa->V[3*indexer+0] - bus_soa->V[3*indexer+1];
 
 				//Power - convert to a current (uses less iterations this way)
 				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S[0]/voltageDel[0]);
@@ -4128,7 +4798,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
 			{
 				//Voltage calculations
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+				voltageDel[1] = bus_soa->V[3*indexer+1] - bus_soa->V[3*indexer+2];
 
 				//Power - convert to a current (uses less iterations this way)
 				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S[1]/voltageDel[1]);
@@ -4146,7 +4816,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
 			{
 				//Voltage calculations
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+				voltageDel[2] = bus_soa->V[3*indexer+2] - bus_soa->V[3*indexer+0];
 
 				//Power - convert to a current (uses less iterations this way)
 				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S[2]/voltageDel[2]);
@@ -4171,10 +4841,10 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
 				{
 					//Power values
-					undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus[indexer].V[0]);
+					undeltacurr[0] += (bus_soa->V[3*indexer+0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus_soa->V[3*indexer+0]);
 
 					//Shunt values
-					undeltacurr[0] += bus[indexer].extra_var[3]*bus[indexer].V[0];
+					undeltacurr[0] += bus[indexer].extra_var[3]*bus_soa->V[3*indexer+0];
 
 					//Current values
 					undeltacurr[0] += adjusted_constant_current[3];
@@ -4194,10 +4864,10 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
 				{
 					//Power values
-					undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus[indexer].V[1]);
+					undeltacurr[1] += (bus_soa->V[3*indexer+1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus_soa->V[3*indexer+1]);
 
 					//Shunt values
-					undeltacurr[1] += bus[indexer].extra_var[4]*bus[indexer].V[1];
+					undeltacurr[1] += bus[indexer].extra_var[4]*bus_soa->V[3*indexer+1];
 
 					//Current values
 					undeltacurr[1] += adjusted_constant_current[4];
@@ -4217,10 +4887,10 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].phases & 0x10) == 0x10)		//We do, so they must be Wye-connected
 				{
 					//Power values
-					undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus[indexer].V[2]);
+					undeltacurr[2] += (bus_soa->V[3*indexer+2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus_soa->V[3*indexer+2]);
 
 					//Shunt values
-					undeltacurr[2] += bus[indexer].extra_var[5]*bus[indexer].V[2];
+					undeltacurr[2] += bus[indexer].extra_var[5]*bus_soa->V[3*indexer+2];
 
 					//Current values
 					undeltacurr[2] += adjusted_constant_current[5];
@@ -4301,39 +4971,41 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				{
 					if ((temp_index==-1) || (temp_index_b==-1))
 					{
-						GL_THROW("NR: A scheduled power update element failed.");
+						nr_stamp_fail(status,"NR: A scheduled power update element failed.");
 						//Defined below
+						return;
 					}
 
 					//Real power calculations
-					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].PL[temp_index] = tempPbus;	//Real power portion - all is current based
+					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+					bus_soa->PL[3*indexer+temp_index] = tempPbus;	//Real power portion - all is current based
 
 					//Reactive load calculations
-					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion - all is current based
+					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+					bus_soa->QL[3*indexer+temp_index] = tempQbus;	//Reactive power portion - all is current based
 				}
 				else	//Jacobian-type update
 				{
 					if ((temp_index==-1) || (temp_index_b==-1))
 					{
-						GL_THROW("NR: A Jacobian update element failed.");
+						nr_stamp_fail(status,"NR: A Jacobian update element failed.");
 						//Defined below
+						return;
 					}
 
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
+					if ((bus_soa->V[3*indexer+temp_index_b]).Mag()!=0)
 					{
-						bus[indexer].Jacob_A[temp_index] = ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(37) - no power term needed
-						bus[indexer].Jacob_B[temp_index] = -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(38) - no power term needed
-						bus[indexer].Jacob_C[temp_index] =((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(39) - no power term needed
-						bus[indexer].Jacob_D[temp_index] = ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(40) - no power term needed
+						bus_soa->Jacob_A[3*indexer+temp_index] = ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// second part of equation(37) - no power term needed
+						bus_soa->Jacob_B[3*indexer+temp_index] = -((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// second part of equation(38) - no power term needed
+						bus_soa->Jacob_C[3*indexer+temp_index] =((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// second part of equation(39) - no power term needed
+						bus_soa->Jacob_D[3*indexer+temp_index] = ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// second part of equation(40) - no power term needed
 					}
 					else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
 					{
-						bus[indexer].Jacob_A[temp_index] = -1e-4;	//Small offset to avoid singularities (if impedance is zero too)
-						bus[indexer].Jacob_B[temp_index] = -1e-4;
-						bus[indexer].Jacob_C[temp_index] = -1e-4;
-						bus[indexer].Jacob_D[temp_index] = -1e-4;
+						bus_soa->Jacob_A[3*indexer+temp_index] = -1e-4;	//Small offset to avoid singularities (if impedance is zero too)
+						bus_soa->Jacob_B[3*indexer+temp_index] = -1e-4;
+						bus_soa->Jacob_C[3*indexer+temp_index] = -1e-4;
+						bus_soa->Jacob_D[3*indexer+temp_index] = -1e-4;
 					}
 				}//End specific bus update method
 			}//End phase traversion
@@ -4342,7 +5014,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 		{
 			//Convert it all back to current (easiest to handle)
 			//Get V12 first
-			voltageDel[0] = bus[indexer].V[0] + bus[indexer].V[1];
+			voltageDel[0] = bus_soa->V[3*indexer+0] + bus_soa->V[3*indexer+1];
 
 			//Start with the currents (just put them in)
 			temp_current[0] = bus[indexer].I[0];
@@ -4355,21 +5027,21 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				temp_current[2] += bus[indexer].prerot_I[2];
 
 			//Now add in power contributions
-			temp_current[0] += bus[indexer].V[0] == 0.0 ? 0.0 : ~(bus[indexer].S[0]/bus[indexer].V[0]);
-			temp_current[1] += bus[indexer].V[1] == 0.0 ? 0.0 : ~(bus[indexer].S[1]/bus[indexer].V[1]);
+			temp_current[0] += bus_soa->V[3*indexer+0] == 0.0 ? 0.0 : ~(bus[indexer].S[0]/bus_soa->V[3*indexer+0]);
+			temp_current[1] += bus_soa->V[3*indexer+1] == 0.0 ? 0.0 : ~(bus[indexer].S[1]/bus_soa->V[3*indexer+1]);
 			temp_current[2] += voltageDel[0] == 0.0 ? 0.0 : ~(bus[indexer].S[2]/voltageDel[0]);
 
 			//Last, but not least, admittance/impedance contributions
-			temp_current[0] += bus[indexer].Y[0]*bus[indexer].V[0];
-			temp_current[1] += bus[indexer].Y[1]*bus[indexer].V[1];
+			temp_current[0] += bus[indexer].Y[0]*bus_soa->V[3*indexer+0];
+			temp_current[1] += bus[indexer].Y[1]*bus_soa->V[3*indexer+1];
 			temp_current[2] += bus[indexer].Y[2]*voltageDel[0];
 
 			//See if we are a house-connected node, if so, adjust and add in those values as well
 			if ((bus[indexer].phases & 0x40) == 0x40)
 			{
 				//Update phase adjustments
-				temp_store[0].SetPolar(1.0,bus[indexer].V[0].Arg());	//Pull phase of V1
-				temp_store[1].SetPolar(1.0,bus[indexer].V[1].Arg());	//Pull phase of V2
+				temp_store[0].SetPolar(1.0,bus_soa->V[3*indexer+0].Arg());	//Pull phase of V1
+				temp_store[1].SetPolar(1.0,bus_soa->V[3*indexer+1].Arg());	//Pull phase of V2
 				temp_store[2].SetPolar(1.0,voltageDel[0].Arg());		//Pull phase of V12
 
 				//Update these current contributions (use delta current variable, it isn't used in here anyways)
@@ -4390,11 +5062,11 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				temp_store[1] = -temp_current[1] - temp_current[2];
 
 				//Update the stored values
-				bus[indexer].PL[0] = temp_store[0].Re();
-				bus[indexer].QL[0] = temp_store[0].Im();
+				bus_soa->PL[3*indexer+0] = temp_store[0].Re();
+				bus_soa->QL[3*indexer+0] = temp_store[0].Im();
 
-				bus[indexer].PL[1] = temp_store[1].Re();
-				bus[indexer].QL[1] = temp_store[1].Im();
+				bus_soa->PL[3*indexer+1] = temp_store[1].Re();
+				bus_soa->QL[3*indexer+1] = temp_store[1].Im();
 			}
 			else	//Jacobian update
 			{
@@ -4404,27 +5076,27 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 
 				for (jindex=0; jindex<2; jindex++)
 				{
-					if ((bus[indexer].V[jindex]).Mag()!=0)	//Only current
+					if ((bus_soa->V[3*indexer+jindex]).Mag()!=0)	//Only current
 					{
-						bus[indexer].Jacob_A[jindex] = ((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Re() + (temp_store[jindex]).Im() *pow((bus[indexer].V[jindex]).Im(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(37)
-						bus[indexer].Jacob_B[jindex] = -((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Im() + (temp_store[jindex]).Re() *pow((bus[indexer].V[jindex]).Re(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(38)
-						bus[indexer].Jacob_C[jindex] =((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Im() - (temp_store[jindex]).Re() *pow((bus[indexer].V[jindex]).Im(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(39)
-						bus[indexer].Jacob_D[jindex] = ((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Re() - (temp_store[jindex]).Im() *pow((bus[indexer].V[jindex]).Re(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(40)
+						bus_soa->Jacob_A[3*indexer+jindex] = ((bus_soa->V[3*indexer+jindex]).Re()*(bus_soa->V[3*indexer+jindex]).Im()*(temp_store[jindex]).Re() + (temp_store[jindex]).Im() *pow((bus_soa->V[3*indexer+jindex]).Im(),2))/pow((bus_soa->V[3*indexer+jindex]).Mag(),3);// second part of equation(37)
+						bus_soa->Jacob_B[3*indexer+jindex] = -((bus_soa->V[3*indexer+jindex]).Re()*(bus_soa->V[3*indexer+jindex]).Im()*(temp_store[jindex]).Im() + (temp_store[jindex]).Re() *pow((bus_soa->V[3*indexer+jindex]).Re(),2))/pow((bus_soa->V[3*indexer+jindex]).Mag(),3);// second part of equation(38)
+						bus_soa->Jacob_C[3*indexer+jindex] =((bus_soa->V[3*indexer+jindex]).Re()*(bus_soa->V[3*indexer+jindex]).Im()*(temp_store[jindex]).Im() - (temp_store[jindex]).Re() *pow((bus_soa->V[3*indexer+jindex]).Im(),2))/pow((bus_soa->V[3*indexer+jindex]).Mag(),3);// second part of equation(39)
+						bus_soa->Jacob_D[3*indexer+jindex] = ((bus_soa->V[3*indexer+jindex]).Re()*(bus_soa->V[3*indexer+jindex]).Im()*(temp_store[jindex]).Re() - (temp_store[jindex]).Im() *pow((bus_soa->V[3*indexer+jindex]).Re(),2))/pow((bus_soa->V[3*indexer+jindex]).Mag(),3);// second part of equation(40)
 					}
 					else
 					{
-						bus[indexer].Jacob_A[jindex]=  -1e-4;	//Put very small to avoid singularity issues
-						bus[indexer].Jacob_B[jindex]=  -1e-4;
-						bus[indexer].Jacob_C[jindex]=  -1e-4;
-						bus[indexer].Jacob_D[jindex]=  -1e-4;
+						bus_soa->Jacob_A[3*indexer+jindex]=  -1e-4;	//Put very small to avoid singularity issues
+						bus_soa->Jacob_B[3*indexer+jindex]=  -1e-4;
+						bus_soa->Jacob_C[3*indexer+jindex]=  -1e-4;
+						bus_soa->Jacob_D[3*indexer+jindex]=  -1e-4;
 					}
 				}
 
 				//Zero the last elements, just to be safe (shouldn't be an issue, but who knows)
-				bus[indexer].Jacob_A[2] = 0.0;
-				bus[indexer].Jacob_B[2] = 0.0;
-				bus[indexer].Jacob_C[2] = 0.0;
-				bus[indexer].Jacob_D[2] = 0.0;
+				bus_soa->Jacob_A[3*indexer+2] = 0.0;
+				bus_soa->Jacob_B[3*indexer+2] = 0.0;
+				bus_soa->Jacob_C[3*indexer+2] = 0.0;
+				bus_soa->Jacob_D[3*indexer+2] = 0.0;
 			}//End specific update type
 		}//end split-phase connected
 		else	//Wye-connected system/load
@@ -4441,15 +5113,15 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
 
 				//Get magnitudes of all
-				adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-				adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-				adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+				adjust_temp_voltage_mag[3] = bus_soa->V[3*indexer+0].Mag();
+				adjust_temp_voltage_mag[4] = bus_soa->V[3*indexer+1].Mag();
+				adjust_temp_voltage_mag[5] = bus_soa->V[3*indexer+2].Mag();
 
 				//Start adjustments - A
 				if ((bus[indexer].I[0] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
+					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[3] / (bus_soa->V[3*indexer+0] * adjust_nominal_voltage_val));
 				}
 				else
 				{
@@ -4460,7 +5132,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].I[1] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
+					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[4] / (bus_soa->V[3*indexer+1] * adjust_nominal_voltage_val));
 				}
 				else
 				{
@@ -4471,7 +5143,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].I[2] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
+					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[5] / (bus_soa->V[3*indexer+2] * adjust_nominal_voltage_val));
 				}
 				else
 				{
@@ -4499,9 +5171,9 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
 
 					//Compute delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+					voltageDel[0] = bus_soa->V[3*indexer+0] - bus_soa->V[3*indexer+1];
+					voltageDel[1] = bus_soa->V[3*indexer+1] - bus_soa->V[3*indexer+2];
+					voltageDel[2] = bus_soa->V[3*indexer+2] - bus_soa->V[3*indexer+0];
 
 					//Get magnitudes of all
 					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
@@ -4581,7 +5253,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].phases & 0x06) == 0x06)	//Has A-B
 				{
 					//Delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+					voltageDel[0] = bus_soa->V[3*indexer+0] - bus_soa->V[3*indexer+1];
 
 					//Power - put into a current value (iterates less this way)
 					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/voltageDel[0]);
@@ -4600,7 +5272,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].phases & 0x03) == 0x03)	//Has B-C
 				{
 					//Delta voltages
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+					voltageDel[1] = bus_soa->V[3*indexer+1] - bus_soa->V[3*indexer+2];
 
 					//Power - put into a current value (iterates less this way)
 					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/voltageDel[1]);
@@ -4619,7 +5291,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].phases & 0x05) == 0x05)	//Has C-A
 				{
 					//Delta voltages
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+					voltageDel[2] = bus_soa->V[3*indexer+2] - bus_soa->V[3*indexer+0];
 
 					//Power - put into a current value (iterates less this way)
 					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/voltageDel[2]);
@@ -4708,65 +5380,67 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				{
 					if ((temp_index==-1) || (temp_index_b==-1))
 					{
-						GL_THROW("NR: A scheduled power update element failed.");
+						nr_stamp_fail(status,"NR: A scheduled power update element failed.");
 						/*  TROUBLESHOOT
 						While attempting to calculate the scheduled portions of the
 						attached loads, an update failed to process correctly.
 						Submit you code and a bug report using the trac website.
 						*/
+						return;
 					}
 
 					//Perform the power calculation
 					tempPbus = (bus[indexer].S[temp_index_b]).Re();									// Real power portion of constant power portion
-					tempPbus += (adjusted_constant_current[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					tempPbus += (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current from "different" children
-					tempPbus += (bus[indexer].Y[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (bus[indexer].Y[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant impedance component multiply the square of the magnitude of bus voltage
-					bus[indexer].PL[temp_index] = tempPbus;	//Real power portion
+					tempPbus += (adjusted_constant_current[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+					tempPbus += (undeltacurr[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Im();	// Real power portion of Constant current from "different" children
+					tempPbus += (bus[indexer].Y[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Re() + (bus[indexer].Y[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Im();	// Real power portion of Constant impedance component multiply the square of the magnitude of bus voltage
+					bus_soa->PL[3*indexer+temp_index] = tempPbus;	//Real power portion
 
 
 					tempQbus = (bus[indexer].S[temp_index_b]).Im();									// Reactive power portion of constant power portion
-					tempQbus += (adjusted_constant_current[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					tempQbus += (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current from "different" children
-					tempQbus += -(bus[indexer].Y[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im() - (bus[indexer].Y[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant impedance component multiply the square of the magnitude of bus voltage
-					bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion
+					tempQbus += (adjusted_constant_current[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+					tempQbus += (undeltacurr[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Re();	// Reactive power portion of Constant current from "different" children
+					tempQbus += -(bus[indexer].Y[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Im() - (bus[indexer].Y[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Re();	// Reactive power portion of Constant impedance component multiply the square of the magnitude of bus voltage
+					bus_soa->QL[3*indexer+temp_index] = tempQbus;	//Reactive power portion
 				}
 				else	//Jacobian update pass
 				{
 					if ((temp_index==-1) || (temp_index_b==-1))
 					{
-						GL_THROW("NR: A Jacobian update element failed.");
+						nr_stamp_fail(status,"NR: A Jacobian update element failed.");
 						/*  TROUBLESHOOT
 						While attempting to calculate the "dynamic" portions of the
 						Jacobian matrix that encompass attached loads, an update failed to process correctly.
 						Submit you code and a bug report using the trac website.
 						*/
+						return;
 					}
 
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
+					if ((bus_soa->V[3*indexer+temp_index_b]).Mag()!=0)
 					{
-						bus[indexer].Jacob_A[temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(37)
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) + (bus[indexer].Y[temp_index_b]).Im();// second part of equation(37)
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// current part of equation (37) - Handles "different" children
+						bus_soa->Jacob_A[3*indexer+temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2) - pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2)) - 2*(bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),4);// first part of equation(37)
+						bus_soa->Jacob_A[3*indexer+temp_index] += ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3) + (bus[indexer].Y[temp_index_b]).Im();// second part of equation(37)
+						bus_soa->Jacob_A[3*indexer+temp_index] += ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// current part of equation (37) - Handles "different" children
 
-						bus[indexer].Jacob_B[temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) + 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(38)
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() + (adjusted_constant_current[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(38)
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// current part of equation(38) - Handles "different" children
+						bus_soa->Jacob_B[3*indexer+temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2) - pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2)) + 2*(bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),4);// first part of equation(38)
+						bus_soa->Jacob_B[3*indexer+temp_index] += -((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() + (adjusted_constant_current[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(38)
+						bus_soa->Jacob_B[3*indexer+temp_index] += -((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// current part of equation(38) - Handles "different" children
 
-						bus[indexer].Jacob_C[temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus[indexer].V[temp_index_b]).Im(),2) - pow((bus[indexer].V[temp_index_b]).Re(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(39)
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(39)
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// Current part of equation(39) - Handles "different" children
+						bus_soa->Jacob_C[3*indexer+temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2) - pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2)) - 2*(bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),4);// first part of equation(39)
+						bus_soa->Jacob_C[3*indexer+temp_index] +=((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(39)
+						bus_soa->Jacob_C[3*indexer+temp_index] +=((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// Current part of equation(39) - Handles "different" children
 
-						bus[indexer].Jacob_D[temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(40)
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() - (adjusted_constant_current[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Im();// second part of equation(40)
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// Current part of equation(40) - Handles "different" children
+						bus_soa->Jacob_D[3*indexer+temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2) - pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2)) - 2*(bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),4);// first part of equation(40)
+						bus_soa->Jacob_D[3*indexer+temp_index] += ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() - (adjusted_constant_current[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Im();// second part of equation(40)
+						bus_soa->Jacob_D[3*indexer+temp_index] += ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3);// Current part of equation(40) - Handles "different" children
 
 					}
 					else
 					{
-						bus[indexer].Jacob_A[temp_index]= (bus[indexer].Y[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularity issues
-						bus[indexer].Jacob_B[temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_C[temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_D[temp_index]= -(bus[indexer].Y[temp_index_b]).Im() - 1e-4;
+						bus_soa->Jacob_A[3*indexer+temp_index]= (bus[indexer].Y[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularity issues
+						bus_soa->Jacob_B[3*indexer+temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
+						bus_soa->Jacob_C[3*indexer+temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
+						bus_soa->Jacob_D[3*indexer+temp_index]= -(bus[indexer].Y[temp_index_b]).Im() - 1e-4;
 					}
 				}//End of pass-specific bus updates
 			}//End phase traversion - Wye
@@ -4779,7 +5453,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
 			{
 				//Voltage calculations
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+				voltageDel[0] = bus_soa->V[3*indexer+0] - bus_soa->V[3*indexer+1];
 
 				//Power - convert to a current (uses less iterations this way)
 				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S_dy[0]/voltageDel[0]);
@@ -4798,7 +5472,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
 			{
 				//Voltage calculations
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+				voltageDel[1] = bus_soa->V[3*indexer+1] - bus_soa->V[3*indexer+2];
 
 				//Power - convert to a current (uses less iterations this way)
 				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S_dy[1]/voltageDel[1]);
@@ -4817,7 +5491,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
 			{
 				//Voltage calculations
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+				voltageDel[2] = bus_soa->V[3*indexer+2] - bus_soa->V[3*indexer+0];
 
 				//Power - convert to a current (uses less iterations this way)
 				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S_dy[2]/voltageDel[2]);
@@ -4849,23 +5523,23 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				adjust_temp_nominal_voltage[5].SetPolar(adjust_nominal_voltage_val,2.0*PI/3.0);
 
 				//Compute delta voltages
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+				voltageDel[0] = bus_soa->V[3*indexer+0] - bus_soa->V[3*indexer+1];
+				voltageDel[1] = bus_soa->V[3*indexer+1] - bus_soa->V[3*indexer+2];
+				voltageDel[2] = bus_soa->V[3*indexer+2] - bus_soa->V[3*indexer+0];
 
 				//Get magnitudes of all
 				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
 				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
 				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
-				adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-				adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-				adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+				adjust_temp_voltage_mag[3] = bus_soa->V[3*indexer+0].Mag();
+				adjust_temp_voltage_mag[4] = bus_soa->V[3*indexer+1].Mag();
+				adjust_temp_voltage_mag[5] = bus_soa->V[3*indexer+2].Mag();
 
 				//Start adjustments - A
 				if ((bus[indexer].I_dy[3] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I_dy[3] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
+					adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I_dy[3] * adjust_temp_voltage_mag[3] / (bus_soa->V[3*indexer+0] * adjust_nominal_voltage_val));
 				}
 				else
 				{
@@ -4876,7 +5550,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].I_dy[4] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I_dy[4] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
+					adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I_dy[4] * adjust_temp_voltage_mag[4] / (bus_soa->V[3*indexer+1] * adjust_nominal_voltage_val));
 				}
 				else
 				{
@@ -4887,7 +5561,7 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				if ((bus[indexer].I_dy[5] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I_dy[5] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
+					adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I_dy[5] * adjust_temp_voltage_mag[5] / (bus_soa->V[3*indexer+2] * adjust_nominal_voltage_val));
 				}
 				else
 				{
@@ -4948,10 +5622,10 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				//Apply explicit wye-connected loads
 
 				//Power values
-				undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].S_dy[3]/bus[indexer].V[0]);
+				undeltacurr[0] += (bus_soa->V[3*indexer+0] == 0) ? 0 : ~(bus[indexer].S_dy[3]/bus_soa->V[3*indexer+0]);
 
 				//Shunt values
-				undeltacurr[0] += bus[indexer].Y_dy[3]*bus[indexer].V[0];
+				undeltacurr[0] += bus[indexer].Y_dy[3]*bus_soa->V[3*indexer+0];
 
 				//Current values
 				undeltacurr[0] += adjusted_constant_current[3];
@@ -4969,10 +5643,10 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				//Apply explicit wye-connected loads
 
 				//Power values
-				undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].S_dy[4]/bus[indexer].V[1]);
+				undeltacurr[1] += (bus_soa->V[3*indexer+1] == 0) ? 0 : ~(bus[indexer].S_dy[4]/bus_soa->V[3*indexer+1]);
 
 				//Shunt values
-				undeltacurr[1] += bus[indexer].Y_dy[4]*bus[indexer].V[1];
+				undeltacurr[1] += bus[indexer].Y_dy[4]*bus_soa->V[3*indexer+1];
 
 				//Current values
 				undeltacurr[1] += adjusted_constant_current[4];
@@ -4990,10 +5664,10 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				//Apply explicit wye-connected loads
 
 				//Power values
-				undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].S_dy[5]/bus[indexer].V[2]);
+				undeltacurr[2] += (bus_soa->V[3*indexer+2] == 0) ? 0 : ~(bus[indexer].S_dy[5]/bus_soa->V[3*indexer+2]);
 
 				//Shunt values
-				undeltacurr[2] += bus[indexer].Y_dy[5]*bus[indexer].V[2];
+				undeltacurr[2] += bus[indexer].Y_dy[5]*bus_soa->V[3*indexer+2];
 
 				//Current values
 				undeltacurr[2] += adjusted_constant_current[5];
@@ -5073,40 +5747,42 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 				{
 					if ((temp_index==-1) || (temp_index_b==-1))
 					{
-						GL_THROW("NR: A scheduled power update element failed.");
+						nr_stamp_fail(status,"NR: A scheduled power update element failed.");
 						//Defined below
+						return;
 					}
 
 					//Real power calculations
-					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].PL[temp_index] += tempPbus;	//Real power portion - all is current based -- accumulate in case mixed and matched with old above
+					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+					bus_soa->PL[3*indexer+temp_index] += tempPbus;	//Real power portion - all is current based -- accumulate in case mixed and matched with old above
 
 					//Reactive load calculations
-					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].QL[temp_index] += tempQbus;	//Reactive power portion - all is current based -- accumulate in case mixed and matched with old above
+					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus_soa->V[3*indexer+temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_soa->V[3*indexer+temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+					bus_soa->QL[3*indexer+temp_index] += tempQbus;	//Reactive power portion - all is current based -- accumulate in case mixed and matched with old above
 				}
 				else	//Jacobian update
 				{
 					if ((temp_index==-1) || (temp_index_b==-1))
 					{
-						GL_THROW("NR: A Jacobian update element failed.");
+						nr_stamp_fail(status,"NR: A Jacobian update element failed.");
 						//Defined below
+						return;
 					}
 
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
+					if ((bus_soa->V[3*indexer+temp_index_b]).Mag()!=0)
 					{
 						//Apply as an accumulation, in case any "normal" connections are present too
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // + (undeltaimped[temp_index_b]).Im();// second part of equation(37) - no power term needed
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(38) - no power term needed
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(39) - no power term needed
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Im();// second part of equation(40) - no power term needed
+						bus_soa->Jacob_A[3*indexer+temp_index] += ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3); // + (undeltaimped[temp_index_b]).Im();// second part of equation(37) - no power term needed
+						bus_soa->Jacob_B[3*indexer+temp_index] += -((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(38) - no power term needed
+						bus_soa->Jacob_C[3*indexer+temp_index] +=((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_soa->V[3*indexer+temp_index_b]).Im(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(39) - no power term needed
+						bus_soa->Jacob_D[3*indexer+temp_index] += ((bus_soa->V[3*indexer+temp_index_b]).Re()*(bus_soa->V[3*indexer+temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_soa->V[3*indexer+temp_index_b]).Re(),2))/pow((bus_soa->V[3*indexer+temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Im();// second part of equation(40) - no power term needed
 					}
 					else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
 					{
-						bus[indexer].Jacob_A[temp_index] += -1e-4; //(undeltaimped[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularities (if impedance is zero too)
-						bus[indexer].Jacob_B[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_C[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_D[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Im() - 1e-4;
+						bus_soa->Jacob_A[3*indexer+temp_index] += -1e-4; //(undeltaimped[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularities (if impedance is zero too)
+						bus_soa->Jacob_B[3*indexer+temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
+						bus_soa->Jacob_C[3*indexer+temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
+						bus_soa->Jacob_D[3*indexer+temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Im() - 1e-4;
 					}
 				}//End pass differentiation
 			}//End phase traversion
@@ -5185,15 +5861,16 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 
 					if ((temp_index==-1) || (temp_index_b==-1))
 					{
-						GL_THROW("NR: A Jacobian update element failed.");
+						nr_stamp_fail(status,"NR: A Jacobian update element failed.");
 						//Defined below
+						return;
 					}
 
 					//Accumulate the values
-					bus[indexer].Jacob_A[temp_index] += bus[indexer].full_Y_load[temp_index_b].Im();
-					bus[indexer].Jacob_B[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
-					bus[indexer].Jacob_C[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
-					bus[indexer].Jacob_D[temp_index] -= bus[indexer].full_Y_load[temp_index_b].Im();
+					bus_soa->Jacob_A[3*indexer+temp_index] += bus[indexer].full_Y_load[temp_index_b].Im();
+					bus_soa->Jacob_B[3*indexer+temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
+					bus_soa->Jacob_C[3*indexer+temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
+					bus_soa->Jacob_D[3*indexer+temp_index] -= bus[indexer].full_Y_load[temp_index_b].Im();
 				}//End phase traversion
 			}//End deltamode-enabled in-rush loads updates
 		}//End Jacobian pass for deltamode loads
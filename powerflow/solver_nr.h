@@ -28,8 +28,6 @@ typedef struct  {
 	complex *house_var;		///< Extra variable - used mainly for nominal house current 
 	int *Link_Table;		///< table of links that connect to us (for population purposes)
 	unsigned int Link_Table_Size;	///< Number of entries in the link table (number of links connected to us)
-	double PL[3];			///< real power component of total bus load
-	double QL[3];			///< reactive power component of total bus load
 	bool *dynamics_enabled;	///< Flag indicating this particular node has a dynamics contribution function
 	bool swing_functions_enabled;	///< Flag indicating if this particular node is a swing node, and if so, if it is behaving "all swingy"
 	complex *PGenTotal;		///< Total output of any generation at this node - lumped for now for dynamics
@@ -38,10 +36,6 @@ typedef struct  {
 	complex *BusSatTerm;	///< Saturation term pointer for in-rush-based transformer calculations - separate for ease
 	double volt_base;		///< voltage basis
     double mva_base;		/// MVA basis
-	double Jacob_A[3];		// Element a in equation (37), which is used to update the Jacobian matrix at each iteration
-	double Jacob_B[3];		// Element b in equation (38), which is used to update the Jacobian matrix at each iteration
-	double Jacob_C[3];		// Element c in equation (39), which is used to update the Jacobian matrix at each iteration
-	double Jacob_D[3];		// Element d in equation (40), which is used to update the Jacobian matrix at each iteration
 	unsigned int Matrix_Loc;// Starting index of this object's place in all matrices/equations
 	double max_volt_error;	///< Maximum voltage error specified for that node
 	char *name;				///< original name
@@ -83,6 +77,8 @@ typedef struct {
 	int	col_ind;  ///< column location of the element in n*n bus admittance matrix in NR solver
     complex Y[3][3]; ///< complex value of elements in bus admittance matrix in NR solver
 	char size;		///< size of the admittance diagonal - assumed square, useful for smaller size
+	unsigned int fixed_loc;		///< index of this bus's first element in Y_diag_fixed
+	unsigned int update_loc;	///< index of this bus's first element in Y_diag_update
 } Bus_admit;
 
 typedef struct {
@@ -90,6 +86,7 @@ typedef struct {
 	double *rhs_LU;
 	int *cols_LU;
 	int *rows_LU;
+	bool same_pattern;	///< rows_LU and cols_LU are unchanged from the previous solve - only the values of a_LU changed
 } NR_SOLVER_VARS;
 
 typedef enum {
@@ -113,6 +110,40 @@ typedef struct {
 	unsigned int ncols;
 } SPARSE;
 
+// Sparse matrix - flat coordinate (triplet) list, ordered by column and row with two counting-sort passes
+typedef struct {
+	int *row_ind;			///< row location of each element, in assembly order
+	int *col_ind;			///< column location of each element, in assembly order
+	double *value;			///< value of each element, in assembly order
+	unsigned int *order;	///< element indices ordered by column, then row
+	unsigned int *work;		///< scratch ordering for the row pass of the sort
+	unsigned int *count;	///< bucket offsets for the sort passes (ncols+1 entries)
+	unsigned int nels;		///< number of elements added
+	unsigned int max_nels;	///< number of elements allocated
+	unsigned int ncols;		///< number of columns (and rows) of the matrix
+} SPARSE_COO;
+
+// Cached sparsity pattern of the A matrix - reused while the admittance topology is unchanged
+typedef struct {
+	int *slot;							///< location in a_LU of each assembled element (off-diagonal, fixed diagonal, then updated diagonal)
+	unsigned int nnz;					///< number of non-zero elements in the cached pattern
+	unsigned int max_nnz;				///< allocated size of slot
+	bool valid;							///< flag indicating cols_LU, rows_LU and slot describe the current matrix
+	bool perm_c_valid;					///< flag indicating perm_c holds the column ordering of the cached pattern
+} NR_SPARSE_CACHE;
+
+// Per-phase bus values the NR iteration works on, stored contiguously (3 entries per bus, element 3*bus+phase)
+typedef struct {
+	complex *V;			///< bus voltages - copied from the node objects at the start of each iteration
+	double *PL;			///< real power component of total bus load
+	double *QL;			///< reactive power component of total bus load
+	double *Jacob_A;	///< Element a in equation (37), which is used to update the Jacobian matrix at each iteration
+	double *Jacob_B;	///< Element b in equation (38), which is used to update the Jacobian matrix at each iteration
+	double *Jacob_C;	///< Element c in equation (39), which is used to update the Jacobian matrix at each iteration
+	double *Jacob_D;	///< Element d in equation (40), which is used to update the Jacobian matrix at each iteration
+	unsigned int max_buses;	///< number of buses allocated
+} NR_BUS_SOA;
+
 typedef struct {
 	double *deltaI_NR;					/// Storage array for current injection
 	unsigned int size_offdiag_PQ;		/// Number of fixed off-diagonal matrix elements
@@ -129,6 +160,9 @@ typedef struct {
 	Y_NR *Y_diag_fixed;					///Y_diag_fixed store the row,column and value of fixed diagonal elements of 6n*6n Y_NR matrix. No PV bus is included.
 	Y_NR *Y_diag_update;				///Y_diag_update store the row,column and value of updated diagonal elements of 6n*6n Y_NR matrix at each iteration. No PV bus is included.
 	SPARSE *Y_Amatrix;					///Y_Amatrix store all the elements of Amatrix in equation AX=B;
+	SPARSE_COO *Y_Acoo;					///Y_Acoo stores the elements of Amatrix in triplet form when the sorted assembly method is used
+	NR_SPARSE_CACHE Y_pattern;			///Y_pattern caches the compressed-column structure of Amatrix across iterations and timesteps
+	NR_BUS_SOA bus_soa;					///bus_soa holds the voltages, loads and Jacobian terms of each bus in contiguous arrays for the iteration loops
 } NR_SOLVER_STRUCT;
 
 //Mesh-fault-related structure - passing information
@@ -138,11 +172,36 @@ typedef struct {
 	int return_code;			/// Special return codes for impedance check -- 0 = non-descript failure, 1 = success, 2 = unsupported solver
 } NR_MESHFAULT_IMPEDANCE;
 
-//Function prototypes for external solver interface
-//void *ext_solver_init(void *ext_array);
-//void ext_solver_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change);
-//int ext_solver_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount);
-//void ext_solver_destroy(void *ext_array, bool new_iteration);
+//Function prototypes for the LU solver interface - provided by built-in backends and by external libraries (LU_init, LU_alloc, LU_solve, LU_destroy)
+typedef void *(*LUINITFCN)(void *ext_array);
+typedef void (*LUALLOCFCN)(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change);
+typedef int (*LUSOLVEFCN)(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount);
+typedef void (*LUDESTROYFCN)(void *ext_array, bool new_iteration);
+
+//Built-in LU solver backend - selected by name with powerflow::lu_solver
+typedef struct {
+	const char *name;		///< name used to select the backend
+	LUINITFCN init;			///< creates the solver state, or returns the existing one (called every solution)
+	LUALLOCFCN alloc;		///< sizes the solver state when the matrices are (re)allocated
+	LUSOLVEFCN solve;		///< factors (or refactors) the matrix and overwrites rhs_LU with the solution
+	LUDESTROYFCN destroy;	///< end-of-iteration cleanup
+} LU_SOLVER_BACKEND;
+
+int lu_solver_register(const char *name, LUINITFCN init, LUALLOCFCN alloc, LUSOLVEFCN solve, LUDESTROYFCN destroy);
+LU_SOLVER_BACKEND *lu_solver_find(const char *name);
+
+//Update loops split across the solver's thread pool - fcn is called for contiguous ranges of items
+//GL_THROW can not be used from the pool threads, so ranges report errors through the status with
+//nr_stamp_fail and return - nr_stamp_run throws the first one on the calling thread once all ranges are done
+typedef struct {
+	volatile int failed;	///< set by the first range that fails
+	char error[1024];		///< message of the first failure
+} NR_STAMP_STATUS;
+
+typedef void (*NRSTAMPFCN)(void *data, unsigned int start, unsigned int stop, NR_STAMP_STATUS *status);
+unsigned int nr_stamp_threads(void);
+void nr_stamp_run(unsigned int count, unsigned int min_count, NRSTAMPFCN fcn, void *data);
+void nr_stamp_fail(NR_STAMP_STATUS *status, const char *format, ...);
 
 int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations);
 void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, bool jacobian_pass);
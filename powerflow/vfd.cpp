@@ -919,6 +919,9 @@ SIMULATIONMODE vfd::inter_deltaupdate_vfd(unsigned int64 delta_time, unsigned lo
 		//Force it to update, just in case
 		force_array_realloc = true;
 
+		//The frequency arrays advance once per deltamode timestep, so the timestep can't vary
+		deltamode_fixed_step = true;
+
 		//Call the array allocation function
 		ret_value = alloc_freq_arrays(dt_value);
 
@@ -156,6 +156,24 @@ double house_e::warn_low_temp = 55; // degF
 double house_e::warn_high_temp = 95; // degF
 bool house_e::warn_control = true;
 double house_e::system_dwell_time = 1; // seconds
+bool house_e::batch_etp = false;
+
+/* ETP batch
+	The thermal state of the houses is advanced once per presync pass for the whole population.
+	The first house to presync at a new time gathers the ETP solution of every house into
+	the arrays below and advances them all in one loop, then each house picks up its own result.
+	That loop runs on one thread while the others wait on the lock, so the batch is only enabled
+	with residential::house_batch_etp, which is best left off when threadcount is more than 1.
+ */
+static struct s_etpbatch {
+	unsigned int lock;
+	unsigned int n, size;
+	TIMESTAMP t1; // time the batch was last solved for
+	house_e **house;
+	TIMESTAMP *t0; // clock each house was advanced from, 0 if it was not advanced
+	double *dt, *k1, *r1, *k2, *r2, *Teq, *A3, *A4, *Qmass, *Qtotal, *Toutside; // solution of each house
+	double *Tair, *Tmass; // advanced temperatures
+} etp_batch = {0, 0, 0, TS_NEVER};
 
 /** House object constructor:  Registers the class and publishes the variables that can be set by the user. 
 Sets default randomized values for published variables.
@@ -491,6 +509,9 @@ house_e::house_e(MODULE *mod) : residential_enduse(mod)
 		gl_global_create("residential::system_dwell_time[s]",PT_double,&system_dwell_time,
 			PT_DESCRIPTION, "the heating/cooling system dwell time interval for changing system state",
 			NULL);
+		gl_global_create("residential::house_batch_etp",PT_bool,&batch_etp,
+			PT_DESCRIPTION, "flag to advance the thermal state of all the houses at once in each presync pass, on the first thread to reach it (off by default)",
+			NULL);
 	}	
 		gl_global_create("residential::aux_cutin_temperature[degF]",PT_double,&aux_cutin_temperature,
 			PT_DESCRIPTION, "the outdoor air temperature below which AUX heating is used",
@@ -1227,6 +1248,8 @@ int house_e::init(OBJECT *parent)
 	hdr->flags |= OF_SKIPSAFE;
 
 	heat_start = false;
+	etp_Ca = etp_Cm = etp_Hm = etp_Ua = etp_window_open = 0; // no ETP coefficients computed yet
+	etp_slot = -1;
 
 	// local object name,	meter object name
 	struct {
@@ -1682,6 +1705,32 @@ int house_e::init(OBJECT *parent)
 		}
 	}
 
+	// houses in deltamode also update their thermal state between presyncs, so they advance it themselves
+	if (batch_etp && !deltamode_inclusive)
+	{
+		::wlock(&etp_batch.lock);
+		if (etp_batch.n==etp_batch.size)
+		{
+			unsigned int size = etp_batch.size==0 ? 256 : etp_batch.size*2;
+			double **data[] = {&etp_batch.dt, &etp_batch.k1, &etp_batch.r1, &etp_batch.k2, &etp_batch.r2, &etp_batch.Teq,
+				&etp_batch.A3, &etp_batch.A4, &etp_batch.Qmass, &etp_batch.Qtotal, &etp_batch.Toutside, &etp_batch.Tair, &etp_batch.Tmass};
+			bool ok = (etp_batch.house = (house_e**)realloc(etp_batch.house,sizeof(house_e*)*size))!=NULL
+				&& (etp_batch.t0 = (TIMESTAMP*)realloc(etp_batch.t0,sizeof(TIMESTAMP)*size))!=NULL;
+			for (unsigned int i=0; ok && i<sizeof(data)/sizeof(data[0]); i++)
+				ok = (*data[i] = (double*)realloc(*data[i],sizeof(double)*size))!=NULL;
+			if (!ok)
+			{
+				::wunlock(&etp_batch.lock);
+				throw "unable to allocate memory for the ETP batch";
+			}
+			etp_batch.size = size;
+		}
+		etp_slot = etp_batch.n++;
+		etp_batch.house[etp_slot] = this;
+		etp_batch.t0[etp_slot] = 0;
+		::wunlock(&etp_batch.lock);
+	}
+
 	return 1;
 }
 
@@ -1761,32 +1810,10 @@ CIRCUIT *house_e::attach(OBJECT *obj, ///< object to attach
 	return c;
 }
 
-void house_e::update_model(double dt)
+/** Compute the constants of the ETP equations from the ETP parameters
+ **/
+void house_e::update_coefficients(void)
 {
-	/* compute solar gains */
-	//Qs = 0;
-	incident_solar_radiation = 0;
-	horizontal_diffuse_solar_radiation = 0;
-	north_incident_solar_radiation = 0;
-	north_west_incident_solar_radiation = 0;
-	west_incident_solar_radiation = 0;
-	south_west_incident_solar_radiation = 0;
-	south_incident_solar_radiation = 0;
-	south_east_incident_solar_radiation = 0;
-	east_incident_solar_radiation = 0;
-	north_east_incident_solar_radiation = 0;
-	double number_of_quadrants = 0;
-
-	// recalculate the constants of the ETP equations based off of the ETP parameters.
-	if (Ca<=0)
-		throw "air_thermal_mass must be positive";
-	if (Cm<=0)
-		throw "house_content_thermal_mass must be positive";
-	if(Hm <= 0)
-		throw "house_content_heat_transfer_coeff must be positive";
-	if(Ua < 0)
-		throw "UA must be positive";
-
 	a = Cm*Ca/Hm;
 	
 	if (window_open == 1)
@@ -1819,6 +1846,43 @@ void house_e::update_model(double dt)
 		A4 = Ca/Hm * r2 + (Ua+Hm)/Hm;
 	}
 
+	etp_Ca = Ca;
+	etp_Cm = Cm;
+	etp_Hm = Hm;
+	etp_Ua = Ua;
+	etp_window_open = window_open;
+}
+
+void house_e::update_model(double dt)
+{
+	/* compute solar gains */
+	//Qs = 0;
+	incident_solar_radiation = 0;
+	horizontal_diffuse_solar_radiation = 0;
+	north_incident_solar_radiation = 0;
+	north_west_incident_solar_radiation = 0;
+	west_incident_solar_radiation = 0;
+	south_west_incident_solar_radiation = 0;
+	south_incident_solar_radiation = 0;
+	south_east_incident_solar_radiation = 0;
+	east_incident_solar_radiation = 0;
+	north_east_incident_solar_radiation = 0;
+	double number_of_quadrants = 0;
+
+	// recalculate the constants of the ETP equations based off of the ETP parameters.
+	if (Ca<=0)
+		throw "air_thermal_mass must be positive";
+	if (Cm<=0)
+		throw "house_content_thermal_mass must be positive";
+	if(Hm <= 0)
+		throw "house_content_heat_transfer_coeff must be positive";
+	if(Ua < 0)
+		throw "UA must be positive";
+
+	// the coefficients only depend on the ETP parameters, which seldom change once the house is running
+	if (Ca!=etp_Ca || Cm!=etp_Cm || Hm!=etp_Hm || Ua!=etp_Ua || window_open!=etp_window_open)
+		update_coefficients();
+
 	//for (i=1; i<9; i++) //Compass points of pSolar include direct normal and diffuse radiation into one value
 	//	incident_solar_radiation += pSolar[i];
 	//	//Qs += pSolar[i];
@@ -2251,6 +2315,78 @@ void house_e::update_system(double dt)
 
 /**  Updates the aggregated power from all end uses, calculates the HVAC kWh use for the next synch time
 **/
+/** Copy the ETP solution of the house into slot \p i of the batch
+ **/
+void house_e::etp_batch_gather(unsigned int i, TIMESTAMP t1)
+{
+	TIMESTAMP t0 = OBJECTHDR(this)->clock;
+	const double dt = (double)((t1-t0)*TS_SECOND)/3600;
+
+	// same conditions as the per-house update in presync
+	if (t0>0 && dt>0 && c2!=0)
+	{
+		etp_batch.t0[i] = t0;
+		etp_batch.dt[i] = dt;
+	}
+	else
+	{
+		etp_batch.t0[i] = 0;
+		etp_batch.dt[i] = 0;
+	}
+	etp_batch.k1[i] = k1;
+	etp_batch.r1[i] = r1;
+	etp_batch.k2[i] = k2;
+	etp_batch.r2[i] = r2;
+	etp_batch.Teq[i] = Teq;
+	etp_batch.A3[i] = A3;
+	etp_batch.A4[i] = A4;
+	etp_batch.Qmass[i] = Qm/Hm;
+	etp_batch.Qtotal[i] = (Qm+Qa)/(window_open==1 ? 10*Ua : Ua);
+	etp_batch.Toutside[i] = Tout;
+}
+
+/** Advance the thermal state of all the houses in the batch to \p t1
+ **/
+void house_e::etp_batch_solve(TIMESTAMP t1)
+{
+	unsigned int i, n = etp_batch.n;
+	for (i=0; i<n; i++)
+		etp_batch.house[i]->etp_batch_gather(i,t1);
+
+	// the terms are summed in the same order as in presync so the results are identical
+	const double *dt = etp_batch.dt, *k1 = etp_batch.k1, *r1 = etp_batch.r1, *k2 = etp_batch.k2, *r2 = etp_batch.r2;
+	const double *A3 = etp_batch.A3, *A4 = etp_batch.A4, *Teq = etp_batch.Teq;
+	const double *Qmass = etp_batch.Qmass, *Qtotal = etp_batch.Qtotal, *Toutside = etp_batch.Toutside;
+	double *Tair = etp_batch.Tair, *Tmass = etp_batch.Tmass;
+	for (i=0; i<n; i++)
+	{
+		const double e1 = k1[i]*exp(r1[i]*dt[i]);
+		const double e2 = k2[i]*exp(r2[i]*dt[i]);
+		Tair[i] = e1 + e2 + Teq[i];
+		Tmass[i] = A3[i]*e1 + A4[i]*e2 + Qmass[i] + Qtotal[i] + Toutside[i];
+	}
+	etp_batch.t1 = t1;
+}
+
+/** Pick up the thermal state of the house from the batch, solving the batch if this is
+	the first house to presync at \p t1.
+	@returns true if the house was advanced
+ **/
+bool house_e::etp_batch_advance(TIMESTAMP t0, TIMESTAMP t1)
+{
+	::wlock(&etp_batch.lock);
+	if (etp_batch.t1!=t1)
+		etp_batch_solve(t1);
+	::wunlock(&etp_batch.lock);
+
+	// the result only holds if the house has not synced since the batch was solved
+	if (t0<=0 || etp_batch.t0[etp_slot]!=t0)
+		return false;
+	Tair = etp_batch.Tair[etp_slot];
+	Tmaterials = etp_batch.Tmass[etp_slot];
+	return true;
+}
+
 TIMESTAMP house_e::presync(TIMESTAMP t0, TIMESTAMP t1) 
 {
 	OBJECT *obj = OBJECTHDR(this);
@@ -2272,7 +2408,9 @@ TIMESTAMP house_e::presync(TIMESTAMP t0, TIMESTAMP t1)
 	load_values[2][0] = load_values[2][1] = load_values[2][2] = 0.0;
 
 	/* advance the thermal state of the building */
-	if (t0>0 && dt>0)
+	if (etp_slot>=0)
+		etp_batch_advance(t0,t1);
+	else if (t0>0 && dt>0)
 	{
 		/* calculate model update, if possible */
 		if (c2!=0)
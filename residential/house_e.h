@@ -422,6 +422,9 @@ private:
 	double dTair;
 	double a,b,c,d,c1,c2,A3,A4,k1,k2,r1,r2,Teq,Tevent,Qi,Qa,Qm,adj_cooling_cap,adj_heating_cap,adj_cooling_cop,adj_heating_cop;
 	double Qlatent;
+	double etp_Ca,etp_Cm,etp_Hm,etp_Ua,etp_window_open; // ETP parameters the coefficients were last computed for
+	int etp_slot; // index of the house in the ETP batch, -1 if the house advances its own thermal state
+	static bool batch_etp;
 	static bool warn_control;
 	static double warn_low_temp;
 	static double warn_high_temp;
@@ -449,6 +452,10 @@ public:
 	TIMESTAMP sync_enduses(TIMESTAMP t0, TIMESTAMP t1);
 	void update_system(double dt=0);
 	void update_model(double dt=0);
+	void update_coefficients(void);
+	void etp_batch_gather(unsigned int i, TIMESTAMP t1);
+	bool etp_batch_advance(TIMESTAMP t0, TIMESTAMP t1);
+	static void etp_batch_solve(TIMESTAMP t1);
 	void check_controls(void);
 	void update_Tevent(void);
 
@@ -61,26 +61,40 @@ double e2solve(double _a, double _n, double _b, double _m, double _c, double p,
 
 #else
 
-double e2solve(double a, double n, double b, double m, double c, double p, double *e)
+struct etpdata {
+	double t,a,n,b,m,c,p,e;
+	unsigned int i;
+};
+
+static glsolver *load_etp(void)
 {
-	// load the solver if not yet loaded
 	static glsolver *etp = NULL;
-	static struct etpdata {
-		double t,a,n,b,m,c,p,e;
-		unsigned int i;
-	} data;
+	static unsigned int lock = 0;
 	if ( etp==NULL )
 	{
-		etp = new glsolver("etp");
-		int version;
-		if ( etp->get("version",&version,NULL)==0 || version!=1 )
-			throw "incorrect ETP solver version";
-		if ( etp->get("init",&data,NULL)==0 )
-			throw "unable to initialize ETP solver data";
-		data.i = 100;
+		// houses sync on several threads, so only one of them may load the solver
+		wlock(&lock);
+		if ( etp==NULL )
+		{
+			glsolver *solver = new glsolver("etp");
+			int version;
+			if ( solver->get("version",&version,NULL)==0 || version!=1 )
+			{
+				wunlock(&lock);
+				throw "incorrect ETP solver version";
+			}
+			etp = solver;
+		}
+		wunlock(&lock);
 	}
+	return etp;
+}
 
-	// solve it
+double e2solve(double a, double n, double b, double m, double c, double p, double *e)
+{
+	// the solver data is kept on the stack so concurrent solutions do not share it
+	glsolver *etp = load_etp();
+	struct etpdata data;
 	data.t = 0;
 	data.a = a;
 	data.b = b;
@@ -88,6 +102,8 @@ double e2solve(double a, double n, double b, double m, double c, double p, doubl
 	data.n = n;
 	data.m = m;
 	data.p = p;
+	data.e = 0;
+	data.i = 100;
 	if ( etp->solve(&data) )
 	{
 		if ( e!=NULL )
@@ -12,6 +12,7 @@ tape_tape_la_LIBADD += third_party/jsonCpp/libjsoncpp.la
 tape_tape_la_LIBADD += -ldl
 
 tape_tape_la_SOURCES =
+tape_tape_la_SOURCES += tape/accessor.c
 tape_tape_la_SOURCES += tape/collector.c
 tape_tape_la_SOURCES += tape/file.c
 tape_tape_la_SOURCES += tape/file.h
@@ -38,3 +39,4 @@ tape_tape_la_SOURCES += tape/recorder.c
 tape_tape_la_SOURCES += tape/shaper.c
 tape_tape_la_SOURCES += tape/tape.c
 tape_tape_la_SOURCES += tape/tape.h
+tape_tape_la_SOURCES += tape/writer.c
@@ -0,0 +1,150 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file accessor.c
+	@addtogroup accessor Property accessors
+	@ingroup tapes
+
+	Property accessors are compiled when a tape links its targets so that sampling a
+	property does not repeat the name lookups and unit parsing done by gl_get_value().
+	Each accessor holds the address and type of the value, the unit conversion already
+	resolved to a scale and offsets, and the formatter used to write the value.  The
+	text written is the same as gl_get_value() would write for the recorder's line units.
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "gridlabd.h"
+
+#include "tape.h"
+
+/** Read the global double format into the caller's buffer
+	@return the buffer
+ **/
+const char *accessor_double_format(char *buffer, /**< buffer that receives the format */
+								   int size) /**< size of the buffer */
+{
+	if ( gl_global_getvar("double_format",buffer,size)==NULL )
+		strncpy(buffer,"%+lg",size);
+	return buffer;
+}
+
+/* doubles are converted and formatted here to avoid the class lookup done by convert_from_double() */
+static int format_double(PROPACCESSOR *a, char *buffer, int size)
+{
+	double value = *(double*)a->addr;
+	int count;
+	if ( a->convert )
+		value = (value - a->from_b) * a->scale + a->to_b; /* same arithmetic as gl_convert_ex() */
+	count = snprintf(buffer,size,a->double_format,value);
+	if ( count>=0 && count<size && a->unit!=NULL )
+		count += snprintf(buffer+count,size-count," %s",a->unit);
+	return ( count>=0 && count<size ) ? count : 0;
+}
+
+/* complex values needing a unit conversion are scaled before they are formatted */
+static int format_complex(PROPACCESSOR *a, char *buffer, int size)
+{
+	complex value = *(complex*)a->addr;
+	value.r *= a->scale;
+	value.i *= a->scale;
+	return gl_get_value(a->obj,&value,buffer,size,&(a->prop));
+}
+
+static int format_value(PROPACCESSOR *a, char *buffer, int size)
+{
+	return gl_get_value(a->obj,a->addr,buffer,size,&(a->prop));
+}
+
+/** Compile the accessor of a property linked by a tape
+	@return the accessor, or NULL on failure
+ **/
+PROPACCESSOR *accessor_compile(OBJECT *obj, /**< object that holds the property */
+							   PROPERTY *prop, /**< linked property, with the unit requested by the tape */
+							   LINEUNITS line_units) /**< line unit option of the tape */
+{
+	PROPACCESSOR *a = (PROPACCESSOR*)malloc(sizeof(PROPACCESSOR));
+	PROPERTY *source = gl_get_property(obj,prop->name,NULL);
+	UNIT *from = source ? source->unit : NULL;
+	UNIT *to = prop->unit;
+	if ( a==NULL )
+	{
+		gl_error("accessor_compile(): out of memory");
+		return NULL;
+	}
+	memset(a,0,sizeof(PROPACCESSOR));
+	a->obj = obj;
+	a->addr = GETADDR(obj,prop);
+	memcpy(&(a->prop),prop,sizeof(PROPERTY));
+	a->prop.oclass = NULL; /* class lookups are resolved here */
+	a->prop.next = NULL;
+	a->scale = 1.0;
+
+	/* the unit conversion done by the class when the requested unit differs */
+	if ( from!=NULL && to!=NULL && (from!=to || (line_units==LU_NONE && prop->ptype==PT_double)) )
+	{
+		double scale = 1.0;
+		if ( gl_convert_ex(from,to,&scale)==0 )
+		{
+			gl_error("accessor_compile(): unable to convert property '%s' from '%s' to '%s'", prop->name, from->name, to->name);
+			free(a);
+			return NULL;
+		}
+		a->convert = 1;
+		a->from_b = from->b;
+		a->to_b = to->b;
+		a->scale = ( prop->ptype==PT_double ? from->a/to->a : scale );
+	}
+
+	if ( prop->ptype==PT_double )
+	{
+		a->format = format_double;
+		accessor_double_format(a->double_format,sizeof(a->double_format));
+		/* LU_NONE drops the unit when the value is converted */
+		a->unit = ( to!=NULL && !(line_units==LU_NONE && a->convert) ) ? to->name : NULL;
+	}
+	else if ( prop->ptype==PT_complex && a->convert )
+		a->format = format_complex;
+	else
+		a->format = format_value;
+	return a;
+}
+
+/** Compile the accessors of a linked property list
+	@return the first accessor, or NULL on failure
+ **/
+PROPACCESSOR *accessor_compile_list(OBJECT *obj, PROPERTY *list, LINEUNITS line_units)
+{
+	PROPACCESSOR *first=NULL, *last=NULL;
+	PROPERTY *p;
+	for ( p=list ; p!=NULL ; p=p->next )
+	{
+		PROPACCESSOR *a = accessor_compile(obj,p,line_units);
+		if ( a==NULL )
+			return NULL;
+		if ( first==NULL ) first=a; else last->next=a;
+		last = a;
+	}
+	return first;
+}
+
+/** Write the values of an accessor list as comma-separated text
+	@return the number of values written
+ **/
+int accessor_read_list(PROPACCESSOR *list, char *buffer, int size)
+{
+	PROPACCESSOR *a;
+	int offset=0;
+	int count=0;
+	for ( a=list ; a!=NULL && offset<size-33 ; a=a->next )
+	{
+		if ( offset>0 ) strcpy(buffer+offset++,",");
+		offset += a->format(a,buffer+offset,size-offset-1);
+		buffer[offset]='\0';
+		count++;
+	}
+	return count;
+}
+
+/**@}*/
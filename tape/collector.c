@@ -154,11 +154,12 @@ static TIMESTAMP collector_write(OBJECT *obj)
 
 AGGREGATION *link_aggregates(char *aggregate_list, char *group)
 {
-	char *item;
+	char *item, *next;
 	AGGREGATION *first=NULL, *last=NULL;
 	char1024 list;
 	strcpy(list,aggregate_list); /* avoid destroying orginal list */
-	for (item=strtok(list,","); item!=NULL; item=strtok(NULL,","))
+	/* collectors are linked by concurrent sync threads so strtok() cannot be used */
+	for (item=strtok_s(list,",",&next); item!=NULL; item=strtok_s(NULL,",",&next))
 	{
 		AGGREGATION *aggr = gl_create_aggregate(item,group);
 		if (aggr!=NULL)
@@ -179,9 +180,9 @@ int read_aggregates(AGGREGATION *aggr, char *buffer, int size)
 	AGGREGATION *p;
 	int offset=0;
 	int count=0;
-	char32 fmt;
+	char32 format;
+	const char *fmt = accessor_double_format(format,sizeof(format)); /* read once per sample instead of once per aggregate */
 
-	gl_global_getvar("double_format", fmt, 32);
 	for (p=aggr; p!=NULL && offset<size-33; p=p->next)
 	{
 		if (offset>0) strcpy(buffer+offset++,",");
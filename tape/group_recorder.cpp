@@ -151,6 +151,7 @@ int group_recorder::init(OBJECT *obj){
 	}
 
 	// turn list into objlist, count items
+	quickobjlist *tail = 0;
 	obj_count = 0;
 	for(gr_obj = gl_find_next(items, 0); gr_obj != 0; gr_obj = gl_find_next(items, gr_obj) ){
 		prop_ptr = gl_get_property(gr_obj, property_name.get_string());
@@ -164,9 +165,9 @@ int group_recorder::init(OBJECT *obj){
 		}
 		++obj_count;
 		if(obj_list == 0){
-			obj_list = new quickobjlist(gr_obj, prop_ptr);
+			obj_list = tail = new quickobjlist(gr_obj, prop_ptr);
 		} else {
-			obj_list->tack(gr_obj, prop_ptr);
+			tail = tail->tack(gr_obj, prop_ptr);
 		}
 	}
 
@@ -178,6 +179,18 @@ int group_recorder::init(OBJECT *obj){
 		}
 	}
 
+	// compile the accessors so that read_line() does no property lookups
+	for(quickobjlist *itr = obj_list; itr != 0; itr = itr->next){
+		itr->access = accessor_compile(itr->obj, &(itr->prop), LU_DEFAULT);
+		if(itr->access == 0){
+			gl_error("group_recorder::init(): unable to compile the accessor of property '%s'", itr->prop.name);
+			/* TROUBLESHOOT
+				The units of the property could not be resolved for one of the objects in the group.
+			 */
+			return 0;
+		}
+	}
+
 	tape_status = TS_OPEN;
 	if(0 == write_header()){
 		gl_error("group_recorder::init(): an error occured when writing the file header");
@@ -188,6 +201,9 @@ int group_recorder::init(OBJECT *obj){
 		return 0;
 	}
 
+	// lines are queued to the tape writer thread from here on
+	writer = writer_open(rec_file);
+
 	/* set up the delta_mode flag, if necessary */
 	if ( (thisobj->flags)&OF_DELTAMODE )
 	{
@@ -336,6 +352,12 @@ int group_recorder::commit(TIMESTAMP t1, double t1dbl, bool deltacall){
 	// check if write limit
 	if(limit > 0 && write_count >= limit){
 		// write footer
+		if(writer != 0){
+			if(0 == writer_close(writer)){
+				gl_error("group_recorder::commit(): error when writing to the output file");
+			}
+			writer = 0;
+		}
 		write_footer();
 		fclose(rec_file);
 		rec_file = 0;
@@ -468,7 +490,7 @@ int group_recorder::read_line(){
 			double part_value = 0.0;
 			complex *cptr = 0;
 			// get value as a complex
-			cptr = gl_get_complex(curr->obj, &(curr->prop));
+			cptr = (complex*)curr->access->addr;
 			if(0 == cptr){
 				gl_error("group_recorder::read_line(): unable to get complex property '%s' from object '%s'", curr->prop.name, gl_name(curr->obj, objname, 127));
 				/* TROUBLESHOOT
@@ -501,7 +523,7 @@ int group_recorder::read_line(){
 			sprintf(buffer, "%f", part_value);
 			offset = strlen(buffer);
 		} else {
-			offset = gl_get_value(curr->obj, GETADDR(curr->obj, &(curr->prop)), buffer, 127, &(curr->prop));
+			offset = curr->access->format(curr->access, buffer, 127);
 			if(0 == offset){
 				gl_error("group_recorder::read_line(): unable to get value for '%s' in object '%s'", curr->prop.name, curr->obj->name);
 				/* TROUBLESHOOT
@@ -611,7 +633,13 @@ int group_recorder::write_line(TIMESTAMP t1, double t1dbl, bool deltacall){
 	}
 
 	// print line to file
-	if(0 >= fprintf(rec_file, "%s%s\n", time_str, line_buffer)){
+	if(writer != 0){
+		if(0 > writer_write(writer, time_str, strlen(time_str)) || 0 > writer_write(writer, line_buffer, strlen(line_buffer)) || 0 > writer_write(writer, "\n", 1)){
+			gl_error("group_recorder::write_line(): error when writing to the output file");
+			tape_status = TS_ERROR;
+			return 0;
+		}
+	} else if(0 >= fprintf(rec_file, "%s%s\n", time_str, line_buffer)){
 		gl_error("group_recorder::write_line(): error when writing to the output file");
 		/* TROUBLESHOOT
 			File I/O error.
@@ -642,7 +670,10 @@ int group_recorder::flush_line(){
 		tape_status = TS_ERROR;
 		return 0;
 	}
-	if(0 != fflush(rec_file)){
+	if(writer != 0){
+		// the writer thread flushes once the queued lines are written
+		writer_flush(writer);
+	} else if(0 != fflush(rec_file)){
 		gl_error("group_recorder::flush_line(): unable to flush output file");
 		/* TROUBLESHOOT
 			An IO error has occured.
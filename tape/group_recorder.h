@@ -12,12 +12,13 @@ EXPORT int group_recorder_postroutine(OBJECT *obj, double timedbl);
 
 class quickobjlist{
 public:
-	quickobjlist(){obj = 0; next = 0; memset(&prop, 0, sizeof(PROPERTY));}
-	quickobjlist(OBJECT *o, PROPERTY *p){obj = o; next = 0; memcpy(&prop, p, sizeof(PROPERTY));}
-	~quickobjlist(){if(next != 0) delete next;}
-	void tack(OBJECT *o, PROPERTY *p){if(next){next->tack(o, p);} else {next = new quickobjlist(o, p);}}
+	quickobjlist(){obj = 0; next = 0; access = 0; memset(&prop, 0, sizeof(PROPERTY));}
+	quickobjlist(OBJECT *o, PROPERTY *p){obj = o; next = 0; access = 0; memcpy(&prop, p, sizeof(PROPERTY));}
+	~quickobjlist(){if(access != 0) free(access); if(next != 0) delete next;}
+	quickobjlist *tack(OBJECT *o, PROPERTY *p){next = new quickobjlist(o, p); return next;}
 	OBJECT *obj;
 	PROPERTY prop;
+	PROPACCESSOR *access; // compiled once the units are settled
 	quickobjlist *next;
 };
 
@@ -52,6 +53,7 @@ private:
 	int write_footer();
 private:
 	FILE *rec_file;
+	TAPEWRITER *writer; // asynchronous writer of rec_file (0 when written directly)
 	FINDLIST *items;
 	quickobjlist *obj_list;
 	PROPERTY *prop_ptr;
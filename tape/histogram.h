@@ -57,6 +57,7 @@ public:
 		void *tsp;
 		/** add handles for other type of sources as needed */
 	};
+	TAPEWRITER *writer; /* asynchronous writer of the file (NULL when written directly) */
 
 	BIN *bin_list;
 public:
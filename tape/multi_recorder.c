@@ -108,6 +108,7 @@ EXPORT int create_multi_recorder(OBJECT **obj, OBJECT *parent)
 		my->target = gl_get_property(*obj,my->property,NULL);
 		my->header_units = HU_DEFAULT;
 		my->line_units = LU_DEFAULT;
+		my->access = NULL;
 		return 1;
 	}
 	return 0;
@@ -665,58 +666,32 @@ RECORDER_MAP *link_multi_properties(OBJECT *obj, char *property_list)
 	return first;
 }
 
-int read_multi_properties(struct recorder *my, OBJECT *obj, RECORDER_MAP *rmap, char *buffer, int size)
+/** Compile the accessors of the properties in the recorder map
+	@return the first accessor, or NULL on failure
+ **/
+static PROPACCESSOR *compile_multi_properties(struct recorder *my, RECORDER_MAP *rmap)
 {
+	PROPACCESSOR *first=NULL, *last=NULL;
 	RECORDER_MAP *r;
-	int offset = 0;
-	int count = 0;
-	double value;
-	PROPERTY *p2 = 0;
-	PROPERTY fake;
-	memset(&fake, 0, sizeof(PROPERTY));
-	fake.ptype = PT_double;
-	fake.unit = 0;
-	for(r = rmap; r != NULL && offset < size - 33; r = r->next){
-		if(offset > 0){
-			strcpy(buffer+offset++,",");
+	for(r = rmap; r != NULL; r = r->next){
+		PROPACCESSOR *a = accessor_compile(r->obj, &(r->prop), my->line_units);
+		if(a == NULL){
+			return NULL;
 		}
-//		offset += gl_get_value(r->obj, GETADDR(r->obj, &(r->prop)), buffer + offset, size - offset - 1, &(r->prop)); /* pointer => int64 */
-		if(r->prop.ptype == PT_double){
-			switch(my->line_units){
-				case LU_ALL:
-					// cascade into 'default', as prop->unit should've been set, if there's a unit available.
-				case LU_DEFAULT:
-					offset+=gl_get_value(r->obj,GETADDR(r->obj,&(r->prop)),buffer+offset,size-offset-1,&(r->prop)); /* pointer => int64 */
-					break;
-				case LU_NONE:
-					// copy value into local value, use fake PROP, feed into gl_get_vaule
-					value = *gl_get_double(r->obj, &(r->prop));
-					p2 = gl_get_property(r->obj, r->prop.name,NULL);
-					if(p2 == 0){
-						gl_error("unable to locate %s.%s for LU_NONE", r->obj, r->prop.name);
-						return 0;
-					}
-					if(r->prop.unit != 0 && p2->unit != 0){
-						if(0 == gl_convert_ex(p2->unit, r->prop.unit, &value)){
-							gl_error("unable to convert %s to %s for LU_NONE", r->prop.unit, p2->unit);
-						} else { // converted
-							offset+=gl_get_value(r->obj,&value,buffer+offset,size-offset-1,&fake); /* pointer => int64 */;
-						}
-					} else {
-						offset+=gl_get_value(r->obj,GETADDR(r->obj,&(r->prop)),buffer+offset,size-offset-1,&(r->prop)); /* pointer => int64 */;
-					}
-					break;
-				default:
-					break;
-			}
+		if(first == NULL){
+			first = a;
 		} else {
-		  //offset += gl_get_value(obj,    GETADDR(obj,    p),          buffer+offset, size-offset-1, p); /* pointer => int64 */
-			offset += gl_get_value(r->obj, GETADDR(r->obj, &(r->prop)), buffer+offset, size-offset-1, &(r->prop)); /* pointer => int64 */
+			last->next = a;
 		}
-		buffer[offset] = '\0';
-		count++;
+		last = a;
 	}
-	return count;
+	return first;
+}
+
+int read_multi_properties(struct recorder *my, OBJECT *obj, RECORDER_MAP *rmap, char *buffer, int size)
+{
+	/* the accessors compiled when the map was linked resolve the type, units and lookups */
+	return accessor_read_list(my->access, buffer, size);
 }
 
 EXPORT TIMESTAMP sync_multi_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
@@ -748,6 +723,9 @@ EXPORT TIMESTAMP sync_multi_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 	/* connect to property */
 	if (my->rmap==NULL){
 		my->rmap = link_multi_properties(obj->parent,my->property); // allowable use of obj->parent
+		if(my->rmap != NULL && (my->access = compile_multi_properties(my, my->rmap)) == NULL){
+			my->rmap = NULL;
+		}
 	}
 	/*	invalid target object must be handled individually */
 	/*if (my->target==NULL)
@@ -99,6 +99,9 @@ EXPORT int create_recorder(OBJECT **obj, OBJECT *parent)
 		my->header_units = HU_DEFAULT;
 		my->line_units = LU_DEFAULT;
 		my->flush = -1; /* -1 (default): flush when buffer full, 0 flush each line, >0 flush seconds */
+		my->raw = my->last_raw = NULL;
+		my->raw_count = 0;
+		my->access = NULL;
 		return 1;
 	}
 	return 0;
@@ -134,6 +137,10 @@ static int recorder_open(OBJECT *obj)
 		sprintf(fname,"%s-%d.%s",obj->parent->oclass->name,obj->parent->id, my->filetype);
 
 	/* open multiple-run input file & temp output file */
+	if(my->raw != NULL && my->multifile[0] != 0){
+		gl_error("recorder:%d: binary tapes cannot use multi-run output files", obj->id);
+		return 0;
+	}
 	if(my->type == FT_FILE && my->multifile[0] != 0){
 		if(my->interval < 1){
 			gl_error("transient recorders cannot use multi-run output files");
@@ -370,7 +377,7 @@ static int recorder_open(OBJECT *obj)
 
 static int write_recorder(struct recorder *my, char *ts, char *value)
 {
-	int rc=my->ops->write(my, ts, value);
+	int rc = my->raw!=NULL ? my->ops->write_binary(my, my->last.ts, 0, my->last_raw) : my->ops->write(my, ts, value);
 	if ( (my->flush==0 || (my->flush>0 && my->flush%gl_globalclock==0)) && my->ops->flush!=NULL ) 
 		my->ops->flush(my);
 	return rc;
@@ -408,6 +415,18 @@ static TIMESTAMP recorder_write(OBJECT *obj)
 {
 	struct recorder *my = OBJECTDATA(obj,struct recorder);
 	char ts[64]="0"; /* 0 = INIT */
+	if (my->raw!=NULL)
+	{
+		/* binary tapes store the raw timestamp and values */
+		if ((my->limit>0 && my->samples > my->limit) || write_recorder(my, NULL, NULL)==0)
+		{
+			close_recorder(my);
+			my->status = TS_DONE;
+		}
+		else
+			my->samples++;
+		return TS_NEVER;
+	}
 	if (my->format==0)
 	{
 		if (my->last.ts>TS_ZERO)
@@ -575,55 +594,109 @@ PROPERTY *link_properties(struct recorder *rec, OBJECT *obj, char *property_list
 
 int read_properties(struct recorder *my, OBJECT *obj, PROPERTY *prop, char *buffer, int size)
 {
-	PROPERTY *p;
-	PROPERTY *p2 = 0;
-	PROPERTY fake;
-	int offset=0;
+	/* the accessors compiled when the target was linked resolve the type, units and lookups */
+	return accessor_read_list(my->access,buffer,size);
+}
+
+/** Read the target properties as raw values for binary tapes
+	@return the number of properties read, 0 on failure
+ **/
+int read_properties_raw(struct recorder *my, OBJECT *obj, PROPERTY *prop, BINARYVALUE *values)
+{
+	PROPACCESSOR *a;
 	int count=0;
-	double value;
-	memset(&fake, 0, sizeof(PROPERTY));
-	fake.ptype = PT_double;
-	fake.unit = 0;
-	for (p=prop; p!=NULL && offset<size-33; p=p->next)
+	for (a=my->access; a!=NULL; a=a->next)
 	{
-		if (offset>0) strcpy(buffer+offset++,",");
-		if(p->ptype == PT_double){
-			switch(my->line_units){
-				case LU_ALL:
-					// cascade into 'default', as prop->unit should've been set, if there's a unit available.
-				case LU_DEFAULT:
-					offset+=gl_get_value(obj,GETADDR(obj,p),buffer+offset,size-offset-1,p); /* pointer => int64 */
-					break;
-				case LU_NONE:
-					// copy value into local value, use fake PROP, feed into gl_get_vaule
-					value = *gl_get_double(obj, p);
-					p2 = gl_get_property(obj, p->name,NULL);
-					if(p2 == 0){
-						gl_error("unable to locate %s.%s for LU_NONE", obj, p->name);
-						return 0;
-					}
-					if(p->unit != 0 && p2->unit != 0){
-						if(0 == gl_convert_ex(p2->unit, p->unit, &value)){
-							gl_error("unable to convert %s to %s for LU_NONE", p->unit, p2->unit);
-						} else { // converted
-							offset+=gl_get_value(obj,&value,buffer+offset,size-offset-1,&fake); /* pointer => int64 */;
-						}
-					} else {
-						offset+=gl_get_value(obj,GETADDR(obj,p),buffer+offset,size-offset-1,p); /* pointer => int64 */;
-					}
-					break;
-				default:
-					break;
-			}
-		} else {
-			offset+=gl_get_value(obj,GETADDR(obj,p),buffer+offset,size-offset-1,p); /* pointer => int64 */
+		void *addr = a->addr;
+		switch (a->prop.ptype) {
+		case PT_double: (values++)->d = a->convert ? (*(double*)addr - a->from_b) * a->scale + a->to_b : *(double*)addr; break;
+		case PT_complex: (values++)->d = ((complex*)addr)->r * a->scale; (values++)->d = ((complex*)addr)->i * a->scale; break;
+		case PT_int16: (values++)->i = *(int16*)addr; break;
+		case PT_int32: (values++)->i = *(int32*)addr; break;
+		case PT_int64: (values++)->i = *(int64*)addr; break;
+		case PT_enumeration: (values++)->i = *(enumeration*)addr; break;
+		case PT_set: (values++)->i = (int64)*(set*)addr; break;
+		case PT_bool: (values++)->i = *(bool*)addr ? 1 : 0; break;
+		case PT_timestamp: (values++)->i = *(TIMESTAMP*)addr; break;
+		default: return 0;
 		}
-		buffer[offset]='\0';
 		count++;
 	}
 	return count;
 }
 
+/** Allocate the raw sample buffers when the recorder writes to a binary tape
+	@return 1 on success (or when the tape is not binary), 0 on failure
+ **/
+static int recorder_binary_init(OBJECT *obj)
+{
+	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	TAPEFUNCS *f = get_ftable(my->mode);
+	PROPERTY *p;
+	unsigned int count = 0;
+	if (f==NULL || f->recorder==NULL || f->recorder->write_binary==NULL)
+		return 1;
+	for (p=my->target; p!=NULL; p=p->next)
+	{
+		switch (p->ptype) {
+		case PT_double: case PT_int16: case PT_int32: case PT_int64:
+		case PT_enumeration: case PT_set: case PT_bool: case PT_timestamp:
+			count++;
+			break;
+		case PT_complex:
+			count+=2;
+			break;
+		default:
+			gl_error("recorder:%d: property '%s' cannot be written to a binary tape", obj->id, p->name);
+			return 0;
+		}
+	}
+	my->raw = (BINARYVALUE*)malloc(sizeof(BINARYVALUE)*count*2);
+	if (my->raw==NULL)
+	{
+		gl_error("recorder:%d: unable to allocate memory for binary tape samples", obj->id);
+		return 0;
+	}
+	memset(my->raw,0,sizeof(BINARYVALUE)*count*2);
+	my->last_raw = my->raw+count;
+	my->raw_count = count;
+	return 1;
+}
+
+/** Read the current sample into \p buffer (text tapes) or \p my->raw (binary tapes)
+	@return the number of properties read, 0 on failure
+ **/
+static int recorder_read(struct recorder *my, OBJECT *obj, char *buffer, int size)
+{
+	if (my->raw==NULL)
+		return read_properties(my,obj,my->target,buffer,size);
+
+	/* binary tapes only need the text when a trigger is compared with it */
+	if (my->trigger[0]!='\0' && read_properties(my,obj,my->target,buffer,size)==0)
+		return 0;
+	return read_properties_raw(my,obj,my->target,my->raw);
+}
+
+/** Check whether the sample just read differs from the last sample taken */
+static int recorder_changed(struct recorder *my, char *buffer)
+{
+	if (my->raw==NULL)
+		return strcmp(buffer,my->last.value)!=0;
+	return my->last.value[0]=='\0' || memcmp(my->raw,my->last_raw,sizeof(BINARYVALUE)*my->raw_count)!=0;
+}
+
+/** Keep the sample just read as the next sample to write */
+static void recorder_keep(struct recorder *my, char *buffer)
+{
+	if (my->raw==NULL)
+		strncpy(my->last.value,buffer,sizeof(my->last.value));
+	else
+	{
+		memcpy(my->last_raw,my->raw,sizeof(BINARYVALUE)*my->raw_count);
+		strcpy(my->last.value,"(binary)"); /* marks the raw sample as pending */
+	}
+}
+
 EXPORT int finalize_recorder(OBJECT *obj)
 {
 	struct recorder *my = OBJECTDATA(obj,struct recorder);
@@ -661,6 +734,15 @@ EXPORT TIMESTAMP sync_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 	/* connect to property */
 	if (my->target==NULL){
 		my->target = link_properties(my, obj->parent, my->property);
+		if (my->target!=NULL && (my->access = accessor_compile_list(obj->parent, my->target, my->line_units))==NULL)
+			my->target = NULL;
+		if (my->target!=NULL && !recorder_binary_init(obj))
+		{
+			sprintf(buffer,"'%s' cannot be recorded to a '%s' tape", my->property, my->mode);
+			close_recorder(my);
+			my->status = TS_ERROR;
+			goto Error;
+		}
 	}
 	if (my->target==NULL)
 	{
@@ -688,7 +770,7 @@ EXPORT TIMESTAMP sync_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 
 	/* update property value */
 	if ((my->target != NULL) && (my->interval == 0 || my->interval == -1)){	
-		if(read_properties(my, obj->parent,my->target,buffer,sizeof(buffer))==0)
+		if(recorder_read(my, obj->parent,buffer,sizeof(buffer))==0)
 		{
 			sprintf(buffer,"unable to read property '%s' of %s %d", my->property, obj->parent->oclass->name, obj->parent->id);
 			close_recorder(my);
@@ -697,7 +779,7 @@ EXPORT TIMESTAMP sync_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 	}
 	if ((my->target != NULL) && (my->interval > 0)){
 		if((t0 >=my->last.ts + my->interval) || ((t0 == my->last.ts) && (my->last.ns == 0))){
-			if(read_properties(my, obj->parent,my->target,buffer,sizeof(buffer))==0)
+			if(recorder_read(my, obj->parent,buffer,sizeof(buffer))==0)
 			{
 				sprintf(buffer,"unable to read property '%s' of %s %d", my->property, obj->parent->oclass->name, obj->parent->id);
 				close_recorder(my);
@@ -738,11 +820,11 @@ EXPORT TIMESTAMP sync_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 	if (my->status==TS_OPEN)
 	{	
 		if (my->interval==0 /* sample on every pass */
-			|| ((my->interval==-1) && my->last.ts!=t0 && strcmp(buffer,my->last.value)!=0) /* sample only when value changes */
+			|| ((my->interval==-1) && my->last.ts!=t0 && recorder_changed(my,buffer)) /* sample only when value changes */
 			)
 
 		{
-			strncpy(my->last.value,buffer,sizeof(my->last.value));
+			recorder_keep(my,buffer);
 
 			/* Deltamode-related check -- if we're ahead, don't overwrite this */
 			if (my->last.ts < t0)
@@ -752,7 +834,7 @@ EXPORT TIMESTAMP sync_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 				recorder_write(obj);
 			}
 		} else if ((my->interval > 0) && (my->last.ts == t0) && (my->last.ns == 0)){
-			strncpy(my->last.value,buffer,sizeof(my->last.value));
+			recorder_keep(my,buffer);
 		}
 	}
 Error:
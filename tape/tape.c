@@ -75,8 +75,13 @@ static char1024 tape_gnuplot_path;
 int32 flush_interval = 0;
 int csv_data_only = 0; /* enable this option to suppress addition of lines starting with # in CSV */
 int csv_keep_clean = 0; /* enable this option to keep data flushed at end of line */
+int32 binary_chunk_size = 4096; /* number of samples per chunk in binary tapes */
+enumeration binary_compression = 1; /* 0=NONE, 1=DELTA compression of binary tape columns */
 void (*update_csv_data_only)(void)=NULL;
 void (*update_csv_keep_clean)(void)=NULL;
+extern int32 async_output; /* see writer.c */
+extern int32 output_buffer_size;
+extern WRITEROPS writer_ops;
 
 void set_csv_options(void)
 {
@@ -93,6 +98,8 @@ typedef int (*REWINDFUNC)(void *);
 typedef void (*CLOSEFUNC)(void *);
 typedef void (*VOIDCALL)(void);
 typedef void (*FLUSHFUNC)(void*);
+typedef int (*WRITEBINARYFUNC)(void *, TIMESTAMP, int64, BINARYVALUE *);
+typedef void (*SETWRITERFUNC)(WRITEROPS *);
 
 TAPEFUNCS *get_ftable(char *mode){
 	/* check what we've already loaded */
@@ -101,6 +108,7 @@ TAPEFUNCS *get_ftable(char *mode){
 	TAPEOPS *ops = NULL;
 	void *lib = NULL;
 	CALLBACKS **c = NULL;
+	SETWRITERFUNC set_writer = NULL;
 	char tpath[1024];
 	while(fptr != NULL){
 		if(strcmp(fptr->mode, mode) == 0)
@@ -156,6 +164,7 @@ TAPEFUNCS *get_ftable(char *mode){
 	ops->rewind = NULL;
 	ops->close = (CLOSEFUNC)DLSYM(lib, "close_recorder");
 	ops->flush = (FLUSHFUNC)DLSYM(lib, "flush_collector");
+	ops->write_binary = (WRITEBINARYFUNC)DLSYM(lib, "write_recorder_binary");
 
 	ops = fptr->histogram = malloc(sizeof(TAPEOPS));
 	memset(ops,0,sizeof(TAPEOPS));
@@ -179,6 +188,11 @@ TAPEFUNCS *get_ftable(char *mode){
 
 	update_csv_data_only = (VOIDCALL)DLSYM(lib,"set_csv_data_only");
 	update_csv_keep_clean = (VOIDCALL)DLSYM(lib,"set_csv_keep_clean");
+
+	/* plugins that write files share the asynchronous writer */
+	set_writer = (SETWRITERFUNC)DLSYM(lib,"set_tape_writer");
+	if ( set_writer!=NULL )
+		(*set_writer)(&writer_ops);
 	return funcs;
 }
 
@@ -203,6 +217,13 @@ EXPORT CLASS *init(CALLBACKS *fntable, void *module, int argc, char *argv[])
 	gl_global_create("tape::flush_interval",PT_int32,&flush_interval,NULL);
 	gl_global_create("tape::csv_data_only",PT_int32,&csv_data_only,NULL);
 	gl_global_create("tape::csv_keep_clean",PT_int32,&csv_keep_clean,NULL);
+	gl_global_create("tape::binary_chunk_size",PT_int32,&binary_chunk_size,PT_DESCRIPTION,"number of samples buffered per chunk in binary tapes",NULL);
+	gl_global_create("tape::binary_compression",PT_enumeration,&binary_compression,PT_DESCRIPTION,"compression of the columns in binary tapes",
+		PT_KEYWORD,"NONE",(enumeration)0,
+		PT_KEYWORD,"DELTA",(enumeration)1,
+		NULL);
+	gl_global_create("tape::async_output",PT_int32,&async_output,PT_DESCRIPTION,"non-zero to write tape files from a background thread",NULL);
+	gl_global_create("tape::output_buffer_size",PT_int32,&output_buffer_size,PT_DESCRIPTION,"size of the buffer queued for each asynchronous tape file (bytes)",NULL);
 
 	/* control delta mode */
 	gl_global_create("tape::delta_mode_needed", PT_timestamp, &delta_mode_needed,NULL);
@@ -512,11 +533,23 @@ EXPORT SIMULATIONMODE interupdate(MODULE *module, TIMESTAMP t0, unsigned int64 d
 					struct recorder *my = (struct recorder *)OBJECTDATA(obj,struct recorder);
 					char value[1024];
 					extern int read_properties(struct recorder *my, OBJECT *obj, PROPERTY *prop, char *buffer, int size);
+					extern int read_properties_raw(struct recorder *my, OBJECT *obj, PROPERTY *prop, BINARYVALUE *values);
 
 					/* See if we're in service */
 					if ((obj->in_svc_double <= gl_globaldeltaclock) && (obj->out_svc_double >= gl_globaldeltaclock))
 					{
-						if( read_properties(my, obj->parent,my->target,value,sizeof(value)) )
+						if ( my->raw!=NULL )
+						{
+							/* binary tapes keep the sub-second part of the clock in the timestamp column */
+							int64 rec_nanoseconds = (int64)((recorder_delta_clock-(double)rec_integer_clock)*1e9+0.5);
+							if ( read_properties_raw(my,obj->parent,my->target,my->raw)
+								&& !my->ops->write_binary(my,rec_integer_clock,rec_nanoseconds,my->raw) )
+							{
+								gl_error("recorder:%d: unable to write sample to file", obj->id);
+								return SM_ERROR;
+							}
+						}
+						else if( read_properties(my, obj->parent,my->target,value,sizeof(value)) )
 						{
 							if ( !my->ops->write(my, recorder_timestamp, value) )
 							{
@@ -835,6 +868,15 @@ EXPORT STATUS postupdate(MODULE *module, TIMESTAMP t0, unsigned int64 dt)
 	return SUCCESS;
 }
 
+EXPORT void term(void)
+{
+	/* write whatever the tapes still have queued */
+	writer_term();
+
+	/* files written directly that are never closed (collectors, group_recorders) still hold their last buffer */
+	fflush(NULL);
+}
+
 int do_kill()
 {
 	/* if global memory needs to be released, this is the time to do it */
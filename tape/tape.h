@@ -24,6 +24,12 @@ typedef enum {UNKNOWN=0, PLAYER=1, RECORDER=2, GROUPRECORDER=3} DELTATAPEOBJ;
 typedef enum {HU_DEFAULT, HU_ALL, HU_NONE} HEADERUNITS;
 typedef enum {LU_DEFAULT, LU_ALL, LU_NONE} LINEUNITS;
 
+/* raw sample value kept by recorders writing to binary tapes */
+typedef union {
+	double d;	/* double properties and complex parts */
+	int64 i;	/* integer, enumeration, set, bool and timestamp properties */
+} BINARYVALUE;
+
 typedef struct s_tape_operations {
 	int (*open)(void *my, char *fname, char *flags);
 	char *(*read)(void *my,char *buffer,unsigned int size);
@@ -31,6 +37,7 @@ typedef struct s_tape_operations {
 	int (*rewind)(void *my);
 	void (*close)(void *my);
 	void (*flush)(void *my);
+	int (*write_binary)(void *my, TIMESTAMP ts, int64 ns, BINARYVALUE *values); /* only provided by binary tapes */
 } TAPEOPS;
 
 typedef struct s_tape_funcs {
@@ -59,6 +66,29 @@ typedef struct s_recobjmap {
 	struct s_recobjmap *next;
 } RECORDER_MAP;
 
+/* property accessor compiled when a tape links its targets (see accessor.c) */
+typedef struct s_propaccessor {
+	OBJECT *obj; /* object that holds the value */
+	void *addr; /* address of the value */
+	PROPERTY prop; /* property used to format the value (class lookups resolved) */
+	int convert; /* non-zero when a unit conversion is applied */
+	double from_b, scale, to_b; /* unit conversion: (value-from_b)*scale+to_b (complex values are only scaled) */
+	char *unit; /* unit name written after double values (NULL for none) */
+	char32 double_format; /* global double format read when the accessor is compiled */
+	int (*format)(struct s_propaccessor *a, char *buffer, int size); /* formatter of the value */
+	struct s_propaccessor *next;
+} PROPACCESSOR;
+
+/* asynchronous writer of a tape output (see writer.c) */
+typedef struct s_tapewriter TAPEWRITER;
+typedef struct s_writerops {
+	TAPEWRITER *(*open)(FILE *fp); /* attach a writer to an open file (NULL when the file is written directly) */
+	int (*write)(TAPEWRITER *w, const char *data, size_t len); /* queue data */
+	int (*print)(TAPEWRITER *w, const char *format, ...); /* queue formatted data */
+	void (*flush)(TAPEWRITER *w); /* request a flush of the file */
+	int (*close)(TAPEWRITER *w); /* wait for the queued data and release the writer */
+} WRITEROPS;
+
 typedef struct s_deltaobj {
 	OBJECT *obj;
 	DELTATAPEOBJ obj_type;
@@ -167,6 +197,7 @@ struct recorder {
 	int32 flush;
 	/* private */
 	RECORDER_MAP *rmap;
+	PROPACCESSOR *access; /* compiled accessors of the target (or rmap) properties */
 	TAPEOPS *ops;
 	FILETYPE type;
 	HEADERUNITS header_units;
@@ -177,6 +208,7 @@ struct recorder {
 		void *tsp;
 		/** add handles for other type of sources as needed */
 	};
+	TAPEWRITER *writer; /* asynchronous writer of the file (NULL when written directly) */
 	TAPESTATUS status;
 	char8 delim;
 	struct {
@@ -187,6 +219,9 @@ struct recorder {
 	int32 samples;
 	PROPERTY *target;
 	char256 strftime_format;
+	BINARYVALUE *raw; /* values of the current read (binary tapes only) */
+	BINARYVALUE *last_raw; /* values of the last sample taken (binary tapes only) */
+	unsigned int raw_count; /* number of values in a sample (binary tapes only) */
 };
 /** @}
 	@addtogroup collector
@@ -218,6 +253,7 @@ struct collector {
 		void *tsp;
 		/** add handles for other type of sources as needed */
 	};
+	TAPEWRITER *writer; /* asynchronous writer of the file (NULL when written directly) */
 	TAPESTATUS status;
 	char8 delim;
 	struct {
@@ -228,6 +264,18 @@ struct collector {
 	AGGREGATION *aggr;
 };
 
+CDECL const char *accessor_double_format(char *buffer, int size);
+CDECL PROPACCESSOR *accessor_compile(OBJECT *obj, PROPERTY *prop, LINEUNITS line_units);
+CDECL PROPACCESSOR *accessor_compile_list(OBJECT *obj, PROPERTY *list, LINEUNITS line_units);
+CDECL int accessor_read_list(PROPACCESSOR *list, char *buffer, int size);
+
+CDECL TAPEWRITER *writer_open(FILE *fp);
+CDECL int writer_write(TAPEWRITER *w, const char *data, size_t len);
+CDECL int writer_printf(TAPEWRITER *w, const char *format, ...);
+CDECL void writer_flush(TAPEWRITER *w);
+CDECL int writer_close(TAPEWRITER *w);
+CDECL void writer_term(void);
+
 void enable_deltamode(TIMESTAMP t1); /* indicate when deltamode is needed */
 EXPORT int delta_add_tape_device(OBJECT *obj, DELTATAPEOBJ tape_type);
 void set_csv_options(void);
@@ -0,0 +1,294 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file writer.c
+	@addtogroup writer Asynchronous tape output
+	@ingroup tapes
+
+	Tape outputs are written by a single background thread shared by all the tapes so
+	that the sync pass only copies the formatted records into a ring buffer kept for
+	each output.  The ring of an output is handed to the writer thread once it is a
+	quarter full, when a flush is requested, or when the output is closed.  When the
+	ring is full the tape waits for the writer thread to make room, so the memory used
+	is bounded by \p tape::output_buffer_size for each output.
+
+	Asynchronous output is disabled by setting \p tape::async_output to 0, in which case
+	writer_open() returns NULL and the tapes write to their files directly.  Outputs to
+	stdout are never made asynchronous so that they stay in order with the messages of
+	the simulator.
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <pthread.h>
+#include "gridlabd.h"
+
+#include "tape.h"
+
+int32 async_output = 1; /* 1 to write tape outputs from the writer thread */
+int32 output_buffer_size = 65536; /* size of the ring buffer of each output (bytes) */
+
+struct s_tapewriter {
+	FILE *fp;
+	char *buffer;	/* ring buffer */
+	size_t size;	/* size of the ring buffer */
+	size_t head;	/* number of bytes queued so far */
+	size_t tail;	/* number of bytes written so far */
+	int flush;		/* a flush of the file was requested */
+	int queued;		/* the output is pending or being written */
+	int error;		/* a write to the file failed */
+	struct s_tapewriter *next;	/* next pending output */
+	struct s_tapewriter *prev_open, *next_open;	/* list of open outputs */
+};
+
+static pthread_mutex_t writer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t writer_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t writer_space = PTHREAD_COND_INITIALIZER;
+static pthread_t writer_thread;
+static int writer_running = 0;
+static int writer_stop = 0;
+static TAPEWRITER *pending_first = NULL, *pending_last = NULL;
+static TAPEWRITER *open_list = NULL;
+
+/* append an output to the pending list (writer_lock must be held) */
+static void schedule(TAPEWRITER *w)
+{
+	if ( w->queued )
+		return;
+	w->queued = 1;
+	w->next = NULL;
+	if ( pending_last!=NULL )
+		pending_last->next = w;
+	else
+		pending_first = w;
+	pending_last = w;
+	pthread_cond_signal(&writer_work);
+}
+
+static void *writer_main(void *arg)
+{
+	pthread_mutex_lock(&writer_lock);
+	for ( ;; )
+	{
+		TAPEWRITER *w = pending_first;
+		size_t head, tail;
+		int flush, error = 0;
+		if ( w==NULL )
+		{
+			if ( writer_stop )
+				break;
+			pthread_cond_wait(&writer_work,&writer_lock);
+			continue;
+		}
+		pending_first = w->next;
+		if ( pending_first==NULL )
+			pending_last = NULL;
+		head = w->head;
+		tail = w->tail;
+		flush = w->flush;
+		w->flush = 0;
+		pthread_mutex_unlock(&writer_lock);
+
+		/* the bytes between tail and head are not touched by the tape until tail moves */
+		while ( tail<head )
+		{
+			size_t pos = tail%w->size;
+			size_t len = head-tail;
+			if ( len>w->size-pos )
+				len = w->size-pos;
+			if ( fwrite(w->buffer+pos,1,len,w->fp)!=len )
+				error = 1;
+			tail += len;
+		}
+		if ( flush && fflush(w->fp)!=0 )
+			error = 1;
+
+		pthread_mutex_lock(&writer_lock);
+		w->tail = tail;
+		w->queued = 0;
+		if ( error )
+			w->error = 1;
+		if ( w->flush || (writer_stop && w->head!=w->tail) )
+			schedule(w);
+		pthread_cond_broadcast(&writer_space);
+	}
+	pthread_mutex_unlock(&writer_lock);
+	return NULL;
+}
+
+/** Attach an asynchronous writer to an output file
+	@return the writer, or NULL if the file must be written directly
+ **/
+TAPEWRITER *writer_open(FILE *fp)
+{
+	TAPEWRITER *w;
+	size_t size = output_buffer_size>1024 ? (size_t)output_buffer_size : 1024;
+	if ( !async_output || fp==NULL || fp==stdout )
+		return NULL;
+	w = (TAPEWRITER*)malloc(sizeof(TAPEWRITER));
+	if ( w==NULL )
+		return NULL;
+	memset(w,0,sizeof(TAPEWRITER));
+	w->buffer = (char*)malloc(size);
+	if ( w->buffer==NULL )
+	{
+		free(w);
+		return NULL;
+	}
+	w->fp = fp;
+	w->size = size;
+
+	pthread_mutex_lock(&writer_lock);
+	if ( !writer_running )
+	{
+		writer_stop = 0;
+		if ( pthread_create(&writer_thread,NULL,writer_main,NULL)!=0 )
+		{
+			pthread_mutex_unlock(&writer_lock);
+			gl_warning("tape output thread could not be started, tapes will be written synchronously");
+			/* TROUBLESHOOT
+				The thread that writes tape outputs in the background could not be created.
+				The simulation will continue but the tapes will write their outputs directly.
+			 */
+			free(w->buffer);
+			free(w);
+			async_output = 0;
+			return NULL;
+		}
+		writer_running = 1;
+	}
+	w->next_open = open_list;
+	if ( open_list!=NULL )
+		open_list->prev_open = w;
+	open_list = w;
+	pthread_mutex_unlock(&writer_lock);
+	return w;
+}
+
+/** Queue data for output, waiting for room in the ring if necessary
+	@return the number of bytes queued, or -1 if the output has failed
+ **/
+int writer_write(TAPEWRITER *w, const char *data, size_t len)
+{
+	size_t done = 0;
+	int rc;
+	pthread_mutex_lock(&writer_lock);
+	while ( done<len && !w->error )
+	{
+		size_t room = w->size-(w->head-w->tail);
+		size_t pos = w->head%w->size;
+		size_t n = len-done;
+		if ( room==0 )
+		{
+			/* back-pressure: wait for the writer thread to catch up */
+			schedule(w);
+			pthread_cond_wait(&writer_space,&writer_lock);
+			continue;
+		}
+		if ( n>room ) n = room;
+		if ( n>w->size-pos ) n = w->size-pos;
+		memcpy(w->buffer+pos,data+done,n);
+		w->head += n;
+		done += n;
+	}
+	if ( w->head-w->tail>=w->size/4 )
+		schedule(w);
+	rc = w->error ? -1 : (int)len;
+	pthread_mutex_unlock(&writer_lock);
+	return rc;
+}
+
+/** Queue formatted data for output
+	@return the number of bytes queued, or a negative value on failure
+ **/
+int writer_printf(TAPEWRITER *w, const char *format, ...)
+{
+	char buffer[4096];
+	char *text = buffer;
+	int len;
+	va_list ptr;
+	va_start(ptr,format);
+	len = vsnprintf(buffer,sizeof(buffer),format,ptr);
+	va_end(ptr);
+	if ( len<0 )
+		return len;
+	if ( (size_t)len>=sizeof(buffer) )
+	{
+		text = (char*)malloc(len+1);
+		if ( text==NULL )
+			return -1;
+		va_start(ptr,format);
+		vsnprintf(text,len+1,format,ptr);
+		va_end(ptr);
+	}
+	len = writer_write(w,text,len);
+	if ( text!=buffer )
+		free(text);
+	return len;
+}
+
+/** Request that the queued data be written and the file flushed */
+void writer_flush(TAPEWRITER *w)
+{
+	pthread_mutex_lock(&writer_lock);
+	w->flush = 1;
+	schedule(w);
+	pthread_mutex_unlock(&writer_lock);
+}
+
+/** Wait until the queued data is written and release the writer.  The file
+	is left open and can be written directly once this returns.
+	@return 1 if all the data was written, 0 if the output failed
+ **/
+int writer_close(TAPEWRITER *w)
+{
+	int rc;
+	pthread_mutex_lock(&writer_lock);
+	while ( w->queued || (w->head!=w->tail && !w->error) )
+	{
+		schedule(w);
+		pthread_cond_wait(&writer_space,&writer_lock);
+	}
+	if ( w->prev_open!=NULL )
+		w->prev_open->next_open = w->next_open;
+	else
+		open_list = w->next_open;
+	if ( w->next_open!=NULL )
+		w->next_open->prev_open = w->prev_open;
+	rc = !w->error;
+	pthread_mutex_unlock(&writer_lock);
+	free(w->buffer);
+	free(w);
+	return rc;
+}
+
+/** Write everything still queued by the open outputs and stop the writer thread */
+void writer_term(void)
+{
+	TAPEWRITER *w;
+	pthread_mutex_lock(&writer_lock);
+	if ( !writer_running )
+	{
+		pthread_mutex_unlock(&writer_lock);
+		return;
+	}
+	for ( w=open_list ; w!=NULL ; w=w->next_open )
+	{
+		if ( w->head!=w->tail )
+			schedule(w);
+	}
+	writer_stop = 1;
+	pthread_cond_signal(&writer_work);
+	pthread_mutex_unlock(&writer_lock);
+	pthread_join(writer_thread,NULL);
+	writer_running = 0;
+	for ( w=open_list ; w!=NULL ; w=w->next_open )
+		fflush(w->fp);
+}
+
+/** Operations given to the tape plugins so they can share the writer thread */
+WRITEROPS writer_ops = {writer_open, writer_write, writer_printf, writer_flush, writer_close};
+
+/**@}*/
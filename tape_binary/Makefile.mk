@@ -0,0 +1,22 @@
+pkglib_LTLIBRARIES += tape_binary/tape_binary.la
+
+tape_binary_tape_binary_la_CPPFLAGS =
+tape_binary_tape_binary_la_CPPFLAGS += $(AM_CPPFLAGS)
+
+tape_binary_tape_binary_la_LDFLAGS =
+tape_binary_tape_binary_la_LDFLAGS += $(AM_LDFLAGS)
+
+tape_binary_tape_binary_la_LIBADD =
+
+tape_binary_tape_binary_la_SOURCES =
+tape_binary_tape_binary_la_SOURCES += tape_binary/binary_format.c
+tape_binary_tape_binary_la_SOURCES += tape_binary/binary_format.h
+tape_binary_tape_binary_la_SOURCES += tape_binary/tape_binary.cpp
+tape_binary_tape_binary_la_SOURCES += tape_binary/tape_binary.h
+
+bin_PROGRAMS += gldbin2csv
+
+gldbin2csv_SOURCES =
+gldbin2csv_SOURCES += tape_binary/binary_format.c
+gldbin2csv_SOURCES += tape_binary/binary_format.h
+gldbin2csv_SOURCES += tape_binary/gldbin2csv.c
@@ -0,0 +1,186 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file binary_format.c
+	@addtogroup tape_binary
+	@ingroup tapes
+
+	Column codecs and file primitives shared by the binary tape writer and reader.
+ @{
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "binary_format.h"
+
+/** Encode a column of \p n 64-bit words
+	@return the number of bytes written to \p out
+ **/
+size_t bintape_encode(const bt_uint64 *in, size_t n, BINTAPECOLUMN type, BINTAPECOMPRESSION compression, unsigned char *out)
+{
+	unsigned char *p = out;
+	bt_uint64 prev = 0, prevd = 0;
+	size_t i;
+	int k;
+	for ( i=0 ; i<n ; i++ )
+	{
+		bt_uint64 w = in[i];
+		if ( compression==BZ_NONE )
+		{
+			for ( k=0 ; k<8 ; k++ )
+				*p++ = (unsigned char)(w>>(8*k));
+		}
+		else if ( type==BC_INT64 )
+		{
+			/* zigzag varint of the change in the row-to-row difference */
+			bt_int64 d = (bt_int64)((w-prev)-prevd);
+			bt_uint64 z = ((bt_uint64)d<<1) ^ (bt_uint64)(d>>63);
+			prevd = w-prev;
+			while ( z>=0x80 )
+			{
+				*p++ = (unsigned char)(z|0x80);
+				z >>= 7;
+			}
+			*p++ = (unsigned char)z;
+		}
+		else
+		{
+			/* XOR with the previous row, leading and trailing zero bytes trimmed */
+			bt_uint64 x = w^prev;
+			int lz = 0, tz = 0;
+			if ( x==0 )
+				*p++ = 0x80;
+			else
+			{
+				while ( ((x>>(8*(7-lz)))&0xff)==0 ) lz++;
+				while ( ((x>>(8*tz))&0xff)==0 ) tz++;
+				*p++ = (unsigned char)((lz<<4)|tz);
+				for ( k=7-lz ; k>=tz ; k-- )
+					*p++ = (unsigned char)(x>>(8*k));
+			}
+		}
+		prev = w;
+	}
+	return p-out;
+}
+
+/** Decode a column of \p n 64-bit words from \p size bytes
+	@return 1 on success, 0 if the data is truncated or corrupt
+ **/
+int bintape_decode(const unsigned char *in, size_t size, size_t n, BINTAPECOLUMN type, BINTAPECOMPRESSION compression, bt_uint64 *out)
+{
+	const unsigned char *p = in, *end = in+size;
+	bt_uint64 prev = 0, prevd = 0;
+	size_t i;
+	int k;
+	for ( i=0 ; i<n ; i++ )
+	{
+		bt_uint64 w = 0;
+		if ( compression==BZ_NONE )
+		{
+			if ( end-p<8 ) return 0;
+			for ( k=0 ; k<8 ; k++ )
+				w |= (bt_uint64)(*p++)<<(8*k);
+		}
+		else if ( type==BC_INT64 )
+		{
+			bt_uint64 z = 0;
+			int shift = 0;
+			do {
+				if ( p==end || shift>63 ) return 0;
+				z |= (bt_uint64)(*p&0x7f)<<shift;
+				shift += 7;
+			} while ( *p++&0x80 );
+			prevd += (z>>1) ^ (~(z&1)+1);
+			w = prev + prevd;
+		}
+		else
+		{
+			int lz, tz;
+			bt_uint64 x = 0;
+			if ( p==end ) return 0;
+			lz = *p>>4;
+			tz = *p++&0x0f;
+			if ( lz<8 )
+			{
+				if ( lz+tz>7 || end-p<8-lz-tz ) return 0;
+				for ( k=7-lz ; k>=tz ; k-- )
+					x |= (bt_uint64)(*p++)<<(8*k);
+			}
+			w = prev^x;
+		}
+		out[i] = prev = w;
+	}
+	return p==end;
+}
+
+int bintape_put_u32(FILE *fp, bt_uint32 value)
+{
+	unsigned char buf[4];
+	int k;
+	for ( k=0 ; k<4 ; k++ )
+		buf[k] = (unsigned char)(value>>(8*k));
+	return fwrite(buf,1,sizeof(buf),fp)==sizeof(buf);
+}
+
+int bintape_put_u64(FILE *fp, bt_uint64 value)
+{
+	unsigned char buf[8];
+	int k;
+	for ( k=0 ; k<8 ; k++ )
+		buf[k] = (unsigned char)(value>>(8*k));
+	return fwrite(buf,1,sizeof(buf),fp)==sizeof(buf);
+}
+
+int bintape_put_string(FILE *fp, const char *value)
+{
+	size_t len = value ? strlen(value) : 0;
+	return bintape_put_u32(fp,(bt_uint32)len) && fwrite(value,1,len,fp)==len;
+}
+
+int bintape_get_u32(FILE *fp, bt_uint32 *value)
+{
+	unsigned char buf[4];
+	int k;
+	if ( fread(buf,1,sizeof(buf),fp)!=sizeof(buf) )
+		return 0;
+	*value = 0;
+	for ( k=0 ; k<4 ; k++ )
+		*value |= (bt_uint32)buf[k]<<(8*k);
+	return 1;
+}
+
+int bintape_get_u64(FILE *fp, bt_uint64 *value)
+{
+	unsigned char buf[8];
+	int k;
+	if ( fread(buf,1,sizeof(buf),fp)!=sizeof(buf) )
+		return 0;
+	*value = 0;
+	for ( k=0 ; k<8 ; k++ )
+		*value |= (bt_uint64)buf[k]<<(8*k);
+	return 1;
+}
+
+/** Read a length-prefixed string
+	@return a malloc'd copy of the string, or NULL on a read error
+ **/
+char *bintape_get_string(FILE *fp)
+{
+	bt_uint32 len;
+	char *value;
+	if ( !bintape_get_u32(fp,&len) || len>65536 )
+		return NULL;
+	value = (char*)malloc(len+1);
+	if ( value==NULL )
+		return NULL;
+	if ( fread(value,1,len,fp)!=len )
+	{
+		free(value);
+		return NULL;
+	}
+	value[len] = '\0';
+	return value;
+}
+
+/**@}*/
@@ -0,0 +1,82 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file binary_format.h
+	@addtogroup tape_binary
+	@ingroup tapes
+
+	Layout of binary recorder tapes.  All integers are little-endian.
+
+	Header:
+	- \p magic "GLDBTAPE" (8 bytes)
+	- \p version, \p compression, \p column count, \p chunk rows (uint32 each)
+	- \p file, \p target, \p trigger and \p property strings (uint32 length + bytes)
+	- \p interval and \p limit (int64 each)
+	- for each column: \p type (uint8), \p name and \p unit strings
+
+	Data is written in chunks of up to \p chunk \p rows samples:
+	- \p rows (uint32, 0 marks the end of the tape)
+	- the timestamp column (int64 nanoseconds since the epoch) followed by each value
+	  column, each as a uint32 byte count followed by the encoded data; complex
+	  columns hold the real parts of the chunk followed by the imaginary parts.
+
+	Encoded data is either raw 8-byte words (\p BZ_NONE) or (\p BZ_DELTA) zigzag varints
+	of the change in the row-to-row differences for integer columns (so regular timestamps
+	take one byte each) and the XOR of successive values with leading and trailing zero
+	bytes trimmed for double columns.
+ @{
+ **/
+
+#ifndef _BINARY_FORMAT_H
+#define _BINARY_FORMAT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef _MSC_VER
+typedef unsigned __int64 bt_uint64;
+typedef __int64 bt_int64;
+typedef unsigned int bt_uint32;
+#else
+#include <stdint.h>
+typedef uint64_t bt_uint64;
+typedef int64_t bt_int64;
+typedef uint32_t bt_uint32;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BINTAPE_MAGIC "GLDBTAPE"
+#define BINTAPE_VERSION 1
+
+typedef enum {
+	BC_INT64=1,		/**< integer, enumeration, set, bool and timestamp properties */
+	BC_DOUBLE=2,	/**< double properties and complex parts */
+	BC_COMPLEX=3	/**< complex properties (two planes) */
+} BINTAPECOLUMN;
+
+typedef enum {
+	BZ_NONE=0,		/**< raw 8-byte words */
+	BZ_DELTA=1		/**< delta/XOR encoding */
+} BINTAPECOMPRESSION;
+
+/** largest number of bytes needed to encode \p n words */
+#define BINTAPE_MAXENCODED(n) ((size_t)(n)*10)
+
+size_t bintape_encode(const bt_uint64 *in, size_t n, BINTAPECOLUMN type, BINTAPECOMPRESSION compression, unsigned char *out);
+int bintape_decode(const unsigned char *in, size_t size, size_t n, BINTAPECOLUMN type, BINTAPECOMPRESSION compression, bt_uint64 *out);
+
+int bintape_put_u32(FILE *fp, bt_uint32 value);
+int bintape_put_u64(FILE *fp, bt_uint64 value);
+int bintape_put_string(FILE *fp, const char *value);
+int bintape_get_u32(FILE *fp, bt_uint32 *value);
+int bintape_get_u64(FILE *fp, bt_uint64 *value);
+char *bintape_get_string(FILE *fp);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+#endif
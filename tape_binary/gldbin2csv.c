@@ -0,0 +1,222 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file gldbin2csv.c
+	@addtogroup tape_binary
+	@ingroup tapes
+
+	Converts a binary recorder tape to the CSV layout written by file tapes.
+
+	Usage: gldbin2csv [-d] [-p precision] [-o output] input
+
+	- \p -d writes timestamps as local date-times instead of seconds since the epoch
+	- \p -p sets the number of significant digits of double values (default 17)
+	- \p -o writes to a file instead of stdout
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "binary_format.h"
+
+typedef struct {
+	int type;		/* BC_INT64, BC_DOUBLE or BC_COMPLEX */
+	char *name;
+	char *unit;
+	unsigned int slot;	/* index of the first plane of the column */
+} COLUMN;
+
+static void usage(void)
+{
+	fprintf(stderr,"Usage: gldbin2csv [-d] [-p precision] [-o output] input\n");
+}
+
+static void print_timestamp(FILE *out, bt_int64 t, int dates)
+{
+	bt_int64 s = t/1000000000, ns = t%1000000000;
+	if ( ns<0 ) { ns += 1000000000; s--; }
+	if ( dates )
+	{
+		char buffer[64];
+		time_t tt = (time_t)s;
+		struct tm *tm = localtime(&tt);
+		if ( tm!=NULL && strftime(buffer,sizeof(buffer),"%Y-%m-%d %H:%M:%S",tm)>0 )
+			fputs(buffer,out);
+		else
+			fprintf(out,"%lld",(long long)s);
+	}
+	else
+		fprintf(out,"%lld",(long long)s);
+	if ( ns!=0 )
+		fprintf(out,".%09lld",(long long)ns);
+}
+
+static double as_double(bt_uint64 w)
+{
+	double d;
+	memcpy(&d,&w,sizeof(d));
+	return d;
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *fp, *out=stdout;
+	char magic[8];
+	bt_uint32 version, compression, ncols, chunk, rows=1;
+	bt_uint64 interval, limit;
+	char *file, *target, *trigger, *property;
+	COLUMN *col;
+	BINTAPECOLUMN *stype;
+	unsigned int n, nslots=0;
+	bt_uint64 *ts, *data;
+	unsigned char *in;
+	int dates=0, precision=17;
+	char *input=NULL, *output=NULL;
+	int i;
+
+	for ( i=1 ; i<argc ; i++ )
+	{
+		if ( strcmp(argv[i],"-d")==0 )
+			dates = 1;
+		else if ( strcmp(argv[i],"-p")==0 && i+1<argc )
+			precision = atoi(argv[++i]);
+		else if ( strcmp(argv[i],"-o")==0 && i+1<argc )
+			output = argv[++i];
+		else if ( argv[i][0]!='-' && input==NULL )
+			input = argv[i];
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	if ( input==NULL )
+	{
+		usage();
+		return 1;
+	}
+
+	fp = fopen(input,"rb");
+	if ( fp==NULL )
+	{
+		perror(input);
+		return 1;
+	}
+	if ( fread(magic,1,8,fp)!=8 || memcmp(magic,BINTAPE_MAGIC,8)!=0
+		|| !bintape_get_u32(fp,&version) || version!=BINTAPE_VERSION
+		|| !bintape_get_u32(fp,&compression) || compression>BZ_DELTA
+		|| !bintape_get_u32(fp,&ncols) || !bintape_get_u32(fp,&chunk) || chunk==0
+		|| (file=bintape_get_string(fp))==NULL
+		|| (target=bintape_get_string(fp))==NULL
+		|| (trigger=bintape_get_string(fp))==NULL
+		|| (property=bintape_get_string(fp))==NULL
+		|| !bintape_get_u64(fp,&interval) || !bintape_get_u64(fp,&limit) )
+	{
+		fprintf(stderr,"%s: not a binary tape (version %d)\n", input, BINTAPE_VERSION);
+		return 1;
+	}
+	col = (COLUMN*)calloc(ncols?ncols:1,sizeof(COLUMN));
+	stype = (BINTAPECOLUMN*)calloc(2*ncols+1,sizeof(BINTAPECOLUMN));
+	if ( col==NULL || stype==NULL )
+	{
+		fprintf(stderr,"%s: out of memory\n", input);
+		return 1;
+	}
+	for ( n=0 ; n<ncols ; n++ )
+	{
+		col[n].type = fgetc(fp);
+		col[n].name = bintape_get_string(fp);
+		col[n].unit = bintape_get_string(fp);
+		col[n].slot = nslots;
+		if ( col[n].type<BC_INT64 || col[n].type>BC_COMPLEX || col[n].name==NULL || col[n].unit==NULL )
+		{
+			fprintf(stderr,"%s: column %d is corrupt\n", input, n);
+			return 1;
+		}
+		stype[nslots++] = (col[n].type==BC_INT64 ? BC_INT64 : BC_DOUBLE);
+		if ( col[n].type==BC_COMPLEX )
+			stype[nslots++] = BC_DOUBLE;
+	}
+	ts = (bt_uint64*)malloc(sizeof(bt_uint64)*chunk);
+	data = (bt_uint64*)malloc(sizeof(bt_uint64)*chunk*(nslots?nslots:1));
+	in = (unsigned char*)malloc(BINTAPE_MAXENCODED(chunk));
+	if ( ts==NULL || data==NULL || in==NULL )
+	{
+		fprintf(stderr,"%s: out of memory\n", input);
+		return 1;
+	}
+
+	if ( output!=NULL && (out=fopen(output,"w"))==NULL )
+	{
+		perror(output);
+		return 1;
+	}
+	fprintf(out,"# file...... %s\n", file);
+	fprintf(out,"# target.... %s\n", target);
+	fprintf(out,"# trigger... %s\n", trigger[0]=='\0'?"(none)":trigger);
+	fprintf(out,"# interval.. %lld\n", (long long)(bt_int64)interval);
+	fprintf(out,"# limit..... %lld\n", (long long)(bt_int64)limit);
+	fprintf(out,"# timestamp");
+	for ( n=0 ; n<ncols ; n++ )
+	{
+		if ( col[n].unit[0]!='\0' )
+			fprintf(out,",%s[%s]", col[n].name, col[n].unit);
+		else
+			fprintf(out,",%s", col[n].name);
+	}
+	fprintf(out,"\n");
+
+	while ( bintape_get_u32(fp,&rows) && rows>0 )
+	{
+		bt_uint32 size;
+		unsigned int r;
+		if ( rows>chunk )
+			break;
+		for ( n=0 ; n<=nslots ; n++ )
+		{
+			bt_uint64 *plane = (n==0 ? ts : data+(size_t)(n-1)*chunk);
+			BINTAPECOLUMN type = (n==0 ? BC_INT64 : stype[n-1]);
+			if ( !bintape_get_u32(fp,&size) || size>BINTAPE_MAXENCODED(chunk)
+				|| fread(in,1,size,fp)!=size
+				|| !bintape_decode(in,size,rows,type,(BINTAPECOMPRESSION)compression,plane) )
+			{
+				fprintf(stderr,"%s: chunk is corrupt\n", input);
+				return 1;
+			}
+		}
+		for ( r=0 ; r<rows ; r++ )
+		{
+			print_timestamp(out,(bt_int64)ts[r],dates);
+			for ( n=0 ; n<ncols ; n++ )
+			{
+				bt_uint64 *plane = data+(size_t)col[n].slot*chunk;
+				switch ( col[n].type ) {
+				case BC_INT64:
+					fprintf(out,",%lld",(long long)(bt_int64)plane[r]);
+					break;
+				case BC_DOUBLE:
+					fprintf(out,",%.*g",precision,as_double(plane[r]));
+					break;
+				case BC_COMPLEX:
+					fprintf(out,",%+.*g%+.*gj",precision,as_double(plane[r]),precision,as_double(plane[chunk+r]));
+					break;
+				}
+			}
+			fprintf(out,"\n");
+		}
+	}
+	if ( rows!=0 )
+	{
+		fprintf(stderr,"%s: tape is truncated\n", input);
+		return 1;
+	}
+	fprintf(out,"# end of tape\n");
+	if ( out!=stdout )
+		fclose(out);
+	fclose(fp);
+	return 0;
+}
+
+/**@}*/
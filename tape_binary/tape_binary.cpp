@@ -0,0 +1,208 @@
+/** $Id$
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file tape_binary.cpp
+	@addtogroup tape_binary Binary tapes
+	@ingroup tapes
+
+	Binary tapes write recorder samples as typed columns instead of text lines.  Samples
+	are buffered in chunks of \p tape::binary_chunk_size rows and each column of a chunk is
+	written as a block, optionally compressed according to \p tape::binary_compression.
+	Timestamps are kept in an int64 column of nanoseconds so deltamode samples keep their
+	sub-second part.  The layout is described in binary_format.h and tapes can be converted
+	back to CSV with the \p gldbin2csv tool.
+
+	Binary tapes are used by setting the recorder \p mode to \p binary.
+@{
+**/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <ctype.h>
+#include <string.h>
+
+#define DLMAIN
+#include "gridlabd.h"
+EXPORT int do_kill(void*) { return 0; }
+
+#include "../tape/tape.h"
+#include "tape_binary.h"
+
+/* write the buffered samples as a chunk */
+static int write_chunk(BINARYTAPE *bt)
+{
+	unsigned int n;
+	size_t size;
+	if ( bt->rows==0 )
+		return 1;
+	if ( !bintape_put_u32(bt->fp,bt->rows) )
+		return 0;
+	size = bintape_encode(bt->ts,bt->rows,BC_INT64,bt->compression,bt->out);
+	if ( !bintape_put_u32(bt->fp,(bt_uint32)size) || fwrite(bt->out,1,size,bt->fp)!=size )
+		return 0;
+	for ( n=0 ; n<bt->count ; n++ )
+	{
+		size = bintape_encode(bt->data+(size_t)n*bt->chunk,bt->rows,bt->type[n],bt->compression,bt->out);
+		if ( !bintape_put_u32(bt->fp,(bt_uint32)size) || fwrite(bt->out,1,size,bt->fp)!=size )
+			return 0;
+	}
+	bt->rows = 0;
+	return 1;
+}
+
+static void free_binarytape(BINARYTAPE *bt)
+{
+	if ( bt->fp ) fclose(bt->fp);
+	free(bt->type);
+	free(bt->ts);
+	free(bt->data);
+	free(bt->out);
+	free(bt);
+}
+
+/*******************************************************************
+ * recorders
+ */
+EXPORT int open_recorder(struct recorder *my, char *fname, char *flags)
+{
+	OBJECT *obj=OBJECTHDR(my);
+	BINARYTAPE *bt;
+	PROPERTY *p;
+	char value[64];
+	char target[1024];
+	char list[1024];
+	char *item, *next;
+	unsigned int n, ncols=0;
+	int ok;
+
+	bt = (BINARYTAPE*)malloc(sizeof(BINARYTAPE));
+	if ( bt==NULL )
+	{
+		gl_error("recorder:%d: unable to allocate memory for binary tape", obj->id);
+		my->status = TS_DONE;
+		return 0;
+	}
+	memset(bt,0,sizeof(BINARYTAPE));
+
+	/* tape options */
+	bt->chunk = 4096;
+	if ( gl_global_getvar("tape::binary_chunk_size",value,sizeof(value))!=NULL && atoi(value)>0 )
+		bt->chunk = atoi(value);
+	bt->compression = BZ_DELTA;
+	if ( gl_global_getvar("tape::binary_compression",value,sizeof(value))!=NULL && strcmp(value,"NONE")==0 )
+		bt->compression = BZ_NONE;
+
+	/* value layout - the recorder's accessors have already converted the units */
+	bt->count = my->raw_count;
+	bt->type = (BINTAPECOLUMN*)malloc(sizeof(BINTAPECOLUMN)*bt->count);
+	bt->ts = (bt_uint64*)malloc(sizeof(bt_uint64)*bt->chunk);
+	bt->data = (bt_uint64*)malloc(sizeof(bt_uint64)*bt->chunk*(bt->count>0?bt->count:1));
+	bt->out = (unsigned char*)malloc(BINTAPE_MAXENCODED(bt->chunk));
+	if ( bt->type==NULL || bt->ts==NULL || bt->data==NULL || bt->out==NULL )
+	{
+		gl_error("recorder:%d: unable to allocate memory for binary tape", obj->id);
+		free_binarytape(bt);
+		my->status = TS_DONE;
+		return 0;
+	}
+	for ( n=0, p=my->target ; p!=NULL ; p=p->next, ncols++ )
+	{
+		int width = (p->ptype==PT_complex ? 2 : 1);
+		while ( width-->0 && n<bt->count )
+			bt->type[n++] = (p->ptype==PT_double || p->ptype==PT_complex) ? BC_DOUBLE : BC_INT64;
+	}
+
+	bt->fp = (strcmp(fname,"-")==0?stdout:fopen(fname,"wb"));
+	if ( bt->fp==NULL )
+	{
+		gl_error("recorder file %s: %s", fname, strerror(errno));
+		free_binarytape(bt);
+		my->status = TS_DONE;
+		return 0;
+	}
+
+	/* header */
+	if ( obj->parent )
+		sprintf(target,"%s %d", obj->parent->oclass->name, obj->parent->id);
+	else
+		strcpy(target,"");
+	ok = fwrite(BINTAPE_MAGIC,1,8,bt->fp)==8
+		&& bintape_put_u32(bt->fp,BINTAPE_VERSION)
+		&& bintape_put_u32(bt->fp,bt->compression)
+		&& bintape_put_u32(bt->fp,ncols)
+		&& bintape_put_u32(bt->fp,bt->chunk)
+		&& bintape_put_string(bt->fp,fname)
+		&& bintape_put_string(bt->fp,target)
+		&& bintape_put_string(bt->fp,my->trigger.get_string())
+		&& bintape_put_string(bt->fp,my->property.get_string())
+		&& bintape_put_u64(bt->fp,(bt_uint64)my->interval)
+		&& bintape_put_u64(bt->fp,(bt_uint64)my->limit);
+
+	/* columns - names come from the property list so complex parts keep their suffix */
+	strncpy(list,my->property.get_string(),sizeof(list)-1);
+	list[sizeof(list)-1] = '\0';
+	for ( item=list, p=my->target ; ok && p!=NULL ; p=p->next, item=next )
+	{
+		char *unit;
+		next = strchr(item,',');
+		if ( next ) *next++ = '\0'; else next = item+strlen(item);
+		while ( isspace(*item) ) item++;
+		unit = strchr(item,'[');
+		if ( unit ) *unit = '\0';
+		ok = fputc(p->ptype==PT_complex ? BC_COMPLEX : (p->ptype==PT_double ? BC_DOUBLE : BC_INT64),bt->fp)!=EOF
+			&& bintape_put_string(bt->fp,item)
+			&& bintape_put_string(bt->fp,p->unit ? p->unit->name : "");
+	}
+	if ( !ok )
+	{
+		gl_error("recorder file %s: unable to write binary tape header", fname);
+		free_binarytape(bt);
+		my->status = TS_DONE;
+		return 0;
+	}
+
+	my->tsp = bt;
+	my->type = FT_FILE;
+	my->last.ts = TS_ZERO;
+	my->status=TS_OPEN;
+	my->samples=0;
+	return 1;
+}
+
+EXPORT int write_recorder_binary(struct recorder *my, TIMESTAMP ts, int64 ns, BINARYVALUE *values)
+{
+	BINARYTAPE *bt = (BINARYTAPE*)my->tsp;
+	unsigned int n;
+	if ( bt==NULL )
+		return 0;
+	bt->ts[bt->rows] = (bt_uint64)(ts*1000000000 + ns);
+	for ( n=0 ; n<bt->count ; n++ )
+		memcpy(bt->data+(size_t)n*bt->chunk+bt->rows,values+n,sizeof(bt_uint64));
+	if ( ++bt->rows==bt->chunk )
+		return write_chunk(bt);
+	return 1;
+}
+
+EXPORT void flush_collector(struct recorder *my)
+{
+	BINARYTAPE *bt = (BINARYTAPE*)my->tsp;
+	if ( bt!=NULL && write_chunk(bt) )
+		fflush(bt->fp);
+}
+
+EXPORT void close_recorder(struct recorder *my)
+{
+	BINARYTAPE *bt = (BINARYTAPE*)my->tsp;
+	if ( bt!=NULL )
+	{
+		OBJECT *obj=OBJECTHDR(my);
+		if ( !write_chunk(bt) || !bintape_put_u32(bt->fp,0) )
+			gl_error("recorder:%d: unable to complete binary tape", obj->id);
+		if ( bt->fp==stdout )
+			bt->fp = NULL;
+		free_binarytape(bt);
+		my->tsp = NULL;
+	}
+}
+
+/**@}*/
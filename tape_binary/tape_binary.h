@@ -0,0 +1,27 @@
+// $Id$
+//	Copyright (C) 2008 Battelle Memorial Institute
+
+#ifndef _TAPE_BINARY_H
+#define _TAPE_BINARY_H
+
+#include "binary_format.h"
+
+/** state of a recorder writing to a binary tape */
+typedef struct s_binarytape {
+	FILE *fp;						///< output file
+	BINTAPECOMPRESSION compression;	///< column encoding
+	unsigned int chunk;				///< maximum number of samples in a chunk
+	unsigned int rows;				///< number of samples buffered in the current chunk
+	unsigned int count;				///< number of values in a sample
+	BINTAPECOLUMN *type;			///< encoding of each value (BC_INT64 or BC_DOUBLE)
+	bt_uint64 *ts;					///< timestamps of the buffered samples (ns)
+	bt_uint64 *data;				///< buffered values - one plane of \p chunk words per value
+	unsigned char *out;				///< encoding buffer
+} BINARYTAPE;
+
+EXPORT int open_recorder(struct recorder *my, char *fname, char *flags);
+EXPORT int write_recorder_binary(struct recorder *my, TIMESTAMP ts, int64 ns, BINARYVALUE *values);
+EXPORT void close_recorder(struct recorder *my);
+EXPORT void flush_collector(struct recorder *my);
+
+#endif
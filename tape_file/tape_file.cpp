@@ -34,6 +34,44 @@ EXPORT void set_csv_keep_clean()
 	csv_keep_clean = 1;
 }
 
+static WRITEROPS *writer = NULL; /* asynchronous writer provided by the tape module */
+EXPORT void set_tape_writer(WRITEROPS *ops)
+{
+	writer = ops;
+}
+
+/* attach the asynchronous writer to an output once its header is written */
+static TAPEWRITER *open_writer(FILE *fp)
+{
+	return writer!=NULL ? writer->open(fp) : NULL;
+}
+
+/* write a line of an output, queuing it when the output is asynchronous */
+static int write_line(FILE *fp, TAPEWRITER *w, char *timestamp, char *value)
+{
+	int count;
+	if (w!=NULL)
+	{
+		count = writer->print(w,"%s,%s\n", timestamp, value);
+		if (csv_keep_clean) writer->flush(w);
+	}
+	else
+	{
+		count = fprintf(fp,"%s,%s\n", timestamp, value);
+		if (csv_keep_clean) fflush(fp);
+	}
+	return count;
+}
+
+/* wait for the queued lines of an output before it is closed */
+static void close_writer(TAPEWRITER **w)
+{
+	if (*w!=NULL && !writer->close(*w))
+		//gl_error(
+		fprintf(stderr, "tape file: unable to write all the queued output\n");
+	*w = NULL;
+}
+
 /*******************************************************************
  * players 
  */
@@ -362,21 +400,21 @@ EXPORT int open_recorder(struct recorder *my, char *fname, char *flags)
 		fprintf(my->fp,"# limit..... %d\n", my->limit);
 		fprintf(my->fp,"# timestamp,%s\n", my->property.get_string());
 	}
+	my->writer = open_writer(my->fp);
 
 	return 1;
 }
 
 EXPORT int write_recorder(struct recorder *my, char *timestamp, char *value)
 { 
-	int count = fprintf(my->fp,"%s,%s\n", timestamp, value);
-	if (csv_keep_clean) fflush(my->fp);
-	return count;
+	return write_line(my->fp,my->writer,timestamp,value);
 }
 
 EXPORT void close_recorder(struct recorder *my)
 {
 	if (my->fp)
 	{
+		close_writer(&my->writer);
 		if (!csv_data_only) fprintf(my->fp,"# end of tape\n");
 		fclose(my->fp);
 		my->fp = NULL; // Defensive programming. For some reason GridlabD was 
@@ -437,21 +475,21 @@ EXPORT int open_histogram(histogram *my, char *fname, char *flags)
 			fprintf(my->fp, "\n");
 		}
 	}	
+	my->writer = open_writer(my->fp);
 
 	return 1;
 }
 
 EXPORT int write_histogram(histogram *my, char *timestamp, char *value)
 { 
-	int count = fprintf(my->fp,"%s,%s\n", timestamp, value);
-	if (csv_keep_clean) fflush(my->fp);
-	return count;
+	return write_line(my->fp,my->writer,timestamp,value);
 }
 
 EXPORT void close_histogram(histogram *my)
 {
 	if (my->fp)
 	{
+		close_writer(&my->writer);
 		fprintf(my->fp,"# end of tape\n");
 		fclose(my->fp);
 		my->fp = NULL;
@@ -500,21 +538,21 @@ EXPORT int open_collector(struct collector *my, char *fname, char *flags)
 		count += fprintf(my->fp,"# limit..... %d\n", my->limit);
 		count += fprintf(my->fp,"# property.. timestamp,%s\n", my->property.get_string());
 	}
+	my->writer = open_writer(my->fp);
 
 	return 1;
 }
 
 EXPORT int write_collector(struct collector *my, char *timestamp, char *value)
 {
-	int count = fprintf(my->fp,"%s,%s\n", timestamp, value);
-	if (csv_keep_clean) fflush(my->fp);
-	return count;
+	return write_line(my->fp,my->writer,timestamp,value);
 }
 
 EXPORT void close_collector(struct collector *my)
 {
 	if (my->fp)
 	{
+		close_writer(&my->writer);
 		if (!csv_data_only) fprintf(my->fp,"# end of tape\n");
 		fclose(my->fp);
 	}
@@ -22,4 +22,6 @@ EXPORT int open_collector(struct collector *my, char *fname, char *flags);
 EXPORT int write_collector(struct collector *my, char *timestamp, char *value);
 EXPORT void close_collector(struct collector *my);
 
+EXPORT void set_tape_writer(WRITEROPS *ops);
+
 #endif